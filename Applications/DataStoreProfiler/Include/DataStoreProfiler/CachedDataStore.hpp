@@ -28,8 +28,21 @@ namespace Beam {
       template<Initializes<D> DF>
       CachedProfileDataStore(DF&& data_store, int block_size);
 
+      /**
+       * Constructs a CachedProfileDataStore with a bounded cache.
+       * @param data_store Initializes the data store to commit data to.
+       * @param block_size The number of messages to cache per index.
+       * @param capacity The estimated number of bytes that may be cached.
+       */
+      template<Initializes<D> DF>
+      CachedProfileDataStore(
+        DF&& data_store, int block_size, std::size_t capacity);
+
       ~CachedProfileDataStore();
 
+      /** Returns the hit, miss and eviction counts of the cache. */
+      CacheStatistics get_statistics() const;
+
       void clear();
       std::vector<SequencedEntry> load_entries(const EntryQuery& query);
       void store(const SequencedIndexedEntry& entry);
@@ -52,6 +65,10 @@ namespace Beam {
   CachedProfileDataStore(D&&, int) ->
     CachedProfileDataStore<std::remove_cvref_t<D>>;
 
+  template<typename D>
+  CachedProfileDataStore(D&&, int, std::size_t) ->
+    CachedProfileDataStore<std::remove_cvref_t<D>>;
+
   template<typename D>
   template<Initializes<D> DF>
   CachedProfileDataStore<D>::CachedProfileDataStore(
@@ -59,11 +76,23 @@ namespace Beam {
     : m_data_store(std::forward<DF>(data_store)),
       m_cached_data_store(&*m_data_store, block_size) {}
 
+  template<typename D>
+  template<Initializes<D> DF>
+  CachedProfileDataStore<D>::CachedProfileDataStore(
+    DF&& data_store, int block_size, std::size_t capacity)
+    : m_data_store(std::forward<DF>(data_store)),
+      m_cached_data_store(&*m_data_store, block_size, capacity) {}
+
   template<typename D>
   CachedProfileDataStore<D>::~CachedProfileDataStore() {
     close();
   }
 
+  template<typename D>
+  CacheStatistics CachedProfileDataStore<D>::get_statistics() const {
+    return m_cached_data_store.get_statistics();
+  }
+
   template<typename D>
   void CachedProfileDataStore<D>::clear() {
     m_data_store->clear();
@@ -92,7 +121,7 @@ namespace Beam {
   void CachedProfileDataStore<D>::shutdown() {
     m_cached_data_store.close();
     m_data_store->close();
-    m_open_state.set_closed();
+    m_open_state.close();
   }
 }
 
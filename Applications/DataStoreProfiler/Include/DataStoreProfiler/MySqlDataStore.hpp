@@ -29,6 +29,9 @@ namespace Beam {
 
       ~MySqlProfileDataStore();
 
+      /** Returns the metrics of the rows written to the database. */
+      SqlWriteStatistics get_write_statistics() const;
+
       void clear();
       std::vector<SequencedEntry> load_entries(const EntryQuery& query);
       void store(const SequencedIndexedEntry& entry);
@@ -73,6 +76,11 @@ namespace Beam {
     close();
   }
 
+  inline SqlWriteStatistics
+      MySqlProfileDataStore::get_write_statistics() const {
+    return m_data_store.get_write_statistics();
+  }
+
   inline void MySqlProfileDataStore::clear() {
     auto connection = m_writer_pool.load();
     connection->execute(Viper::truncate("entries"));
@@ -6,6 +6,7 @@
 #include "Beam/Utilities/YamlConfig.hpp"
 #include "DataStoreProfiler/AsyncDataStore.hpp"
 #include "DataStoreProfiler/BufferedDataStore.hpp"
+#include "DataStoreProfiler/CachedDataStore.hpp"
 #include "DataStoreProfiler/Entry.hpp"
 #include "DataStoreProfiler/MySqlDataStore.hpp"
 #include "Version.hpp"
@@ -23,6 +24,9 @@ namespace {
     int m_iterations;
     ptime m_start_time;
     time_duration m_time_step;
+    int m_cache_block_size;
+    std::vector<std::size_t> m_cache_capacities;
+    int m_snapshot_size;
     std::vector<std::string> m_names;
 
     static auto parse(const YAML::Node& config);
@@ -37,6 +41,12 @@ namespace {
     profile_config.m_iterations = extract<int>(config, "iterations");
     profile_config.m_start_time = extract<ptime>(config, "start_time");
     profile_config.m_time_step = extract<time_duration>(config, "time_step");
+    if(auto cache = config["cache"]) {
+      profile_config.m_cache_block_size = extract<int>(cache, "block_size");
+      profile_config.m_cache_capacities =
+        extract<std::vector<std::size_t>>(cache, "capacities");
+      profile_config.m_snapshot_size = extract<int>(cache, "snapshot_size");
+    }
     for(auto i = 0; i < profile_config.m_index_count; ++i) {
       auto name = std::string();
       do {
@@ -51,26 +61,31 @@ namespace {
     return profile_config;
   }
 
+  int pick_skewed_index(const ProfileConfig& config) {
+    auto groups = static_cast<int>(std::ceil(std::log2(
+      static_cast<double>(config.m_index_count) / config.m_seed_count)));
+    auto range = static_cast<int>(std::pow(2, groups));
+    auto group = std::abs(
+      static_cast<int>(std::log2(1 + (std::rand() % range))) - (groups - 1));
+    auto lower_index =
+      config.m_seed_count * static_cast<int>(std::pow(2, group) - 1);
+    auto group_size =
+      config.m_seed_count * static_cast<int>(std::pow(2, group));
+    auto index = lower_index + (std::rand() % group_size);
+    if(index >= config.m_index_count) {
+      index = lower_index + (index - config.m_index_count);
+    }
+    return index;
+  }
+
   template<typename DataStore>
   void profile_writes(DataStore& data_store, const ProfileConfig& config) {
     data_store.clear();
     auto start = microsec_clock::universal_time();
-    auto groups = static_cast<int>(std::ceil(std::log2(
-      static_cast<double>(config.m_index_count) / config.m_seed_count)));
-    auto range = static_cast<int>(std::pow(2, groups));
     auto timestamp = config.m_start_time;
     auto sequences = std::unordered_map<std::string, Beam::Sequence>();
     for(auto i = 0; i < config.m_iterations; ++i) {
-      auto group = std::abs(
-        static_cast<int>(std::log2(1 + (std::rand() % range))) - (groups - 1));
-      auto lower_index =
-        config.m_seed_count * static_cast<int>(std::pow(2, group) - 1);
-      auto group_size =
-        config.m_seed_count * static_cast<int>(std::pow(2, group));
-      auto index = lower_index + (std::rand() % group_size);
-      if(index >= config.m_index_count) {
-        index = lower_index + (index - config.m_index_count);
-      }
+      auto index = pick_skewed_index(config);
       auto entry = Entry(config.m_names[index], std::rand() % 100,
         std::rand() % 10000000, std::rand() % 10000000, "dummy", timestamp);
       auto& sequence = sequences[entry.m_name];
@@ -115,6 +130,26 @@ namespace {
       std::endl;
   }
 
+  template<typename DataStore>
+  void profile_skewed_reads(
+      DataStore& data_store, const ProfileConfig& config) {
+    auto start = microsec_clock::universal_time();
+    for(auto i = 0; i < config.m_iterations; ++i) {
+      auto query = EntryQuery();
+      query.set_index(config.m_names[pick_skewed_index(config)]);
+      query.set_range(Beam::Range::HISTORICAL);
+      query.set_snapshot_limit(
+        SnapshotLimit::Type::TAIL, config.m_snapshot_size);
+      data_store.load_entries(query);
+    }
+    auto end = microsec_clock::universal_time();
+    auto elapsed = end - start;
+    auto rate = config.m_iterations / std::max<std::int64_t>(
+      elapsed.total_seconds(), 1);
+    std::cout << "profile_skewed_reads: " << elapsed << " " << rate <<
+      std::endl;
+  }
+
   void profile_buffered_data_store(
       const MySqlConfig& mysql_config, const ProfileConfig& profile_config) {
     std::cout << "BufferedDataStore" << std::endl;
@@ -125,6 +160,8 @@ namespace {
       auto data_store = BufferedProfileDataStore(
         &mysql_data_store, profile_config.m_buffer_size);
       profile_writes(data_store, profile_config);
+      std::cout << "sql_writes: " <<
+        mysql_data_store.get_write_statistics() << std::endl;
     }
     {
       auto mysql_data_store = MySqlProfileDataStore(
@@ -145,6 +182,8 @@ namespace {
         mysql_config.m_password);
       auto data_store = AsyncProfileDataStore(&mysql_data_store);
       profile_writes(data_store, profile_config);
+      std::cout << "sql_writes: " <<
+        mysql_data_store.get_write_statistics() << std::endl;
     }
     {
       auto mysql_data_store = MySqlProfileDataStore(
@@ -154,6 +193,30 @@ namespace {
       profile_reads(data_store, profile_config);
     }
   }
+
+  void profile_cached_data_store(
+      const MySqlConfig& mysql_config, const ProfileConfig& profile_config) {
+    std::cout << "CachedDataStore" << std::endl;
+    {
+      auto mysql_data_store = MySqlProfileDataStore(
+        mysql_config.m_address, mysql_config.m_schema, mysql_config.m_username,
+        mysql_config.m_password);
+      auto data_store = CachedProfileDataStore(
+        &mysql_data_store, profile_config.m_cache_block_size);
+      profile_writes(data_store, profile_config);
+    }
+    for(auto capacity : profile_config.m_cache_capacities) {
+      auto mysql_data_store = MySqlProfileDataStore(
+        mysql_config.m_address, mysql_config.m_schema, mysql_config.m_username,
+        mysql_config.m_password);
+      auto data_store = CachedProfileDataStore(
+        &mysql_data_store, profile_config.m_cache_block_size, capacity);
+      profile_skewed_reads(data_store, profile_config);
+      std::cout << "capacity: " << capacity << ", " <<
+        data_store.get_statistics() << std::endl;
+      data_store.close();
+    }
+  }
 }
 
 int main(int argc, const char** argv) {
@@ -168,6 +231,9 @@ int main(int argc, const char** argv) {
     }, std::runtime_error("Error parsing section 'data_store'."));
     profile_buffered_data_store(mysql_config, profile_config);
     profile_async_data_store(mysql_config, profile_config);
+    if(!profile_config.m_cache_capacities.empty()) {
+      profile_cached_data_store(mysql_config, profile_config);
+    }
   } catch(...) {
     report_current_exception();
     return -1;
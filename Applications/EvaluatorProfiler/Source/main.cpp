@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "Beam/Queries/Evaluator.hpp"
+#include "Beam/Queries/MemberAccessEvaluatorNode.hpp"
+
+using namespace Beam;
+
+namespace {
+  const auto EVALUATION_COUNT = 10000000;
+  const auto TRIAL_COUNT = 5;
+
+  struct Entry {
+    int m_value;
+    std::string m_name;
+  };
+
+  /**
+   * Evaluates a function the way an EvaluatorNode tree is walked without
+   * compilation, by making a virtual call to each of its arguments.
+   */
+  template<typename F, typename... Args>
+  class TreeEvaluatorNode :
+      public EvaluatorNode<std::invoke_result_t<F, Args...>> {
+    public:
+      using Result = std::invoke_result_t<F, Args...>;
+
+      TreeEvaluatorNode(F function,
+          std::unique_ptr<EvaluatorNode<Args>>... arguments)
+        : m_function(std::move(function)),
+          m_arguments(std::move(arguments)...) {}
+
+      Result eval() override {
+        return std::apply([&] (auto&... argument) {
+          return m_function(argument->eval()...);
+        }, m_arguments);
+      }
+
+    private:
+      F m_function;
+      std::tuple<std::unique_ptr<EvaluatorNode<Args>>...> m_arguments;
+  };
+
+  template<typename F, typename... Args>
+  auto make_tree_node(F function, std::unique_ptr<Args>... arguments) {
+    return std::make_unique<TreeEvaluatorNode<F, typename Args::Result...>>(
+      std::move(function), std::move(arguments)...);
+  }
+
+  template<typename T>
+  auto make_constant(T value) {
+    return std::make_unique<ConstantEvaluatorNode<T>>(std::move(value));
+  }
+
+  template<typename Result, typename T>
+  double time_evaluations(
+      Evaluator& evaluator, const std::array<T, 16>& values) {
+    auto fastest = std::numeric_limits<double>::infinity();
+    auto sink = std::uint64_t(0);
+    for(auto trial = 0; trial != TRIAL_COUNT; ++trial) {
+      auto start = std::chrono::steady_clock::now();
+      for(auto i = 0; i != EVALUATION_COUNT; ++i) {
+        sink += static_cast<std::uint64_t>(
+          evaluator.eval<Result>(values[i % values.size()]));
+      }
+      auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+      fastest = std::min(fastest, elapsed / EVALUATION_COUNT);
+    }
+    if(sink == std::uint64_t(-1)) {
+      std::cout << sink;
+    }
+    return fastest;
+  }
+
+  template<typename Result, typename T>
+  void report(std::string_view name, Evaluator& tree, Evaluator& compiled,
+      const std::array<T, 16>& values) {
+    auto tree_time = time_evaluations<Result>(tree, values);
+    auto compiled_time = time_evaluations<Result>(compiled, values);
+    std::cout << name << ", " << tree_time << ", " << compiled_time << ", " <<
+      tree_time / compiled_time << std::endl;
+  }
+
+  std::array<int, 16> make_values() {
+    auto values = std::array<int, 16>();
+    for(auto i = std::size_t(0); i != values.size(); ++i) {
+      values[i] = static_cast<int>(i * 7 % 23) + 1;
+    }
+    return values;
+  }
+
+  template<template<typename> class Translator, typename E>
+  void profile(std::string_view name, E make_expression) {
+    using Operation = typename Translator<
+      QueryTypes::NativeTypes>::template Operation<int, int>;
+    using Result = std::invoke_result_t<Operation, int, int>;
+    auto parameter = std::make_unique<ParameterEvaluatorNode<int>>(0);
+    auto parameters =
+      std::vector<BaseParameterEvaluatorNode*>{parameter.get()};
+    auto tree = Evaluator(
+      make_tree_node(Operation(), std::move(parameter), make_constant(10)),
+      parameters);
+    auto compiled = translate(
+      make_expression(ParameterExpression(0, typeid(int)), 10));
+    report<Result>(name, tree, *compiled, make_values());
+  }
+
+  void profile_folding() {
+    auto parameter = std::make_unique<ParameterEvaluatorNode<int>>(0);
+    auto parameters =
+      std::vector<BaseParameterEvaluatorNode*>{parameter.get()};
+    auto tree = Evaluator(make_tree_node(std::greater<>(),
+      make_tree_node(std::multiplies<>(), std::move(parameter),
+        make_constant(2)), make_tree_node(std::plus<>(), make_constant(10),
+          make_constant(5))), parameters);
+    auto compiled = translate(ParameterExpression(0, typeid(int)) * 2 >
+      ConstantExpression(10) + ConstantExpression(5));
+    report<bool>("p * 2 > 10 + 5", tree, *compiled, make_values());
+  }
+
+  void profile_member_access() {
+    auto tree_parameter = std::make_unique<ParameterEvaluatorNode<Entry>>(0);
+    auto tree_parameters =
+      std::vector<BaseParameterEvaluatorNode*>{tree_parameter.get()};
+    auto tree = Evaluator(make_tree_node(std::greater<>(),
+      make_tree_node([] (const Entry& entry) {
+        return entry.m_value;
+      }, std::move(tree_parameter)), make_constant(10)), tree_parameters);
+    auto compiled_parameter =
+      std::make_unique<ParameterEvaluatorNode<Entry>>(0);
+    auto compiled_parameters =
+      std::vector<BaseParameterEvaluatorNode*>{compiled_parameter.get()};
+    auto compiled = Evaluator(make_function_evaluator_node(std::greater<int>(),
+      std::make_unique<MemberAccessEvaluatorNode<Entry, int>>(
+        std::move(compiled_parameter), &Entry::m_value), make_constant(10)),
+      compiled_parameters);
+    auto values = std::array<Entry, 16>();
+    auto ints = make_values();
+    for(auto i = std::size_t(0); i != values.size(); ++i) {
+      values[i].m_value = ints[i];
+      values[i].m_name = "a name long enough to require an allocation";
+    }
+    report<bool>("p.value > 10", tree, compiled, values);
+  }
+
+  template<typename F>
+  double time_rows(std::size_t row_count, F&& f) {
+    auto fastest = std::numeric_limits<double>::infinity();
+    for(auto trial = 0; trial != TRIAL_COUNT; ++trial) {
+      auto start = std::chrono::steady_clock::now();
+      f();
+      auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count();
+      fastest = std::min(fastest, elapsed / row_count);
+    }
+    return fastest;
+  }
+
+  void profile_select(std::string_view name, const Expression& expression) {
+    const auto PASS_COUNT = 1000;
+    auto evaluator = translate(expression);
+    auto values = std::vector<int>();
+    auto ints = make_values();
+    for(auto i = 0; i != 10000; ++i) {
+      values.push_back(ints[i % ints.size()]);
+    }
+    auto selection = std::make_unique<bool[]>(values.size());
+    auto sink = std::size_t(0);
+    auto row_time = time_rows(PASS_COUNT * values.size(), [&] {
+      for(auto pass = 0; pass != PASS_COUNT; ++pass) {
+        for(auto i = std::size_t(0); i != values.size(); ++i) {
+          selection[i] = evaluator->eval<bool>(values[i]);
+        }
+        sink += selection[pass % values.size()];
+      }
+    });
+    auto select_time = time_rows(PASS_COUNT * values.size(), [&] {
+      for(auto pass = 0; pass != PASS_COUNT; ++pass) {
+        evaluator->select(
+          values, std::span(selection.get(), values.size()));
+        sink += selection[pass % values.size()];
+      }
+    });
+    if(sink == std::size_t(-1)) {
+      std::cout << sink;
+    }
+    std::cout << name << ", " << row_time << ", " << select_time << ", " <<
+      row_time / select_time << std::endl;
+  }
+}
+
+int main() {
+  std::cout << "Expression, Tree ns/eval, Compiled ns/eval, Speedup" <<
+    std::endl;
+  profile<AdditionExpressionTranslator>("p + 10", [] (auto p, auto c) {
+    return p + c;
+  });
+  profile<SubtractionExpressionTranslator>("p - 10", [] (auto p, auto c) {
+    return p - c;
+  });
+  profile<MultiplicationExpressionTranslator>("p * 10", [] (auto p, auto c) {
+    return p * c;
+  });
+  profile<DivisionExpressionTranslator>("p / 10", [] (auto p, auto c) {
+    return p / c;
+  });
+  profile<LessExpressionTranslator>("p < 10", [] (auto p, auto c) {
+    return p < c;
+  });
+  profile<LessEqualsExpressionTranslator>("p <= 10", [] (auto p, auto c) {
+    return p <= c;
+  });
+  profile<EqualsExpressionTranslator>("p == 10", [] (auto p, auto c) {
+    return p == c;
+  });
+  profile<NotEqualsExpressionTranslator>("p != 10", [] (auto p, auto c) {
+    return p != c;
+  });
+  profile<GreaterEqualsExpressionTranslator>("p >= 10", [] (auto p, auto c) {
+    return p >= c;
+  });
+  profile<GreaterExpressionTranslator>("p > 10", [] (auto p, auto c) {
+    return p > c;
+  });
+  profile<MaxExpressionTranslator>("max(p, 10)", [] (auto p, auto c) {
+    return max(p, c);
+  });
+  profile<MinExpressionTranslator>("min(p, 10)", [] (auto p, auto c) {
+    return min(p, c);
+  });
+  profile_folding();
+  profile_member_access();
+  std::cout << std::endl;
+  std::cout << "Filter, Row ns/eval, Batch ns/eval, Speedup" << std::endl;
+  auto p = ParameterExpression(0, typeid(int));
+  profile_select("p > 10", p > 10);
+  profile_select("p * 2 > 10 + 5", p * 2 > ConstantExpression(10) + 5);
+  profile_select("p > 5 && p < 15",
+    p > 5 && p < ConstantExpression(15));
+  profile_select("p != 0 && 100 / p > 10",
+    p != 0 && ConstantExpression(100) / p > 10);
+}
@@ -0,0 +1,3 @@
+@ECHO OFF
+CALL "%~dp0..\..\Beam\version.bat" EVALUATOR_PROFILER
+EXIT /B %ERRORLEVEL%
@@ -1,8 +1,11 @@
 #include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <random>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <boost/date_time.hpp>
 #include "Beam/Codecs/NullDecoder.hpp"
 #include "Beam/Codecs/NullEncoder.hpp"
@@ -14,6 +17,7 @@
 #include "Beam/Queries/LocalDataStore.hpp"
 #include "Beam/Queries/EvaluatorTranslator.hpp"
 #include "Beam/Queries/IndexedSubscriptions.hpp"
+#include "Beam/Queries/MemberAccessEvaluatorNode.hpp"
 #include "Beam/Queries/QueryClientPublisher.hpp"
 #include "Beam/Queries/QueryResult.hpp"
 #include "Beam/Queries/ShuttleQueryTypes.hpp"
@@ -65,6 +69,34 @@ namespace {
     (DataQueryMessage, "DataQueryMessage", (SequencedIndexedData, data)),
     (EndDataQueryMessage, "EndDataQueryMessage", (int, index), (int, id)));
 
+  struct DataQueryTypes {
+    using NativeTypes =
+      boost::mp11::mp_push_back<QueryTypes::NativeTypes, Data>;
+    using ValueTypes =
+      boost::mp11::mp_push_back<QueryTypes::ValueTypes, Data>;
+    using ComparableTypes = QueryTypes::ComparableTypes;
+  };
+
+  class DataTranslator : public EvaluatorTranslator<DataQueryTypes> {
+    public:
+      std::unique_ptr<EvaluatorTranslator<DataQueryTypes>>
+          make_translator() const override {
+        return std::make_unique<DataTranslator>();
+      }
+
+    protected:
+      void visit(const MemberAccessExpression& expression) override {
+        if(expression.get_expression().get_type() == typeid(Data) &&
+            expression.get_name() == "value") {
+          auto data = translate_operand<Data>(expression.get_expression());
+          set_evaluator(std::make_unique<MemberAccessEvaluatorNode<Data, int>>(
+            std::move(data), &Data::m_value));
+        } else {
+          EvaluatorTranslator<DataQueryTypes>::visit(expression);
+        }
+      }
+  };
+
   template<typename ContainerType>
   class DataServlet : private boost::noncopyable {
     public:
@@ -91,8 +123,7 @@ namespace {
       template<typename T>
       using Subscriptions = IndexedSubscriptions<T, int, ServiceProtocolClient>;
       Subscriptions<Data> m_subscriptions;
-      LocalDataStore<DataQuery, Data, EvaluatorTranslator<QueryTypes>>
-        m_data_store;
+      LocalDataStore<DataQuery, Data, DataTranslator> m_data_store;
       std::atomic_bool m_timer_state;
       std::vector<std::unique_ptr<DataEntry>> m_data_entries;
       OpenState m_open_state;
@@ -115,7 +146,10 @@ namespace {
 
   template<typename ContainerType>
   DataServlet<ContainerType>::DataServlet()
-      : m_timer_state(true) {
+      : m_subscriptions([] (const auto& expression) {
+          return translate<DataTranslator>(expression);
+        }),
+        m_timer_state(true) {
     auto rd = std::random_device();
     auto randomizer = std::default_random_engine(rd());
     auto distribution = std::uniform_int_distribution<std::uint64_t>();
@@ -166,11 +200,9 @@ namespace {
   void DataServlet<ContainerType>::on_data_request(
       RequestToken<ServiceProtocolClient, QueryDataService>& request,
       const DataQuery& query) {
-    auto filter =
-      translate<EvaluatorTranslator<QueryTypes>>(query.get_filter());
     auto result = DataQueryResult();
     result.m_id = m_subscriptions.init(query.get_index(), request.get_client(),
-      query.get_range(), std::move(filter));
+      query.get_range(), query.get_filter());
     result.m_snapshot = m_data_store.load(query);
     m_subscriptions.commit(query.get_index(), std::move(result),
       [&] (const auto& result) {
@@ -205,9 +237,78 @@ namespace {
   using DataServletContainer = ServiceProtocolServletContainer<
     MetaDataServlet, LocalServerConnection*, BinarySender<SharedBuffer>,
     NullEncoder, std::unique_ptr<TriggerTimer>>;
+
+  struct BenchmarkClient {};
+
+  Expression make_benchmark_filter(int i) {
+    auto value = MemberAccessExpression(
+      "value", typeid(int), ParameterExpression(0, typeid(Data)));
+    auto k = i % 200;
+    switch(i % 4) {
+      case 0:
+        return ConstantExpression(true);
+      case 1:
+        return value == k;
+      case 2:
+        return value >= ConstantExpression(k) &&
+          value < ConstantExpression(k + 10);
+      default:
+        return value > ConstantExpression(k);
+    }
+  }
+
+  template<typename F>
+  double time_publishes(int subscriber_count, F&& add) {
+    const auto PUBLISH_COUNT = 20000;
+    auto subscriptions = Subscriptions<Data, BenchmarkClient>(
+      [] (const auto& expression) {
+        return translate<DataTranslator>(expression);
+      });
+    auto clients = std::vector<BenchmarkClient>(subscriber_count);
+    for(auto i = 0; i != subscriber_count; ++i) {
+      add(subscriptions, clients[i], make_benchmark_filter(i));
+    }
+    auto received = std::size_t(0);
+    auto start = std::chrono::steady_clock::now();
+    for(auto i = 0; i != PUBLISH_COUNT; ++i) {
+      auto data = Data(i % 200, ptime());
+      subscriptions.publish(SequencedValue(data, Beam::Sequence(i + 1)),
+        [&] (const auto& clients) {
+          received += clients.size();
+        });
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - start).count();
+    if(received == std::size_t(-1)) {
+      std::cout << received;
+    }
+    return elapsed / PUBLISH_COUNT;
+  }
+
+  void benchmark_subscriptions() {
+    std::cout << "Subscribers, Evaluator us/publish, Indexed us/publish, " <<
+      "Speedup" << std::endl;
+    for(auto subscriber_count : {100, 1000, 5000}) {
+      auto evaluator_time = time_publishes(subscriber_count,
+        [] (auto& subscriptions, auto& client, const auto& filter) {
+          subscriptions.add(
+            client, Range::TOTAL, translate<DataTranslator>(filter));
+        });
+      auto indexed_time = time_publishes(subscriber_count,
+        [] (auto& subscriptions, auto& client, const auto& filter) {
+          subscriptions.add(client, Range::TOTAL, filter);
+        });
+      std::cout << subscriber_count << ", " << evaluator_time << ", " <<
+        indexed_time << ", " << evaluator_time / indexed_time << std::endl;
+    }
+  }
 }
 
-int main() {
+int main(int argc, const char** argv) {
+  if(argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+    benchmark_subscriptions();
+    return 0;
+  }
   auto server = LocalServerConnection();
   auto servlet = DataServletContainer(init(), &server, [] {
     return std::make_unique<TriggerTimer>();
@@ -0,0 +1,62 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include "Beam/Queues/MpscQueue.hpp"
+#include "Beam/Queues/Queue.hpp"
+#include "Beam/Queues/SpscQueue.hpp"
+#include "Beam/Queues/StateQueue.hpp"
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+
+using namespace Beam;
+
+namespace {
+  const auto PUSH_COUNT = 1000000;
+
+  template<typename Q>
+  void profile(std::string_view name, std::size_t producer_count) {
+    auto thread_count = Details::Scheduler::get().get_thread_count();
+    auto queue = std::make_shared<Q>();
+    auto pop_count = std::uint64_t(0);
+    auto start = std::chrono::steady_clock::now();
+    auto consumer = RoutineHandlerGroup();
+    consumer.add(spawn([&] {
+      try {
+        while(true) {
+          queue->pop();
+          ++pop_count;
+        }
+      } catch(const PipeBrokenException&) {}
+    }, Details::Scheduler::DEFAULT_STACK_SIZE, 0));
+    auto producers = RoutineHandlerGroup();
+    for(auto i = std::size_t(0); i != producer_count; ++i) {
+      producers.add(spawn([&] {
+        for(auto j = 0; j != PUSH_COUNT; ++j) {
+          queue->push(j);
+        }
+      }, Details::Scheduler::DEFAULT_STACK_SIZE, (i + 1) % thread_count));
+    }
+    producers.wait();
+    queue->close();
+    consumer.wait();
+    auto elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ", " << producer_count << ", " <<
+      static_cast<std::uint64_t>(producer_count * PUSH_COUNT / elapsed) <<
+      ", " << static_cast<std::uint64_t>(pop_count / elapsed) << std::endl;
+  }
+}
+
+int main() {
+  auto thread_count = Details::Scheduler::get().get_thread_count();
+  std::cout << "Queue, Producers, Pushes/s, Pops/s" << std::endl;
+  profile<Queue<int>>("Queue", 1);
+  profile<StateQueue<int>>("StateQueue", 1);
+  profile<SpscQueue<int>>("SpscQueue", 1);
+  profile<MpscQueue<int>>("MpscQueue", 1);
+  for(auto i = std::size_t(2); i < thread_count; ++i) {
+    profile<Queue<int>>("Queue", i);
+    profile<StateQueue<int>>("StateQueue", i);
+    profile<MpscQueue<int>>("MpscQueue", i);
+  }
+}
@@ -0,0 +1,3 @@
+@ECHO OFF
+CALL "%~dp0..\..\Beam\version.bat" QUEUE_PROFILER
+EXIT /B %ERRORLEVEL%
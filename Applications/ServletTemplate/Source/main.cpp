@@ -5,6 +5,7 @@
 #include "Beam/Codecs/ZLibEncoder.hpp"
 #include "Beam/IO/SharedBuffer.hpp"
 #include "Beam/Network/TcpServerSocket.hpp"
+#include "Beam/Routines/ThreadingConfig.hpp"
 #include "Beam/Serialization/BinaryReceiver.hpp"
 #include "Beam/Serialization/BinarySender.hpp"
 #include "Beam/Services/ServiceProtocolServletContainer.hpp"
@@ -33,6 +34,7 @@ int main(int argc, const char** argv) {
     auto config =
       parse_command_line(argc, argv, "1.0-r" SERVLET_TEMPLATE_VERSION
         "\nCopyright (C) 2020 Spire Trading Inc.");
+    configure_threads(config);
     auto interface = extract<IpAddress>(config, "interface");
     auto server = ServletTemplateServletContainer(init(), init(interface),
       std::bind(factory<std::shared_ptr<LiveTimer>>(), seconds(10)));
@@ -0,0 +1,39 @@
+#include <chrono>
+#include <iostream>
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+
+using namespace Beam;
+
+namespace {
+  const auto SPAWN_COUNT = 200000;
+  const auto BATCH_SIZE = 1000;
+
+  double measure_throughput(std::size_t spawner_count) {
+    auto start = std::chrono::steady_clock::now();
+    auto spawners = RoutineHandlerGroup();
+    for(auto i = std::size_t(0); i != spawner_count; ++i) {
+      spawners.add(spawn([] {
+        for(auto j = 0; j < SPAWN_COUNT; j += BATCH_SIZE) {
+          auto routines = RoutineHandlerGroup();
+          for(auto k = 0; k != BATCH_SIZE; ++k) {
+            routines.spawn([] {});
+          }
+          routines.wait();
+        }
+      }, Details::Scheduler::DEFAULT_STACK_SIZE, i));
+    }
+    spawners.wait();
+    auto elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(spawner_count * SPAWN_COUNT) / elapsed;
+  }
+}
+
+int main() {
+  auto thread_count = Details::Scheduler::get().get_thread_count();
+  std::cout << "Spawners, Routines/s" << std::endl;
+  for(auto i = std::size_t(1); i <= thread_count; ++i) {
+    std::cout << i << ", " << static_cast<std::uint64_t>(
+      measure_throughput(i)) << std::endl;
+  }
+}
@@ -0,0 +1,3 @@
+@ECHO OFF
+CALL "%~dp0..\..\Beam\version.bat" SPAWN_STRESS_TEST
+EXIT /B %ERRORLEVEL%
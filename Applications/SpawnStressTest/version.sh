@@ -0,0 +1,3 @@
+#!/bin/bash
+DIRECTORY="$(cd -P "$(dirname "${BASH_SOURCE[0]}")" >/dev/null && pwd -P)"
+exec "$DIRECTORY/../../Beam/version.sh" SPAWN_STRESS_TEST
@@ -1,6 +1,10 @@
 #ifndef BEAM_ASYNC_WRITER_HPP
 #define BEAM_ASYNC_WRITER_HPP
+#include <deque>
 #include <type_traits>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/throw_exception.hpp>
 #include "Beam/IO/SharedBuffer.hpp"
 #include "Beam/IO/Writer.hpp"
@@ -8,9 +12,13 @@
 #include "Beam/Pointers/LocalPtr.hpp"
 #include "Beam/Queues/PipeBrokenException.hpp"
 #include "Beam/Queues/RoutineTaskQueue.hpp"
+#include "Beam/TimeService/LiveTimer.hpp"
 
 namespace Beam {
 
+  /** The batch size used by an AsyncWriter that coalesces writes. */
+  inline constexpr auto DEFAULT_WRITE_BATCH_SIZE = std::size_t(64 * 1024);
+
   /**
    * Asynchronously writes to a destination using a Routine.
    * @tparam W The Writer to write to.
@@ -23,12 +31,26 @@ namespace Beam {
       using DestinationWriter = dereference_t<W>;
 
       /**
-       * Constructs an AsyncWriter.
+       * Constructs an AsyncWriter that writes each buffer separately.
        * @param destination Used to initialize the destination of all writes.
        */
       template<Initializes<W> WF>
       explicit AsyncWriter(WF&& destination);
 
+      /**
+       * Constructs an AsyncWriter that coalesces the buffers pending while
+       * the destination is busy into batches written with a single call.
+       * @param destination Used to initialize the destination of all writes.
+       * @param max_batch_size The number of bytes at which a batch is ended,
+       *        buffers at least this large are written on their own.
+       * @param latency_budget How long to wait for further buffers before
+       *        writing a batch that isn't full.
+       */
+      template<Initializes<W> WF>
+      AsyncWriter(WF&& destination, std::size_t max_batch_size,
+        boost::posix_time::time_duration latency_budget =
+          boost::posix_time::time_duration());
+
       template<IsConstBuffer T>
       void write(const T& data);
       template<IsConstBuffer T>
@@ -36,31 +58,59 @@ namespace Beam {
 
     private:
       local_ptr_t<W> m_destination;
+      std::size_t m_max_batch_size;
+      boost::posix_time::time_duration m_latency_budget;
+      boost::mutex m_mutex;
+      std::deque<SharedBuffer> m_batches;
+      bool m_is_draining;
       std::exception_ptr m_exception;
       RoutineTaskQueue m_tasks;
+
+      AsyncWriter(const AsyncWriter&) = delete;
+      AsyncWriter& operator =(const AsyncWriter&) = delete;
+      template<typename B>
+      void coalesce(B&& data);
+      void drain();
+      void fail();
   };
 
   template<typename W>
   AsyncWriter(W&&) -> AsyncWriter<std::remove_cvref_t<W>>;
 
+  template<typename W>
+  AsyncWriter(W&&, std::size_t) -> AsyncWriter<std::remove_cvref_t<W>>;
+
+  template<typename W>
+  AsyncWriter(W&&, std::size_t, boost::posix_time::time_duration) ->
+    AsyncWriter<std::remove_cvref_t<W>>;
+
   template<typename W> requires IsWriter<dereference_t<W>>
   template<Initializes<W> WF>
   AsyncWriter<W>::AsyncWriter(WF&& destination)
-    : m_destination(std::forward<WF>(destination)) {}
+    : AsyncWriter(std::forward<WF>(destination), 0) {}
+
+  template<typename W> requires IsWriter<dereference_t<W>>
+  template<Initializes<W> WF>
+  AsyncWriter<W>::AsyncWriter(WF&& destination, std::size_t max_batch_size,
+    boost::posix_time::time_duration latency_budget)
+    : m_destination(std::forward<WF>(destination)),
+      m_max_batch_size(max_batch_size),
+      m_latency_budget(latency_budget),
+      m_is_draining(false) {}
 
   template<typename W> requires IsWriter<dereference_t<W>>
   template<IsConstBuffer B>
   void AsyncWriter<W>::write(const B& data) {
+    if(m_max_batch_size != 0) {
+      coalesce(data);
+      return;
+    }
     try {
       m_tasks.push([=, this] {
         try {
           m_destination->write(data);
         } catch(const std::exception&) {
-          if(!m_exception) {
-            m_exception = std::current_exception();
-            m_tasks.close();
-            boost::throw_with_location(PipeBrokenException());
-          }
+          fail();
         }
       });
     } catch(const PipeBrokenException&) {
@@ -71,22 +121,100 @@ namespace Beam {
   template<typename W> requires IsWriter<dereference_t<W>>
   template<IsConstBuffer B>
   void AsyncWriter<W>::write(B&& data) {
+    if(m_max_batch_size != 0) {
+      coalesce(std::forward<B>(data));
+      return;
+    }
     try {
       m_tasks.push([=, data = std::move(data), this] {
         try {
           m_destination->write(data);
         } catch(const std::exception&) {
-          if(!m_exception) {
-            m_exception = std::current_exception();
-            m_tasks.close();
-            boost::throw_with_location(PipeBrokenException());
-          }
+          fail();
         }
       });
     } catch(const PipeBrokenException&) {
       std::rethrow_exception(m_exception);
     }
   }
+
+  template<typename W> requires IsWriter<dereference_t<W>>
+  template<typename B>
+  void AsyncWriter<W>::coalesce(B&& data) {
+    {
+      auto lock = boost::lock_guard(m_mutex);
+      if(m_exception) {
+        std::rethrow_exception(m_exception);
+      }
+      if(data.get_size() == 0) {
+        return;
+      }
+      if(m_batches.empty() || m_batches.back().get_size() + data.get_size() >
+          m_max_batch_size) {
+        m_batches.emplace_back(std::forward<B>(data));
+      } else {
+        append(m_batches.back(), data);
+      }
+      if(m_is_draining) {
+        return;
+      }
+      m_is_draining = true;
+    }
+    try {
+      m_tasks.push([this] {
+        drain();
+      });
+    } catch(const PipeBrokenException&) {
+      std::rethrow_exception(m_exception);
+    }
+  }
+
+  template<typename W> requires IsWriter<dereference_t<W>>
+  void AsyncWriter<W>::drain() {
+    if(m_latency_budget > boost::posix_time::time_duration()) {
+      auto is_full = [&] {
+        auto lock = boost::lock_guard(m_mutex);
+        return m_batches.size() > 1 ||
+          m_batches.front().get_size() >= m_max_batch_size;
+      }();
+      if(!is_full) {
+        auto timer = LiveTimer(m_latency_budget);
+        timer.start();
+        timer.wait();
+      }
+    }
+    while(true) {
+      auto batch = SharedBuffer();
+      {
+        auto lock = boost::lock_guard(m_mutex);
+        if(m_batches.empty()) {
+          m_is_draining = false;
+          return;
+        }
+        batch = std::move(m_batches.front());
+        m_batches.pop_front();
+      }
+      try {
+        m_destination->write(batch);
+      } catch(const std::exception&) {
+        {
+          auto lock = boost::lock_guard(m_mutex);
+          m_batches.clear();
+        }
+        fail();
+      }
+    }
+  }
+
+  template<typename W> requires IsWriter<dereference_t<W>>
+  void AsyncWriter<W>::fail() {
+    auto lock = boost::lock_guard(m_mutex);
+    if(!m_exception) {
+      m_exception = std::current_exception();
+      m_tasks.close();
+      boost::throw_with_location(PipeBrokenException());
+    }
+  }
 }
 
 #endif
@@ -0,0 +1,247 @@
+#ifndef BEAM_BUFFER_POOL_HPP
+#define BEAM_BUFFER_POOL_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+#include <boost/throw_exception.hpp>
+
+namespace Beam {
+
+  /** Stores the metrics of the calling thread's buffer pool. */
+  struct BufferPoolStatistics {
+
+    /** The number of blocks allocated from the system. */
+    std::uint64_t m_allocations = 0;
+
+    /** The number of blocks reused from the pool. */
+    std::uint64_t m_reuses = 0;
+  };
+
+  /**
+   * Pools the memory blocks backing buffers in size classes local to each
+   * thread, so that buffers of recurring sizes are allocated without going
+   * to the system. Blocks are returned to the pool of the thread that
+   * releases them.
+   */
+  class BufferPool {
+    public:
+
+      /** The size of the smallest pooled block. */
+      static constexpr auto MIN_BLOCK_SIZE = std::size_t(64);
+
+      /** The size of the largest pooled block. */
+      static constexpr auto MAX_BLOCK_SIZE = std::size_t(64 * 1024);
+
+      /** The number of blocks pooled for each size class. */
+      static constexpr auto BLOCKS_PER_CLASS = std::size_t(64);
+
+      /** Returns the calling thread's BufferPool. */
+      static BufferPool& get();
+
+      /**
+       * Allocates a block of memory from the calling thread's BufferPool, or
+       * from the system once that pool has been destroyed on thread exit.
+       * @param size The minimum size of the block.
+       * @return The allocated block.
+       */
+      static void* allocate_local(std::size_t size);
+
+      /**
+       * Releases a block of memory to the calling thread's BufferPool, or to
+       * the system once that pool has been destroyed on thread exit.
+       * @param block The block to release.
+       * @param size The size the block was allocated with.
+       */
+      static void deallocate_local(void* block, std::size_t size) noexcept;
+
+      ~BufferPool();
+
+      /** Returns this pool's statistics. */
+      const BufferPoolStatistics& get_statistics() const;
+
+      /**
+       * Allocates a block of memory.
+       * @param size The minimum size of the block.
+       * @return The allocated block.
+       */
+      void* allocate(std::size_t size);
+
+      /**
+       * Releases a block of memory, pooling it if there is room.
+       * @param block The block to release.
+       * @param size The size the block was allocated with.
+       */
+      void deallocate(void* block, std::size_t size) noexcept;
+
+    private:
+      static constexpr auto CLASS_COUNT =
+        std::countr_zero(MAX_BLOCK_SIZE / MIN_BLOCK_SIZE) + 1;
+      static inline thread_local bool m_is_destroyed = false;
+      std::array<std::vector<void*>, CLASS_COUNT> m_blocks;
+      BufferPoolStatistics m_statistics;
+
+      BufferPool() = default;
+      BufferPool(const BufferPool&) = delete;
+      BufferPool& operator =(const BufferPool&) = delete;
+      static std::size_t get_class(std::size_t size);
+      static void* allocate_system(std::size_t size);
+  };
+
+  /**
+   * An allocator drawing from the calling thread's BufferPool.
+   * @tparam T The type of value to allocate.
+   */
+  template<typename T>
+  struct BufferPoolAllocator {
+    using value_type = T;
+
+    BufferPoolAllocator() = default;
+
+    template<typename U>
+    BufferPoolAllocator(const BufferPoolAllocator<U>&) noexcept;
+
+    T* allocate(std::size_t count);
+    void deallocate(T* block, std::size_t count) noexcept;
+
+    template<typename U>
+    bool operator ==(const BufferPoolAllocator<U>&) const noexcept;
+  };
+
+namespace Details {
+  struct PooledBytesDeleter {
+    std::size_t m_size;
+
+    void operator ()(char* block) const noexcept {
+      BufferPool::deallocate_local(block, m_size);
+    }
+  };
+}
+
+  /**
+   * Allocates a block of bytes from the calling thread's BufferPool. The
+   * reference count is kept in a separate pooled block, so the size class of
+   * the bytes depends only on their number.
+   * @param size The number of bytes to allocate.
+   * @return A shared pointer to the uninitialized bytes.
+   */
+  inline std::shared_ptr<char> allocate_pooled_bytes(std::size_t size) {
+    auto block = static_cast<char*>(BufferPool::allocate_local(size));
+    return std::shared_ptr<char>(
+      block, Details::PooledBytesDeleter(size), BufferPoolAllocator<char>());
+  }
+
+  inline BufferPool& BufferPool::get() {
+    thread_local auto pool = BufferPool();
+    return pool;
+  }
+
+  inline void* BufferPool::allocate_local(std::size_t size) {
+    if(m_is_destroyed) {
+      return allocate_system(size);
+    }
+    return get().allocate(size);
+  }
+
+  inline void BufferPool::deallocate_local(
+      void* block, std::size_t size) noexcept {
+    if(m_is_destroyed) {
+      std::free(block);
+      return;
+    }
+    get().deallocate(block, size);
+  }
+
+  inline BufferPool::~BufferPool() {
+    m_is_destroyed = true;
+    for(auto& blocks : m_blocks) {
+      for(auto block : blocks) {
+        std::free(block);
+      }
+    }
+  }
+
+  inline const BufferPoolStatistics& BufferPool::get_statistics() const {
+    return m_statistics;
+  }
+
+  inline void* BufferPool::allocate(std::size_t size) {
+    if(m_is_destroyed) {
+      return allocate_system(size);
+    }
+    if(size <= MAX_BLOCK_SIZE) {
+      auto& blocks = m_blocks[get_class(size)];
+      if(!blocks.empty()) {
+        auto block = blocks.back();
+        blocks.pop_back();
+        ++m_statistics.m_reuses;
+        return block;
+      }
+    }
+    auto block = allocate_system(size);
+    ++m_statistics.m_allocations;
+    return block;
+  }
+
+  inline void BufferPool::deallocate(void* block, std::size_t size) noexcept {
+    if(size > MAX_BLOCK_SIZE || m_is_destroyed) {
+      std::free(block);
+      return;
+    }
+    auto& blocks = m_blocks[get_class(size)];
+    if(blocks.size() == BLOCKS_PER_CLASS) {
+      std::free(block);
+      return;
+    }
+    try {
+      blocks.push_back(block);
+    } catch(const std::exception&) {
+      std::free(block);
+    }
+  }
+
+  inline std::size_t BufferPool::get_class(std::size_t size) {
+    return std::countr_zero(
+      std::bit_ceil(std::max(size, MIN_BLOCK_SIZE)) / MIN_BLOCK_SIZE);
+  }
+
+  inline void* BufferPool::allocate_system(std::size_t size) {
+    if(size <= MAX_BLOCK_SIZE) {
+      size = std::bit_ceil(std::max(size, MIN_BLOCK_SIZE));
+    }
+    auto block = std::malloc(size);
+    if(!block) {
+      boost::throw_with_location(std::bad_alloc());
+    }
+    return block;
+  }
+
+  template<typename T>
+  template<typename U>
+  BufferPoolAllocator<T>::BufferPoolAllocator(
+    const BufferPoolAllocator<U>&) noexcept {}
+
+  template<typename T>
+  T* BufferPoolAllocator<T>::allocate(std::size_t count) {
+    return static_cast<T*>(BufferPool::allocate_local(count * sizeof(T)));
+  }
+
+  template<typename T>
+  void BufferPoolAllocator<T>::deallocate(
+      T* block, std::size_t count) noexcept {
+    BufferPool::deallocate_local(block, count * sizeof(T));
+  }
+
+  template<typename T>
+  template<typename U>
+  bool BufferPoolAllocator<T>::operator ==(
+      const BufferPoolAllocator<U>&) const noexcept {
+    return true;
+  }
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include <stdexcept>
 #include <boost/throw_exception.hpp>
 #include "Beam/IO/Buffer.hpp"
+#include "Beam/IO/BufferPool.hpp"
 
 namespace Beam {
 
@@ -38,6 +39,17 @@ namespace Beam {
        */
       SharedBuffer(const IsConstBuffer auto& buffer);
 
+      /**
+       * Constructs a SharedBuffer viewing a range of another SharedBuffer's
+       * data without copying it. The data is copied when either buffer is
+       * next modified.
+       * @param buffer The buffer to view.
+       * @param offset The offset of the range to view.
+       * @param size The size of the range to view.
+       */
+      SharedBuffer(
+        const SharedBuffer& buffer, std::size_t offset, std::size_t size);
+
       SharedBuffer(const SharedBuffer&) = default;
       SharedBuffer(SharedBuffer&& buffer) noexcept;
 
@@ -71,10 +83,7 @@ namespace Beam {
     if(m_capacity == 0) {
       return;
     }
-    m_data.reset(static_cast<char*>(std::malloc(m_capacity)), &std::free);
-    if(!m_data) {
-      boost::throw_with_location(std::bad_alloc());
-    }
+    m_data = allocate_pooled_bytes(m_capacity);
   }
 
   inline SharedBuffer::SharedBuffer(const void* data, std::size_t size)
@@ -89,6 +98,17 @@ namespace Beam {
     append(*this, buffer);
   }
 
+  inline SharedBuffer::SharedBuffer(
+      const SharedBuffer& buffer, std::size_t offset, std::size_t size)
+      : m_size(size),
+        m_capacity(size) {
+    assert(offset + size <= buffer.m_size);
+    if(size != 0) {
+      m_data =
+        std::shared_ptr<char>(buffer.m_data, buffer.m_data.get() + offset);
+    }
+  }
+
   inline SharedBuffer::SharedBuffer(SharedBuffer&& buffer) noexcept
       : m_size(buffer.m_size),
         m_capacity(buffer.m_capacity),
@@ -181,12 +201,9 @@ namespace Beam {
       m_capacity = 0;
       return;
     }
-    auto new_data = static_cast<char*>(std::malloc(size));
-    if(!new_data) {
-      boost::throw_with_location(std::bad_alloc());
-    }
-    std::memcpy(new_data, m_data.get(), m_size);
-    m_data.reset(new_data, &std::free);
+    auto new_data = allocate_pooled_bytes(size);
+    std::memcpy(new_data.get(), m_data.get(), m_size);
+    m_data = std::move(new_data);
     m_capacity = size;
   }
 }
@@ -41,7 +41,13 @@ namespace Beam {
   template<IsBuffer R>
   std::size_t TcpSocketReader::read(Out<R> destination, std::size_t size) {
     static const auto DEFAULT_READ_SIZE = std::size_t(8 * 1024);
-    auto available_size = destination->grow(std::min(DEFAULT_READ_SIZE, size));
+    static const auto MAX_READ_SIZE = std::size_t(64 * 1024);
+    auto available_size = destination->grow([&] {
+      if(size == std::size_t(-1)) {
+        return DEFAULT_READ_SIZE;
+      }
+      return std::min(MAX_READ_SIZE, size);
+    }());
     auto read_result = Async<std::size_t>();
     {
       auto lock = std::lock_guard(m_socket->m_mutex);
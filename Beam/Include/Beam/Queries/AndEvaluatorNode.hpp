@@ -1,7 +1,10 @@
 #ifndef BEAM_AND_EVALUATOR_NODE_HPP
 #define BEAM_AND_EVALUATOR_NODE_HPP
+#include <algorithm>
+#include <span>
 #include <utility>
-#include "Beam/Queries/EvaluatorNode.hpp"
+#include <vector>
+#include "Beam/Queries/EvaluatorOperand.hpp"
 
 namespace Beam {
 
@@ -18,11 +21,18 @@ namespace Beam {
       AndEvaluatorNode(std::unique_ptr<EvaluatorNode<bool>> left,
         std::unique_ptr<EvaluatorNode<bool>> right);
 
+      /** Returns <code>true</code> iff both operands are constants. */
+      bool is_constant() const;
+
       bool eval() override;
+      bool eval_batch(
+        const EvaluatorBatch& batch, std::span<bool> results) override;
 
     private:
-      std::unique_ptr<EvaluatorNode<bool>> m_left;
-      std::unique_ptr<EvaluatorNode<bool>> m_right;
+      EvaluatorOperand<bool> m_left;
+      EvaluatorOperand<bool> m_right;
+      std::vector<const void*> m_rows;
+      std::vector<std::size_t> m_indexes;
   };
 
   inline AndEvaluatorNode::AndEvaluatorNode(
@@ -31,8 +41,59 @@ namespace Beam {
     : m_left(std::move(left)),
       m_right(std::move(right)) {}
 
+  inline bool AndEvaluatorNode::is_constant() const {
+    return m_left.is_constant() && m_right.is_constant();
+  }
+
   inline bool AndEvaluatorNode::eval() {
-    return m_left->eval() && m_right->eval();
+    return m_left.eval() && m_right.eval();
+  }
+
+  inline bool AndEvaluatorNode::eval_batch(
+      const EvaluatorBatch& batch, std::span<bool> results) {
+    if(!m_left.load(batch)) {
+      return false;
+    }
+    if(m_right.is_constant()) {
+      auto right = *m_right.get_values();
+      for(auto i = std::size_t(0); i != results.size(); ++i) {
+        results[i] = m_left.get(i) && right;
+      }
+      return true;
+    }
+    m_indexes.resize(results.size());
+    auto count = std::size_t(0);
+    for(auto i = std::size_t(0); i != results.size(); ++i) {
+      m_indexes[count] = i;
+      count += m_left.get(i);
+    }
+    if(count == results.size()) {
+      if(!m_right.load(batch)) {
+        return false;
+      }
+      for(auto i = std::size_t(0); i != results.size(); ++i) {
+        results[i] = m_right.get(i);
+      }
+      return true;
+    }
+    std::fill(results.begin(), results.end(), false);
+    if(count == 0) {
+      return true;
+    }
+    auto parameter_count = batch.get_parameter_count();
+    m_rows.resize(count * parameter_count);
+    for(auto i = std::size_t(0); i != count; ++i) {
+      std::copy_n(batch.get_row(m_indexes[i]), parameter_count,
+        m_rows.data() + i * parameter_count);
+    }
+    if(!m_right.load(
+        EvaluatorBatch(m_rows.data(), count, parameter_count))) {
+      return false;
+    }
+    for(auto i = std::size_t(0); i != count; ++i) {
+      results[m_indexes[i]] = m_right.get(i);
+    }
+    return true;
   }
 }
 
@@ -1,17 +1,21 @@
 #ifndef BEAM_ASYNC_DATA_STORE_HPP
 #define BEAM_ASYNC_DATA_STORE_HPP
+#include <algorithm>
 #include <array>
-#include <functional>
-#include <iostream>
 #include <memory>
+#include <span>
+#include <utility>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include "Beam/IO/OpenState.hpp"
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
+#include "Beam/Queries/BatchLoad.hpp"
+#include "Beam/Queries/BufferStatistics.hpp"
+#include "Beam/Queries/FlushController.hpp"
 #include "Beam/Queries/LocalDataStore.hpp"
+#include "Beam/Queries/WriteAheadLog.hpp"
 #include "Beam/Queues/RoutineTaskQueue.hpp"
-#include "Beam/Utilities/ReportException.hpp"
 #include "Beam/Utilities/TypeTraits.hpp"
 
 namespace Beam {
@@ -121,10 +125,10 @@ namespace Details {
       using EvaluatorTranslatorFilter = E;
 
       /**
-       * The type of callback invoked when a flush to the destination data store
-       * fails. The failed data is retained and retried on the next flush.
+       * The type of callback invoked when a flush fails, see FlushController.
        */
-      using ExceptionHandler = std::function<void (const std::exception_ptr&)>;
+      using ExceptionHandler =
+        typename FlushController<IndexedValue>::ExceptionHandler;
 
       /**
        * Constructs an AsyncDataStore.
@@ -141,9 +145,49 @@ namespace Details {
       template<Initializes<D> DS>
       AsyncDataStore(DS&& data_store, ExceptionHandler exception_handler);
 
+      /**
+       * Constructs an AsyncDataStore.
+       * @param data_store Initializes the data store to buffer data to.
+       * @param high_water_mark The number of buffered values at which stores
+       *        are suspended until a flush commits them.
+       */
+      template<Initializes<D> DS>
+      AsyncDataStore(DS&& data_store, std::size_t high_water_mark);
+
+      /**
+       * Constructs an AsyncDataStore.
+       * @param data_store Initializes the data store to buffer data to.
+       * @param high_water_mark The number of buffered values at which stores
+       *        are suspended until a flush commits them.
+       * @param exception_handler The callback invoked when a flush fails.
+       */
+      template<Initializes<D> DS>
+      AsyncDataStore(DS&& data_store, std::size_t high_water_mark,
+        ExceptionHandler exception_handler);
+
+      /**
+       * Constructs an AsyncDataStore that makes stores durable in a write-ahead
+       * log and recovers the values left in it, see FlushController.
+       * @param data_store Initializes the data store to buffer data to.
+       * @param high_water_mark The number of buffered values at which stores
+       *        are suspended until a flush commits them.
+       * @param log The log that stores are made durable in before returning.
+       * @param exception_handler The callback invoked when a flush, or the
+       *        reservation or truncation of a log segment, fails.
+       */
+      template<Initializes<D> DS>
+      AsyncDataStore(DS&& data_store, std::size_t high_water_mark,
+        std::unique_ptr<WriteAheadLog<IndexedValue>> log,
+        ExceptionHandler exception_handler);
+
       ~AsyncDataStore();
 
+      /** Returns the buffer depth and flush metrics. */
+      BufferStatistics get_statistics() const;
+
       std::vector<SequencedValue> load(const Query& query);
+      std::vector<std::vector<SequencedValue>> load(
+        std::span<const Query> queries);
       void store(const IndexedValue& value);
       void store(const std::vector<IndexedValue>& values);
       void close();
@@ -153,11 +197,12 @@ namespace Details {
         LocalDataStore<Query, Value, EvaluatorTranslatorFilter>;
       mutable boost::mutex m_mutex;
       local_ptr_t<D> m_data_store;
-      ExceptionHandler m_exception_handler;
       std::shared_ptr<ReserveDataStore> m_current_data_store;
       std::shared_ptr<ReserveDataStore> m_flushed_data_store;
       bool m_is_flushing;
+      std::size_t m_current_count;
       OpenState m_open_state;
+      FlushController<IndexedValue> m_controller;
       RoutineTaskQueue m_tasks;
 
       AsyncDataStore(const AsyncDataStore&) = delete;
@@ -173,6 +218,14 @@ namespace Details {
   AsyncDataStore(DS&& data_store, F&&) ->
     AsyncDataStore<std::remove_cvref_t<DS>>;
 
+  template<typename DS, typename F>
+  AsyncDataStore(DS&& data_store, std::size_t, F&&) ->
+    AsyncDataStore<std::remove_cvref_t<DS>>;
+
+  template<typename DS, typename L, typename F>
+  AsyncDataStore(DS&& data_store, std::size_t, L&&, F&&) ->
+    AsyncDataStore<std::remove_cvref_t<DS>>;
+
   template<typename D, typename E>
   template<Initializes<D> DS>
   AsyncDataStore<D, E>::AsyncDataStore(DS&& data_store)
@@ -182,17 +235,57 @@ namespace Details {
   template<Initializes<D> DS>
   AsyncDataStore<D, E>::AsyncDataStore(
     DS&& data_store, ExceptionHandler exception_handler)
+    : AsyncDataStore(std::forward<DS>(data_store), UNLIMITED_BUFFER,
+        std::move(exception_handler)) {}
+
+  template<typename D, typename E>
+  template<Initializes<D> DS>
+  AsyncDataStore<D, E>::AsyncDataStore(
+    DS&& data_store, std::size_t high_water_mark)
+    : AsyncDataStore(
+        std::forward<DS>(data_store), high_water_mark, ExceptionHandler()) {}
+
+  template<typename D, typename E>
+  template<Initializes<D> DS>
+  AsyncDataStore<D, E>::AsyncDataStore(DS&& data_store,
+    std::size_t high_water_mark, ExceptionHandler exception_handler)
+    : AsyncDataStore(std::forward<DS>(data_store), high_water_mark, nullptr,
+        std::move(exception_handler)) {}
+
+  template<typename D, typename E>
+  template<Initializes<D> DS>
+  AsyncDataStore<D, E>::AsyncDataStore(DS&& data_store,
+    std::size_t high_water_mark,
+    std::unique_ptr<WriteAheadLog<IndexedValue>> log,
+    ExceptionHandler exception_handler)
     : m_data_store(std::forward<DS>(data_store)),
-      m_exception_handler(std::move(exception_handler)),
       m_current_data_store(std::make_shared<ReserveDataStore>()),
       m_flushed_data_store(std::make_shared<ReserveDataStore>()),
-      m_is_flushing(false) {}
+      m_is_flushing(false),
+      m_current_count(0),
+      m_controller(m_mutex, m_open_state, high_water_mark, std::move(log),
+        std::move(exception_handler)) {
+    auto values = m_controller.recover(*m_data_store);
+    if(values.empty()) {
+      return;
+    }
+    auto lock = boost::lock_guard(m_mutex);
+    m_current_data_store->store(values);
+    m_current_count += values.size();
+    test_flush();
+  }
 
   template<typename D, typename E>
   AsyncDataStore<D, E>::~AsyncDataStore() {
     close();
   }
 
+  template<typename D, typename E>
+  BufferStatistics AsyncDataStore<D, E>::get_statistics() const {
+    auto lock = boost::lock_guard(m_mutex);
+    return m_controller.get_statistics();
+  }
+
   template<typename D, typename E>
   std::vector<typename AsyncDataStore<D, E>::SequencedValue>
       AsyncDataStore<D, E>::load(const Query& query) {
@@ -211,18 +304,51 @@ namespace Details {
     }
   }
 
+  template<typename D, typename E>
+  std::vector<std::vector<typename AsyncDataStore<D, E>::SequencedValue>>
+      AsyncDataStore<D, E>::load(std::span<const Query> queries) {
+    auto [current_data_store, flushed_data_store] = [&] {
+      auto lock = boost::lock_guard(m_mutex);
+      return std::tuple(m_current_data_store, m_flushed_data_store);
+    }();
+    auto values = batch_load(*m_data_store, queries);
+    for(auto i = std::size_t(0); i != queries.size(); ++i) {
+      auto& query = queries[i];
+      if(query.get_snapshot_limit().get_type() == SnapshotLimit::Type::HEAD) {
+        values[i] = Details::merge<SnapshotLimit::Type::HEAD>(
+          current_data_store->load(query), flushed_data_store->load(query),
+          std::move(values[i]), query.get_snapshot_limit().get_size());
+      } else {
+        values[i] = Details::merge<SnapshotLimit::Type::TAIL>(
+          current_data_store->load(query), flushed_data_store->load(query),
+          std::move(values[i]), query.get_snapshot_limit().get_size());
+      }
+    }
+    return values;
+  }
+
   template<typename D, typename E>
   void AsyncDataStore<D, E>::store(const IndexedValue& value) {
-    auto lock = boost::lock_guard(m_mutex);
+    auto lock = boost::unique_lock(m_mutex);
+    m_controller.wait_for_capacity(lock);
+    auto position = m_controller.stage(std::span(&value, 1));
     m_current_data_store->store(value);
+    ++m_current_count;
     test_flush();
+    lock.unlock();
+    m_controller.sync(position);
   }
 
   template<typename D, typename E>
   void AsyncDataStore<D, E>::store(const std::vector<IndexedValue>& values) {
-    auto lock = boost::lock_guard(m_mutex);
+    auto lock = boost::unique_lock(m_mutex);
+    m_controller.wait_for_capacity(lock);
+    auto position = m_controller.stage(values);
     m_current_data_store->store(values);
+    m_current_count += values.size();
     test_flush();
+    lock.unlock();
+    m_controller.sync(position);
   }
 
   template<typename D, typename E>
@@ -230,6 +356,7 @@ namespace Details {
     if(m_open_state.set_closing()) {
       return;
     }
+    m_controller.close();
     m_tasks.close();
     m_tasks.wait();
     m_open_state.close();
@@ -247,30 +374,26 @@ namespace Details {
 
   template<typename D, typename E>
   void AsyncDataStore<D, E>::flush() {
-    {
-      auto lock = boost::lock_guard(m_mutex);
-      m_flushed_data_store.swap(m_current_data_store);
-      m_is_flushing = false;
-    }
-    try {
-      m_data_store->store(m_flushed_data_store->load_all());
-    } catch(...) {
-      {
+    m_controller.flush(
+      [&] {
+        m_flushed_data_store.swap(m_current_data_store);
+        m_is_flushing = false;
+        return std::exchange(m_current_count, 0);
+      },
+      [&] {
+        m_data_store->store(m_flushed_data_store->load_all());
+      },
+      [&] (auto count) {
         auto failed = m_flushed_data_store->load_all();
         auto lock = boost::lock_guard(m_mutex);
         m_current_data_store->store(failed);
-      }
-      if(m_exception_handler) {
-        m_exception_handler(std::current_exception());
-      } else {
-        std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
-      }
-    }
-    auto new_data_store = std::make_shared<ReserveDataStore>();
-    {
-      auto lock = boost::lock_guard(m_mutex);
-      m_flushed_data_store = std::move(new_data_store);
-    }
+        m_current_count += count;
+      },
+      [&] {
+        auto new_data_store = std::make_shared<ReserveDataStore>();
+        auto lock = boost::lock_guard(m_mutex);
+        m_flushed_data_store = std::move(new_data_store);
+      });
   }
 }
 
@@ -0,0 +1,70 @@
+#ifndef BEAM_BATCH_LOAD_HPP
+#define BEAM_BATCH_LOAD_HPP
+#include <exception>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+
+namespace Beam {
+
+  /**
+   * Loads a batch of queries concurrently, each in its own Routine, so that
+   * queries waiting on a data store's connections overlap rather than being
+   * made one after another.
+   * @param queries The queries to load.
+   * @param load The function used to load a single query.
+   * @return The result of each query, in the same order as the queries.
+   */
+  template<typename Q, typename F>
+  auto load_concurrently(std::span<const Q> queries, F&& load) {
+    using Result = std::remove_cvref_t<std::invoke_result_t<F&, const Q&>>;
+    auto results = std::vector<Result>(queries.size());
+    if(queries.size() == 1) {
+      results.front() = std::invoke(load, queries.front());
+      return results;
+    }
+    auto exceptions = std::vector<std::exception_ptr>(queries.size());
+    {
+      auto routines = RoutineHandlerGroup();
+      for(auto i = std::size_t(0); i != queries.size(); ++i) {
+        routines.spawn([&, i] {
+          try {
+            results[i] = std::invoke(load, queries[i]);
+          } catch(...) {
+            exceptions[i] = std::current_exception();
+          }
+        });
+      }
+    }
+    for(auto& exception : exceptions) {
+      if(exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+    return results;
+  }
+
+  /**
+   * Loads a batch of queries from a data store, using the data store's own
+   * batched load when it provides one. A data store provides one by declaring
+   * a load taking a std::span of queries that returns the values loaded by
+   * each query, in the same order as the queries.
+   * @param data_store The data store to load from.
+   * @param queries The queries to load.
+   * @return The values loaded by each query, in the same order as the queries.
+   */
+  template<typename D>
+  auto batch_load(D& data_store, std::span<const typename D::Query> queries) {
+    if constexpr(requires { data_store.load(queries); }) {
+      return data_store.load(queries);
+    } else {
+      return load_concurrently(queries, [&] (const auto& query) {
+        return data_store.load(query);
+      });
+    }
+  }
+}
+
+#endif
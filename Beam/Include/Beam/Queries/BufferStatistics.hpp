@@ -0,0 +1,56 @@
+#ifndef BEAM_BUFFER_STATISTICS_HPP
+#define BEAM_BUFFER_STATISTICS_HPP
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace Beam {
+
+  /** The high-water mark of a write buffer that never suspends a store. */
+  inline constexpr auto UNLIMITED_BUFFER =
+    std::numeric_limits<std::size_t>::max();
+
+  /** The delay before retrying a flush that failed. */
+  inline const auto MIN_FLUSH_RETRY_DELAY = boost::posix_time::milliseconds(10);
+
+  /** The longest delay between retries of a flush that keeps failing. */
+  inline const auto MAX_FLUSH_RETRY_DELAY = boost::posix_time::seconds(5);
+
+  /** Stores the metrics of a data store that buffers writes. */
+  struct BufferStatistics {
+
+    /** The number of values stored but not yet committed. */
+    std::size_t m_depth = 0;
+
+    /** The number of buffered values at which stores are suspended. */
+    std::size_t m_high_water_mark = UNLIMITED_BUFFER;
+
+    /** The number of flushes committed. */
+    std::uint64_t m_flushes = 0;
+
+    /** The number of flushes that failed. */
+    std::uint64_t m_failures = 0;
+
+    /** The time taken to commit the most recent flush. */
+    boost::posix_time::time_duration m_last_flush_latency;
+
+    /** The longest time taken to commit a flush. */
+    boost::posix_time::time_duration m_max_flush_latency;
+  };
+
+  /**
+   * Records a committed flush.
+   * @param statistics The statistics to update.
+   * @param latency The time taken to commit the flush.
+   */
+  inline void record_flush(BufferStatistics& statistics,
+      boost::posix_time::time_duration latency) {
+    ++statistics.m_flushes;
+    statistics.m_last_flush_latency = latency;
+    statistics.m_max_flush_latency =
+      std::max(statistics.m_max_flush_latency, latency);
+  }
+}
+
+#endif
@@ -1,9 +1,9 @@
 #ifndef BEAM_BUFFERED_DATA_STORE_HPP
 #define BEAM_BUFFERED_DATA_STORE_HPP
 #include <algorithm>
-#include <functional>
-#include <iostream>
 #include <memory>
+#include <span>
+#include <utility>
 #include <vector>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
@@ -11,11 +11,14 @@
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
 #include "Beam/Pointers/Ref.hpp"
+#include "Beam/Queries/BatchLoad.hpp"
+#include "Beam/Queries/BufferStatistics.hpp"
+#include "Beam/Queries/FlushController.hpp"
 #include "Beam/Queries/LocalDataStore.hpp"
 #include "Beam/Queries/Range.hpp"
+#include "Beam/Queries/WriteAheadLog.hpp"
 #include "Beam/Queues/RoutineTaskQueue.hpp"
 #include "Beam/Utilities/Algorithm.hpp"
-#include "Beam/Utilities/ReportException.hpp"
 
 namespace Beam {
 
@@ -51,10 +54,10 @@ namespace Beam {
       using EvaluatorTranslatorFilter = E;
 
       /**
-       * The type of callback invoked when a flush to the destination data store
-       * fails. The failed data is retained and retried on the next flush.
+       * The type of callback invoked when a flush fails, see FlushController.
        */
-      using ExceptionHandler = std::function<void (const std::exception_ptr&)>;
+      using ExceptionHandler =
+        typename FlushController<IndexedValue>::ExceptionHandler;
 
       /**
        * Constructs a BufferedDataStore.
@@ -76,9 +79,58 @@ namespace Beam {
       BufferedDataStore(DS&& data_size, std::size_t buffer_size,
         ExceptionHandler exception_handler);
 
+      /**
+       * Constructs a BufferedDataStore.
+       * @param data_size Initializes the data store to buffer data to.
+       * @param buffer_size The number of messages to buffer before committing
+       *        to the <i>data_size</i>.
+       * @param high_water_mark The number of buffered values at which stores
+       *        are suspended until a flush commits them.
+       */
+      template<Initializes<D> DS>
+      BufferedDataStore(DS&& data_size, std::size_t buffer_size,
+        std::size_t high_water_mark);
+
+      /**
+       * Constructs a BufferedDataStore.
+       * @param data_size Initializes the data store to buffer data to.
+       * @param buffer_size The number of messages to buffer before committing
+       *        to the <i>data_size</i>.
+       * @param high_water_mark The number of buffered values at which stores
+       *        are suspended until a flush commits them.
+       * @param exception_handler The callback invoked when a flush fails.
+       */
+      template<Initializes<D> DS>
+      BufferedDataStore(DS&& data_size, std::size_t buffer_size,
+        std::size_t high_water_mark, ExceptionHandler exception_handler);
+
+      /**
+       * Constructs a BufferedDataStore that makes stores durable in a
+       * write-ahead log and recovers the values left in it, see
+       * FlushController.
+       * @param data_size Initializes the data store to buffer data to.
+       * @param buffer_size The number of messages to buffer before committing
+       *        to the <i>data_size</i>.
+       * @param high_water_mark The number of buffered values at which stores
+       *        are suspended until a flush commits them.
+       * @param log The log that stores are made durable in before returning.
+       * @param exception_handler The callback invoked when a flush, or the
+       *        reservation or truncation of a log segment, fails.
+       */
+      template<Initializes<D> DS>
+      BufferedDataStore(DS&& data_size, std::size_t buffer_size,
+        std::size_t high_water_mark,
+        std::unique_ptr<WriteAheadLog<IndexedValue>> log,
+        ExceptionHandler exception_handler);
+
       ~BufferedDataStore();
 
+      /** Returns the buffer depth and flush metrics. */
+      BufferStatistics get_statistics() const;
+
       std::vector<SequencedValue> load(const Query& query);
+      std::vector<std::vector<SequencedValue>> load(
+        std::span<const Query> queries);
       void store(const IndexedValue& value);
       void store(const std::vector<IndexedValue>& values);
       void close();
@@ -88,12 +140,13 @@ namespace Beam {
         LocalDataStore<Query, Value, EvaluatorTranslatorFilter>;
       mutable boost::mutex m_mutex;
       local_ptr_t<D> m_data_store;
-      ExceptionHandler m_exception_handler;
       std::size_t m_buffer_size;
       std::size_t m_buffer_count;
+      std::size_t m_pending_count;
       std::shared_ptr<ReserveDataStore> m_data_store_buffer;
       std::shared_ptr<ReserveDataStore> m_flushed_data_store;
       OpenState m_open_state;
+      FlushController<IndexedValue> m_controller;
       RoutineTaskQueue m_tasks;
 
       BufferedDataStore(const BufferedDataStore&) = delete;
@@ -106,6 +159,10 @@ namespace Beam {
   BufferedDataStore(D&&, std::size_t) -> BufferedDataStore<
     local_ptr_t<D>, typename dereference_t<D>::EvaluatorTranslatorFilter>;
 
+  template<typename D>
+  BufferedDataStore(D&&, std::size_t, std::size_t) -> BufferedDataStore<
+    local_ptr_t<D>, typename dereference_t<D>::EvaluatorTranslatorFilter>;
+
   template<typename D, typename E>
   template<Initializes<D> DS>
   BufferedDataStore<D, E>::BufferedDataStore(
@@ -117,18 +174,62 @@ namespace Beam {
   template<Initializes<D> DS>
   BufferedDataStore<D, E>::BufferedDataStore(
     DS&& data_size, std::size_t buffer_size, ExceptionHandler exception_handler)
+    : BufferedDataStore(std::forward<DS>(data_size), buffer_size,
+        UNLIMITED_BUFFER, std::move(exception_handler)) {}
+
+  template<typename D, typename E>
+  template<Initializes<D> DS>
+  BufferedDataStore<D, E>::BufferedDataStore(
+    DS&& data_size, std::size_t buffer_size, std::size_t high_water_mark)
+    : BufferedDataStore(std::forward<DS>(data_size), buffer_size,
+        high_water_mark, ExceptionHandler()) {}
+
+  template<typename D, typename E>
+  template<Initializes<D> DS>
+  BufferedDataStore<D, E>::BufferedDataStore(DS&& data_size,
+    std::size_t buffer_size, std::size_t high_water_mark,
+    ExceptionHandler exception_handler)
+    : BufferedDataStore(std::forward<DS>(data_size), buffer_size,
+        high_water_mark, nullptr, std::move(exception_handler)) {}
+
+  template<typename D, typename E>
+  template<Initializes<D> DS>
+  BufferedDataStore<D, E>::BufferedDataStore(DS&& data_size,
+    std::size_t buffer_size, std::size_t high_water_mark,
+    std::unique_ptr<WriteAheadLog<IndexedValue>> log,
+    ExceptionHandler exception_handler)
     : m_data_store(std::forward<DS>(data_size)),
-      m_exception_handler(std::move(exception_handler)),
       m_buffer_size(buffer_size),
       m_buffer_count(0),
+      m_pending_count(0),
       m_data_store_buffer(std::make_shared<ReserveDataStore>()),
-      m_flushed_data_store(m_data_store_buffer) {}
+      m_flushed_data_store(m_data_store_buffer),
+      m_controller(m_mutex, m_open_state, high_water_mark, std::move(log),
+        std::move(exception_handler)) {
+    auto values = m_controller.recover(*m_data_store);
+    if(values.empty()) {
+      return;
+    }
+    auto lock = boost::lock_guard(m_mutex);
+    m_buffer_count += values.size();
+    m_pending_count += values.size();
+    m_data_store_buffer->store(values);
+    m_tasks.push([this] {
+      flush();
+    });
+  }
 
   template<typename D, typename E>
   BufferedDataStore<D, E>::~BufferedDataStore() {
     close();
   }
 
+  template<typename D, typename E>
+  BufferStatistics BufferedDataStore<D, E>::get_statistics() const {
+    auto lock = boost::lock_guard(m_mutex);
+    return m_controller.get_statistics();
+  }
+
   template<typename D, typename E>
   std::vector<typename BufferedDataStore<D, E>::SequencedValue>
       BufferedDataStore<D, E>::load(const Query& query) {
@@ -169,20 +270,38 @@ namespace Beam {
     return matches;
   }
 
+  template<typename D, typename E>
+  std::vector<std::vector<typename BufferedDataStore<D, E>::SequencedValue>>
+      BufferedDataStore<D, E>::load(std::span<const Query> queries) {
+    return load_concurrently(queries, [&] (const auto& query) {
+      return load(query);
+    });
+  }
+
   template<typename D, typename E>
   void BufferedDataStore<D, E>::store(const IndexedValue& value) {
-    auto lock = boost::lock_guard(m_mutex);
+    auto lock = boost::unique_lock(m_mutex);
+    m_controller.wait_for_capacity(lock);
+    auto position = m_controller.stage(std::span(&value, 1));
     ++m_buffer_count;
+    ++m_pending_count;
     m_data_store_buffer->store(value);
     test_flush();
+    lock.unlock();
+    m_controller.sync(position);
   }
 
   template<typename D, typename E>
   void BufferedDataStore<D, E>::store(const std::vector<IndexedValue>& values) {
-    auto lock = boost::lock_guard(m_mutex);
+    auto lock = boost::unique_lock(m_mutex);
+    m_controller.wait_for_capacity(lock);
+    auto position = m_controller.stage(values);
     m_buffer_count += values.size();
+    m_pending_count += values.size();
     m_data_store_buffer->store(values);
     test_flush();
+    lock.unlock();
+    m_controller.sync(position);
   }
 
   template<typename D, typename E>
@@ -190,6 +309,7 @@ namespace Beam {
     if(m_open_state.set_closing()) {
       return;
     }
+    m_controller.close();
     m_tasks.push([&] {
       flush();
     });
@@ -200,7 +320,7 @@ namespace Beam {
 
   template<typename D, typename E>
   void BufferedDataStore<D, E>::test_flush() {
-    if(m_buffer_count < m_buffer_size) {
+    if(m_buffer_count < m_buffer_size && !m_controller.is_full()) {
       return;
     }
     m_buffer_count = 0;
@@ -211,29 +331,26 @@ namespace Beam {
 
   template<typename D, typename E>
   void BufferedDataStore<D, E>::flush() {
-    auto data_size = std::make_shared<ReserveDataStore>();
-    {
-      auto lock = boost::lock_guard(m_mutex);
-      data_size.swap(m_data_store_buffer);
-    }
-    try {
-      m_data_store->store(data_size->load_all());
-    } catch(...) {
-      {
-        auto failed = data_size->load_all();
+    auto data_store = std::shared_ptr<ReserveDataStore>();
+    m_controller.flush(
+      [&] {
+        data_store = std::make_shared<ReserveDataStore>();
+        data_store.swap(m_data_store_buffer);
+        return std::exchange(m_pending_count, 0);
+      },
+      [&] {
+        m_data_store->store(data_store->load_all());
+      },
+      [&] (auto count) {
+        auto failed = data_store->load_all();
         auto lock = boost::lock_guard(m_mutex);
         m_data_store_buffer->store(failed);
-      }
-      if(m_exception_handler) {
-        m_exception_handler(std::current_exception());
-      } else {
-        std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
-      }
-    }
-    {
-      auto lock = boost::lock_guard(m_mutex);
-      m_flushed_data_store = m_data_store_buffer;
-    }
+        m_pending_count += count;
+      },
+      [&] {
+        auto lock = boost::lock_guard(m_mutex);
+        m_flushed_data_store = m_data_store_buffer;
+      });
   }
 }
 
@@ -0,0 +1,275 @@
+#ifndef BEAM_CACHE_BUDGET_HPP
+#define BEAM_CACHE_BUDGET_HPP
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace Beam {
+
+  /** Stores a snapshot of the activity of a CacheBudget. */
+  struct CacheStatistics {
+
+    /** The number of block lookups served from the cache. */
+    std::uint64_t m_hits = 0;
+
+    /** The number of block lookups that went to the underlying data store. */
+    std::uint64_t m_misses = 0;
+
+    /** The number of blocks evicted. */
+    std::uint64_t m_evictions = 0;
+
+    /** The number of blocks cached. */
+    std::size_t m_block_count = 0;
+
+    /** The estimated number of bytes cached. */
+    std::size_t m_size = 0;
+
+    /** The maximum number of bytes that may be cached. */
+    std::size_t m_capacity = 0;
+  };
+
+  /**
+   * Returns the ratio of hits to the total number of block lookups, or 0 if
+   * no lookup was counted.
+   * @param statistics The statistics to compute the ratio of.
+   */
+  inline double get_hit_ratio(const CacheStatistics& statistics) {
+    auto total = statistics.m_hits + statistics.m_misses;
+    if(total == 0) {
+      return 0;
+    }
+    return static_cast<double>(statistics.m_hits) / total;
+  }
+
+  inline std::ostream& operator <<(
+      std::ostream& out, const CacheStatistics& statistics) {
+    return out << "hits: " << statistics.m_hits << ", misses: " <<
+      statistics.m_misses << ", hit ratio: " << get_hit_ratio(statistics) <<
+      ", evictions: " << statistics.m_evictions << ", blocks: " <<
+      statistics.m_block_count << ", size: " << statistics.m_size << '/' <<
+      statistics.m_capacity;
+  }
+
+  /**
+   * Returns the number of bytes a cached value owns outside of its own object,
+   * such as the contents of a string or a vector. Caches that aren't given one
+   * only count the objects themselves, making their capacity a lower bound on
+   * the memory actually used.
+   * @tparam T The type of value to estimate.
+   */
+  template<typename T>
+  using HeapSizeEstimator = std::function<std::size_t (const T&)>;
+
+  /**
+   * Bounds the memory used by a set of cached blocks shared across indexes,
+   * evicting cold blocks using the CLOCK algorithm once the capacity is
+   * exceeded. Accessing a block only sets a flag, so cache hits never contend
+   * on the budget's lock.
+   */
+  class CacheBudget {
+    public:
+
+      /** The capacity of a budget that never evicts. */
+      static constexpr auto UNLIMITED = std::numeric_limits<std::size_t>::max();
+
+      /** A block of cached values whose memory is tracked by a budget. */
+      class Block {
+        public:
+          virtual ~Block() = default;
+
+          /** Marks this block as recently used. */
+          void touch();
+
+        protected:
+
+          /** Constructs an untracked Block. */
+          Block();
+
+          /**
+           * Removes this block from the cache that owns it, called with the
+           * budget's lock held. The block may still be referenced by a pending
+           * load after this call.
+           */
+          virtual void evict() = 0;
+
+        private:
+          friend class CacheBudget;
+          std::atomic_bool m_is_referenced;
+          bool m_is_tracked;
+          std::size_t m_index;
+          std::size_t m_size;
+
+          Block(const Block&) = delete;
+          Block& operator =(const Block&) = delete;
+      };
+
+      /** Constructs a CacheBudget with an UNLIMITED capacity. */
+      CacheBudget();
+
+      /**
+       * Constructs a CacheBudget.
+       * @param capacity The maximum number of bytes to cache.
+       */
+      explicit CacheBudget(std::size_t capacity);
+
+      /** Returns the maximum number of bytes that may be cached. */
+      std::size_t get_capacity() const;
+
+      /** Returns a snapshot of this budget's activity. */
+      CacheStatistics get_statistics() const;
+
+      /** Counts a block lookup served from the cache. */
+      void record_hit();
+
+      /** Counts a block lookup that went to the underlying data store. */
+      void record_miss();
+
+      /**
+       * Starts tracking a block, evicting cold blocks if the budget is
+       * exceeded.
+       * @param block The block to track.
+       * @param size The estimated number of bytes used by the block.
+       */
+      void add(Block& block, std::size_t size);
+
+      /**
+       * Updates the size of a tracked block, evicting cold blocks if the budget
+       * is exceeded. Has no effect if the block was evicted.
+       * @param block The block whose size changed.
+       * @param size The estimated number of bytes used by the block.
+       */
+      void resize(Block& block, std::size_t size);
+
+      /**
+       * Stops tracking a block that was removed from its cache. Has no effect
+       * if the block isn't tracked.
+       * @param block The block to stop tracking.
+       */
+      void remove(Block& block);
+
+    private:
+      mutable boost::mutex m_mutex;
+      std::size_t m_capacity;
+      std::size_t m_size;
+      std::vector<Block*> m_blocks;
+      std::size_t m_hand;
+      std::atomic_uint64_t m_hits;
+      std::atomic_uint64_t m_misses;
+      std::uint64_t m_evictions;
+
+      CacheBudget(const CacheBudget&) = delete;
+      CacheBudget& operator =(const CacheBudget&) = delete;
+      void untrack(Block& block);
+      void evict();
+  };
+
+  inline void CacheBudget::Block::touch() {
+    if(!m_is_referenced.load(std::memory_order_relaxed)) {
+      m_is_referenced.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  inline CacheBudget::Block::Block()
+    : m_is_referenced(true),
+      m_is_tracked(false),
+      m_index(0),
+      m_size(0) {}
+
+  inline CacheBudget::CacheBudget()
+    : CacheBudget(UNLIMITED) {}
+
+  inline CacheBudget::CacheBudget(std::size_t capacity)
+    : m_capacity(capacity),
+      m_size(0),
+      m_hand(0),
+      m_hits(0),
+      m_misses(0),
+      m_evictions(0) {}
+
+  inline std::size_t CacheBudget::get_capacity() const {
+    return m_capacity;
+  }
+
+  inline CacheStatistics CacheBudget::get_statistics() const {
+    auto statistics = CacheStatistics();
+    statistics.m_hits = m_hits.load(std::memory_order_relaxed);
+    statistics.m_misses = m_misses.load(std::memory_order_relaxed);
+    statistics.m_capacity = m_capacity;
+    auto lock = boost::lock_guard(m_mutex);
+    statistics.m_evictions = m_evictions;
+    statistics.m_block_count = m_blocks.size();
+    statistics.m_size = m_size;
+    return statistics;
+  }
+
+  inline void CacheBudget::record_hit() {
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline void CacheBudget::record_miss() {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline void CacheBudget::add(Block& block, std::size_t size) {
+    auto lock = boost::lock_guard(m_mutex);
+    if(block.m_is_tracked) {
+      return;
+    }
+    block.m_is_tracked = true;
+    block.m_index = m_blocks.size();
+    block.m_size = size;
+    m_size += size;
+    m_blocks.push_back(&block);
+    evict();
+  }
+
+  inline void CacheBudget::resize(Block& block, std::size_t size) {
+    auto lock = boost::lock_guard(m_mutex);
+    if(!block.m_is_tracked) {
+      return;
+    }
+    m_size = m_size - block.m_size + size;
+    block.m_size = size;
+    evict();
+  }
+
+  inline void CacheBudget::remove(Block& block) {
+    auto lock = boost::lock_guard(m_mutex);
+    if(!block.m_is_tracked) {
+      return;
+    }
+    untrack(block);
+  }
+
+  inline void CacheBudget::untrack(Block& block) {
+    auto last = m_blocks.back();
+    m_blocks[block.m_index] = last;
+    last->m_index = block.m_index;
+    m_blocks.pop_back();
+    m_size -= block.m_size;
+    block.m_is_tracked = false;
+  }
+
+  inline void CacheBudget::evict() {
+    while(m_size > m_capacity && !m_blocks.empty()) {
+      if(m_hand >= m_blocks.size()) {
+        m_hand = 0;
+      }
+      auto block = m_blocks[m_hand];
+      if(block->m_is_referenced.exchange(false, std::memory_order_relaxed)) {
+        ++m_hand;
+        continue;
+      }
+      untrack(*block);
+      ++m_evictions;
+      block->evict();
+    }
+  }
+}
+
+#endif
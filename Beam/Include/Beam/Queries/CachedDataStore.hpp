@@ -1,9 +1,12 @@
 #ifndef BEAM_CACHED_DATA_STORE_HPP
 #define BEAM_CACHED_DATA_STORE_HPP
+#include <span>
+#include <vector>
 #include "Beam/Collections/SynchronizedMap.hpp"
 #include "Beam/IO/OpenState.hpp"
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
+#include "Beam/Queries/BatchLoad.hpp"
 #include "Beam/Queries/CachedDataStoreEntry.hpp"
 
 namespace Beam {
@@ -47,9 +50,27 @@ namespace Beam {
       template<Initializes<D> DF>
       CachedDataStore(DF&& data_store, int block_size);
 
+      /**
+       * Constructs a CachedDataStore whose cached blocks are bounded across
+       * all indexes, evicting blocks not used since the CLOCK hand last
+       * passed them once the bound is exceeded.
+       * @param data_store Initializes the data store to cache.
+       * @param block_size The size of a single cache block.
+       * @param capacity The estimated number of bytes that may be cached.
+       * @param estimator Estimates the heap memory owned by each value.
+       */
+      template<Initializes<D> DF>
+      CachedDataStore(DF&& data_store, int block_size, std::size_t capacity,
+        HeapSizeEstimator<Value> estimator = {});
+
       ~CachedDataStore();
 
+      /** Returns the hit, miss and eviction counts of the cache. */
+      CacheStatistics get_statistics() const;
+
       std::vector<SequencedValue> load(const Query& query);
+      std::vector<std::vector<SequencedValue>> load(
+        std::span<const Query> queries);
       void store(const IndexedValue& value);
       void store(const std::vector<IndexedValue>& values);
       void close();
@@ -58,6 +79,8 @@ namespace Beam {
       using CachedDataStoreEntry = Beam::CachedDataStoreEntry<DataStore*, F>;
       local_ptr_t<D> m_data_store;
       int m_block_size;
+      HeapSizeEstimator<Value> m_estimator;
+      CacheBudget m_budget;
       SynchronizedUnorderedMap<Index, CachedDataStoreEntry> m_caches;
       OpenState m_open_state;
 
@@ -69,14 +92,28 @@ namespace Beam {
   template<typename D, typename F>
   template<Initializes<D> DF>
   CachedDataStore<D, F>::CachedDataStore(DF&& data_store, int block_size)
+    : CachedDataStore(
+        std::forward<DF>(data_store), block_size, CacheBudget::UNLIMITED) {}
+
+  template<typename D, typename F>
+  template<Initializes<D> DF>
+  CachedDataStore<D, F>::CachedDataStore(DF&& data_store, int block_size,
+    std::size_t capacity, HeapSizeEstimator<Value> estimator)
     : m_data_store(std::forward<DF>(data_store)),
-      m_block_size(block_size) {}
+      m_block_size(block_size),
+      m_estimator(std::move(estimator)),
+      m_budget(capacity) {}
 
   template<typename D, typename F>
   CachedDataStore<D, F>::~CachedDataStore() {
     close();
   }
 
+  template<typename D, typename F>
+  CacheStatistics CachedDataStore<D, F>::get_statistics() const {
+    return m_budget.get_statistics();
+  }
+
   template<typename D, typename F>
   std::vector<typename CachedDataStore<D, F>::SequencedValue>
       CachedDataStore<D, F>::load(const Query& query) {
@@ -84,6 +121,14 @@ namespace Beam {
     return cache.load(query);
   }
 
+  template<typename D, typename F>
+  std::vector<std::vector<typename CachedDataStore<D, F>::SequencedValue>>
+      CachedDataStore<D, F>::load(std::span<const Query> queries) {
+    return load_concurrently(queries, [&] (const auto& query) {
+      return load(query);
+    });
+  }
+
   template<typename D, typename F>
   void CachedDataStore<D, F>::store(const IndexedValue& value) {
     m_data_store->store(value);
@@ -110,7 +155,8 @@ namespace Beam {
       CachedDataStore<D, F>::load_cache(const Index& index) {
     return m_caches.test_and_set(index, [&] (auto& caches) {
       caches.emplace(std::piecewise_construct, std::forward_as_tuple(index),
-        std::forward_as_tuple(&*m_data_store, index, m_block_size));
+        std::forward_as_tuple(
+          &*m_data_store, index, m_block_size, Ref(m_budget), m_estimator));
     });
   }
 }
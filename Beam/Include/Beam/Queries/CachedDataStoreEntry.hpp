@@ -1,8 +1,12 @@
 #ifndef BEAM_CACHED_DATA_STORE_ENTRY_HPP
 #define BEAM_CACHED_DATA_STORE_ENTRY_HPP
+#include <atomic>
+#include <boost/range/adaptor/reversed.hpp>
 #include "Beam/Collections/SynchronizedList.hpp"
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
+#include "Beam/Pointers/Ref.hpp"
+#include "Beam/Queries/CacheBudget.hpp"
 #include "Beam/Queries/LocalDataStoreEntry.hpp"
 #include "Beam/Queries/Sequence.hpp"
 #include "Beam/Threading/CallOnce.hpp"
@@ -50,27 +54,62 @@ namespace Beam {
       template<Initializes<D> DF>
       CachedDataStoreEntry(DF&& data_store, const Index& index, int block_size);
 
+      /**
+       * Constructs a CachedDataStoreEntry whose blocks are bounded by a
+       * CacheBudget.
+       * @param data_store Initializes the data store to cache.
+       * @param index The Index to cache.
+       * @param block_size The size of a single cache block.
+       * @param budget The CacheBudget tracking the cached blocks.
+       * @param estimator Estimates the heap memory owned by each value.
+       */
+      template<Initializes<D> DF>
+      CachedDataStoreEntry(DF&& data_store, const Index& index, int block_size,
+        Ref<CacheBudget> budget, HeapSizeEstimator<Value> estimator = {});
+
+      ~CachedDataStoreEntry();
+
       std::vector<SequencedValue> load(const Query& query);
+
+      /**
+       * Adds a value to its block if the block is cached. A block that isn't
+       * cached is left to be loaded by the next query that reads it, since
+       * the value is already in the underlying data store.
+       * @param value The value to store.
+       */
       void store(const IndexedValue& value);
 
     private:
       using LocalDataStoreEntry = Beam::LocalDataStoreEntry<Query, Value, T>;
-      struct DataStoreEntry {
+      struct DataStoreEntry : CacheBudget::Block {
+        CachedDataStoreEntry* m_owner;
         Sequence m_sequence;
         LocalDataStoreEntry m_data_store;
+        std::atomic_size_t m_heap_size;
         CallOnce<Mutex> m_initializer;
 
-        DataStoreEntry(Sequence sequence);
+        DataStoreEntry(CachedDataStoreEntry& owner, Sequence sequence);
+        std::size_t get_memory_usage() const;
+        void evict() override;
       };
       local_ptr_t<D> m_data_store;
       Index m_index;
       int m_block_size;
-      SynchronizedVector<std::unique_ptr<DataStoreEntry>> m_data_stores;
+      CacheBudget* m_budget;
+      HeapSizeEstimator<Value> m_estimator;
+      SynchronizedVector<std::shared_ptr<DataStoreEntry>> m_data_stores;
 
+      CachedDataStoreEntry(const CachedDataStoreEntry&) = delete;
+      CachedDataStoreEntry& operator =(const CachedDataStoreEntry&) = delete;
       Sequence normalize(Sequence sequence) const;
       Range to_sequence(const Index& index, const Range& range);
-      boost::optional<LocalDataStoreEntry&> find_data_store(Sequence sequence);
-      LocalDataStoreEntry& load_data_store(Sequence sequence);
+      std::shared_ptr<DataStoreEntry> find_data_store(Sequence sequence);
+      std::shared_ptr<DataStoreEntry> load_data_store(Sequence sequence);
+      void initialize(DataStoreEntry& block);
+      void add_heap_size(DataStoreEntry& block, const Value& value);
+      void remove_heap_size(DataStoreEntry& block, const Value& value);
+      void record_hit();
+      void record_miss();
       std::vector<SequencedValue> load_head(
         const Query& query, Sequence start, Sequence end);
       std::vector<SequencedValue> load_tail(
@@ -78,8 +117,32 @@ namespace Beam {
   };
 
   template<typename D, typename T>
-  CachedDataStoreEntry<D, T>::DataStoreEntry::DataStoreEntry(Sequence sequence)
-    : m_sequence(sequence) {}
+  CachedDataStoreEntry<D, T>::DataStoreEntry::DataStoreEntry(
+    CachedDataStoreEntry& owner, Sequence sequence)
+    : m_owner(&owner),
+      m_sequence(sequence),
+      m_heap_size(0) {}
+
+  template<typename D, typename T>
+  std::size_t CachedDataStoreEntry<D, T>::DataStoreEntry::get_memory_usage()
+      const {
+    return sizeof(DataStoreEntry) +
+      m_data_store.get_size() * sizeof(SequencedValue) +
+      m_heap_size.load(std::memory_order_relaxed);
+  }
+
+  template<typename D, typename T>
+  void CachedDataStoreEntry<D, T>::DataStoreEntry::evict() {
+    m_owner->m_data_stores.with([&] (auto& data_stores) {
+      auto i = std::find_if(data_stores.begin(), data_stores.end(),
+        [&] (const auto& data_store) {
+          return data_store.get() == this;
+        });
+      if(i != data_stores.end()) {
+        data_stores.erase(i);
+      }
+    });
+  }
 
   template<typename D, typename T>
   template<Initializes<D> DF>
@@ -87,7 +150,29 @@ namespace Beam {
     DF&& data_store, const Index& index, int block_size)
     : m_data_store(std::forward<DF>(data_store)),
       m_index(index),
-      m_block_size(block_size) {}
+      m_block_size(block_size),
+      m_budget(nullptr) {}
+
+  template<typename D, typename T>
+  template<Initializes<D> DF>
+  CachedDataStoreEntry<D, T>::CachedDataStoreEntry(DF&& data_store,
+    const Index& index, int block_size, Ref<CacheBudget> budget,
+    HeapSizeEstimator<Value> estimator)
+    : m_data_store(std::forward<DF>(data_store)),
+      m_index(index),
+      m_block_size(block_size),
+      m_budget(budget.get()),
+      m_estimator(std::move(estimator)) {}
+
+  template<typename D, typename T>
+  CachedDataStoreEntry<D, T>::~CachedDataStoreEntry() {
+    if(!m_budget) {
+      return;
+    }
+    for(auto& data_store : m_data_stores.load()) {
+      m_budget->remove(*data_store);
+    }
+  }
 
   template<typename D, typename T>
   std::vector<typename CachedDataStoreEntry<D, T>::SequencedValue>
@@ -109,8 +194,19 @@ namespace Beam {
 
   template<typename D, typename T>
   void CachedDataStoreEntry<D, T>::store(const IndexedValue& value) {
-    auto& cached_data_store = load_data_store(normalize(value.get_sequence()));
-    cached_data_store.store(value);
+    auto sequence = normalize(value.get_sequence());
+    auto block = find_data_store(sequence);
+    if(!block) {
+      return;
+    }
+    initialize(*block);
+    block->m_data_store.store(value, [&] (const auto& replaced) {
+      remove_heap_size(*block, *replaced);
+    });
+    add_heap_size(*block, value->get_value());
+    if(m_budget) {
+      m_budget->resize(*block, block->get_memory_usage());
+    }
   }
 
   template<typename D, typename T>
@@ -155,10 +251,10 @@ namespace Beam {
   }
 
   template<typename D, typename T>
-  boost::optional<typename CachedDataStoreEntry<D, T>::LocalDataStoreEntry&>
+  std::shared_ptr<typename CachedDataStoreEntry<D, T>::DataStoreEntry>
       CachedDataStoreEntry<D, T>::find_data_store(Sequence sequence) {
     auto data_store = m_data_stores.with(
-      [&] (auto& data_stores) -> DataStoreEntry* {
+      [&] (auto& data_stores) -> std::shared_ptr<DataStoreEntry> {
         auto i = std::lower_bound(data_stores.begin(), data_stores.end(),
           sequence, [] (const auto& lhs, auto rhs) {
             return lhs->m_sequence < rhs;
@@ -166,39 +262,83 @@ namespace Beam {
         if(i == data_stores.end() || (*i)->m_sequence != sequence) {
           return nullptr;
         }
-        return i->get();
+        return *i;
       });
     if(data_store) {
-      return data_store->m_data_store;
+      data_store->touch();
     }
-    return boost::none;
+    return data_store;
   }
 
   template<typename D, typename T>
-  typename CachedDataStoreEntry<D, T>::LocalDataStoreEntry&
+  std::shared_ptr<typename CachedDataStoreEntry<D, T>::DataStoreEntry>
       CachedDataStoreEntry<D, T>::load_data_store(Sequence sequence) {
     auto data_store = m_data_stores.with(
-      [&] (auto& data_stores) -> DataStoreEntry* {
+      [&] (auto& data_stores) -> std::shared_ptr<DataStoreEntry> {
         auto i = std::lower_bound(data_stores.begin(), data_stores.end(),
           sequence, [] (const auto& lhs, auto rhs) {
             return lhs->m_sequence < rhs;
           });
         if(i == data_stores.end() || (*i)->m_sequence != sequence) {
-          auto entry = std::make_unique<DataStoreEntry>(sequence);
+          auto entry = std::make_shared<DataStoreEntry>(*this, sequence);
           i = data_stores.insert(i, std::move(entry));
         }
-        return i->get();
+        return *i;
       });
-    data_store->m_initializer.call([&] {
+    data_store->touch();
+    initialize(*data_store);
+    return data_store;
+  }
+
+  template<typename D, typename T>
+  void CachedDataStoreEntry<D, T>::initialize(DataStoreEntry& block) {
+    auto is_initialized = block.m_initializer.call([&] {
       auto query = Query();
       query.set_index(m_index);
-      query.set_range(
-        sequence, Sequence(sequence.get_ordinal() + m_block_size - 1));
+      query.set_range(block.m_sequence,
+        Sequence(block.m_sequence.get_ordinal() + m_block_size - 1));
       query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
       auto matches = m_data_store->load(query);
-      data_store->m_data_store.store(std::move(matches));
+      for(auto& match : matches) {
+        add_heap_size(block, *match);
+      }
+      block.m_data_store.store(std::move(matches));
     });
-    return data_store->m_data_store;
+    if(is_initialized && m_budget) {
+      m_budget->add(block, block.get_memory_usage());
+    }
+  }
+
+  template<typename D, typename T>
+  void CachedDataStoreEntry<D, T>::add_heap_size(
+      DataStoreEntry& block, const Value& value) {
+    if(m_estimator) {
+      block.m_heap_size.fetch_add(
+        m_estimator(value), std::memory_order_relaxed);
+    }
+  }
+
+  template<typename D, typename T>
+  void CachedDataStoreEntry<D, T>::remove_heap_size(
+      DataStoreEntry& block, const Value& value) {
+    if(m_estimator) {
+      block.m_heap_size.fetch_sub(
+        m_estimator(value), std::memory_order_relaxed);
+    }
+  }
+
+  template<typename D, typename T>
+  void CachedDataStoreEntry<D, T>::record_hit() {
+    if(m_budget) {
+      m_budget->record_hit();
+    }
+  }
+
+  template<typename D, typename T>
+  void CachedDataStoreEntry<D, T>::record_miss() {
+    if(m_budget) {
+      m_budget->record_miss();
+    }
   }
 
   template<typename D, typename T>
@@ -217,7 +357,8 @@ namespace Beam {
       }
       subset_query.set_range(subset_start, query.get_range().get_end());
       if(auto block_data_store = find_data_store(Sequence(ordinal))) {
-        auto subset_matches = block_data_store->load(subset_query);
+        record_hit();
+        auto subset_matches = block_data_store->m_data_store.load(subset_query);
         remaining_limit -= static_cast<int>(subset_matches.size());
         if(matches.empty()) {
           matches = std::move(subset_matches);
@@ -231,6 +372,7 @@ namespace Beam {
         }
         subset_start = Sequence(ordinal + m_block_size);
       } else {
+        record_miss();
         auto subset_matches = m_data_store->load(subset_query);
         load_data_store(Sequence(ordinal));
         if(matches.empty()) {
@@ -263,13 +405,15 @@ namespace Beam {
       subset_query.set_range(query.get_range().get_start(), subset_end);
       auto block_data_store = find_data_store(Sequence(ordinal));
       if(block_data_store) {
-        partitions.push_back(block_data_store->load(subset_query));
+        record_hit();
+        partitions.push_back(block_data_store->m_data_store.load(subset_query));
         remaining_limit -= static_cast<int>(partitions.back().size());
         if(remaining_limit <= 0 || ordinal == start.get_ordinal()) {
           break;
         }
         subset_end = decrement(Sequence(ordinal));
       } else {
+        record_miss();
         partitions.push_back(m_data_store->load(subset_query));
         load_data_store(Sequence(ordinal));
         break;
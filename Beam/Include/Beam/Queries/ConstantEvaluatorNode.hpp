@@ -1,5 +1,6 @@
 #ifndef BEAM_CONSTANT_EVALUATOR_NODE_HPP
 #define BEAM_CONSTANT_EVALUATOR_NODE_HPP
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include "Beam/Queries/ConstantExpression.hpp"
@@ -22,7 +23,12 @@ namespace Beam {
        */
       explicit ConstantEvaluatorNode(Result constant);
 
+      /** Returns the constant evaluated to. */
+      const Result& get_constant() const;
+
       Result eval() override;
+      bool eval_batch(
+        const EvaluatorBatch& batch, std::span<Result> results) override;
 
     private:
       Result m_constant;
@@ -46,10 +52,27 @@ namespace Beam {
   ConstantEvaluatorNode<T>::ConstantEvaluatorNode(Result constant)
     : m_constant(std::move(constant)) {}
 
+  template<typename T>
+  const typename ConstantEvaluatorNode<T>::Result&
+      ConstantEvaluatorNode<T>::get_constant() const {
+    return m_constant;
+  }
+
   template<typename T>
   typename ConstantEvaluatorNode<T>::Result ConstantEvaluatorNode<T>::eval() {
     return m_constant;
   }
+
+  template<typename T>
+  bool ConstantEvaluatorNode<T>::eval_batch(
+      const EvaluatorBatch& batch, std::span<Result> results) {
+    if constexpr(std::is_copy_assignable_v<Result>) {
+      std::fill(results.begin(), results.end(), m_constant);
+      return true;
+    } else {
+      return false;
+    }
+  }
 }
 
 #endif
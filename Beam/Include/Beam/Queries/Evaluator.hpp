@@ -1,7 +1,13 @@
 #ifndef BEAM_QUERY_EVALUATOR_HPP
 #define BEAM_QUERY_EVALUATOR_HPP
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
 #include <typeindex>
 #include <vector>
 #include <boost/optional/optional.hpp>
@@ -47,6 +53,20 @@ namespace Beam {
       template<typename Result, typename P1, typename P2>
       Result eval(const P1& p1, const P2& p2);
 
+      /**
+       * Evaluates a boolean Expression once for every value in a range. Where
+       * the Expression allows it, values are evaluated many at a time rather
+       * than one at a time.
+       * @param values The values to pass as the parameter.
+       * @param selection Stores the result of each evaluation.
+       * @param projection Maps each value to a reference to the parameter to
+       *        pass.
+       */
+      template<std::ranges::random_access_range R,
+        typename P = std::identity>
+      void select(const R& values, std::span<bool> selection,
+        P projection = {});
+
     private:
       struct ParameterEntry {
         const void* m_value = nullptr;
@@ -54,6 +74,8 @@ namespace Beam {
       };
       std::unique_ptr<BaseEvaluatorNode> m_evaluator;
       std::array<ParameterEntry, MAX_EVALUATOR_PARAMETERS> m_parameters;
+      bool m_is_batchable;
+      std::vector<const void*> m_batch;
 
       Evaluator(const Evaluator&) = delete;
       Evaluator& operator =(const Evaluator&) = delete;
@@ -95,6 +117,11 @@ namespace Beam {
       node->set_parameter(&entry.m_value);
       entry.m_type = node->get_type();
     }
+    m_is_batchable = m_evaluator->get_type() == typeid(bool) &&
+      std::all_of(m_parameters.begin() + 1, m_parameters.end(),
+        [] (const auto& entry) {
+          return !entry.m_type;
+        });
   }
 
   inline void Evaluator::check_parameter(
@@ -127,6 +154,39 @@ namespace Beam {
     return this->eval<Result>();
   }
 
+  template<std::ranges::random_access_range R, typename P>
+  void Evaluator::select(
+      const R& values, std::span<bool> selection, P projection) {
+    using Reference =
+      std::invoke_result_t<P&, std::ranges::range_reference_t<const R>>;
+    static_assert(std::is_lvalue_reference_v<Reference>,
+      "The projection must return a reference to the parameter.");
+    const auto BATCH_SIZE = std::size_t(256);
+    check_parameter(0, typeid(std::remove_cvref_t<Reference>));
+    auto& evaluator = *static_cast<EvaluatorNode<bool>*>(m_evaluator.get());
+    auto size = static_cast<std::size_t>(std::ranges::size(values));
+    auto first = std::ranges::begin(values);
+    for(auto offset = std::size_t(0); offset < size; offset += BATCH_SIZE) {
+      auto count = std::min(BATCH_SIZE, size - offset);
+      auto results = selection.subspan(offset, count);
+      if(m_is_batchable) {
+        m_batch.resize(count);
+        for(auto i = std::size_t(0); i != count; ++i) {
+          m_batch[i] = &std::invoke(projection, first[offset + i]);
+        }
+        if(evaluator.eval_batch(
+            EvaluatorBatch(m_batch.data(), count, 1), results)) {
+          continue;
+        }
+        m_is_batchable = false;
+      }
+      for(auto i = std::size_t(0); i != count; ++i) {
+        results[i] =
+          eval<bool>(std::invoke(projection, first[offset + i]));
+      }
+    }
+  }
+
   template<typename T>
   typename ReduceEvaluatorNode<T>::Result ReduceEvaluatorNode<T>::eval() {
     m_value = m_reducer->template eval<Result>(m_value, m_series->eval());
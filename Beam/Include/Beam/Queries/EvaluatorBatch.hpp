@@ -0,0 +1,69 @@
+#ifndef BEAM_EVALUATOR_BATCH_HPP
+#define BEAM_EVALUATOR_BATCH_HPP
+#include <cstddef>
+
+namespace Beam {
+
+  /**
+   * Stores the parameters passed to a batch of evaluations. The address of
+   * every parameter is stored row by row, one row per evaluation.
+   */
+  class EvaluatorBatch {
+    public:
+
+      /**
+       * Constructs an EvaluatorBatch.
+       * @param parameters The address of each parameter, row by row.
+       * @param size The number of evaluations.
+       * @param parameter_count The number of parameters in each row.
+       */
+      EvaluatorBatch(const void* const* parameters, std::size_t size,
+        std::size_t parameter_count) noexcept;
+
+      /** Returns the number of evaluations. */
+      std::size_t get_size() const;
+
+      /** Returns the number of parameters passed to each evaluation. */
+      std::size_t get_parameter_count() const;
+
+      /** Returns the addresses of the parameters of an evaluation. */
+      const void* const* get_row(std::size_t row) const;
+
+      /**
+       * Returns the address of a parameter.
+       * @param row The evaluation the parameter is passed to.
+       * @param index The index of the parameter.
+       */
+      const void* get_parameter(std::size_t row, int index) const;
+
+    private:
+      const void* const* m_parameters;
+      std::size_t m_size;
+      std::size_t m_parameter_count;
+  };
+
+  inline EvaluatorBatch::EvaluatorBatch(const void* const* parameters,
+    std::size_t size, std::size_t parameter_count) noexcept
+    : m_parameters(parameters),
+      m_size(size),
+      m_parameter_count(parameter_count) {}
+
+  inline std::size_t EvaluatorBatch::get_size() const {
+    return m_size;
+  }
+
+  inline std::size_t EvaluatorBatch::get_parameter_count() const {
+    return m_parameter_count;
+  }
+
+  inline const void* const* EvaluatorBatch::get_row(std::size_t row) const {
+    return m_parameters + row * m_parameter_count;
+  }
+
+  inline const void* EvaluatorBatch::get_parameter(
+      std::size_t row, int index) const {
+    return m_parameters[row * m_parameter_count + index];
+  }
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef BEAM_EVALUATOR_NODE_HPP
 #define BEAM_EVALUATOR_NODE_HPP
+#include <span>
 #include <typeindex>
+#include "Beam/Queries/EvaluatorBatch.hpp"
 
 namespace Beam {
 
@@ -27,9 +29,26 @@ namespace Beam {
       /** Evaluates the expression. */
       virtual Result eval() = 0;
 
+      /**
+       * Evaluates the expression over a batch of parameters.
+       * @param batch The parameters passed to each evaluation.
+       * @param results Stores the result of each evaluation.
+       * @return <code>false</code> iff this node can only be evaluated one
+       *         parameter at a time, in which case the <i>results</i> are
+       *         unspecified.
+       */
+      virtual bool eval_batch(
+        const EvaluatorBatch& batch, std::span<Result> results);
+
       std::type_index get_type() const override;
   };
 
+  template<typename R>
+  bool EvaluatorNode<R>::eval_batch(
+      const EvaluatorBatch& batch, std::span<Result> results) {
+    return false;
+  }
+
   template<typename R>
   std::type_index EvaluatorNode<R>::get_type() const {
     return std::type_index(typeid(Result));
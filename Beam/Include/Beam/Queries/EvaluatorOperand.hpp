@@ -0,0 +1,196 @@
+#ifndef BEAM_EVALUATOR_OPERAND_HPP
+#define BEAM_EVALUATOR_OPERAND_HPP
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "Beam/Queries/ConstantEvaluatorNode.hpp"
+#include "Beam/Queries/EvaluatorNode.hpp"
+#include "Beam/Queries/ParameterEvaluatorNode.hpp"
+
+namespace Beam {
+
+  /**
+   * Stores an operand of an EvaluatorNode. Constants and parameters, which
+   * make up the leaves of most filters, are read directly by the parent node
+   * instead of through a virtual call, and only the remaining operands are
+   * evaluated by walking the tree.
+   * @tparam T The type the operand evaluates to.
+   */
+  template<typename T>
+  class EvaluatorOperand {
+    public:
+
+      /** The type the operand evaluates to. */
+      using Result = T;
+
+      /**
+       * Constructs an EvaluatorOperand.
+       * @param node The EvaluatorNode producing the operand.
+       */
+      EvaluatorOperand(std::unique_ptr<EvaluatorNode<Result>> node);
+
+      /** Returns <code>true</code> iff the operand is a constant. */
+      bool is_constant() const;
+
+      /**
+       * Returns the address of the operand's value if it is a constant or a
+       * parameter, otherwise <code>nullptr</code>.
+       */
+      const Result* get_address() const;
+
+      /** Evaluates the operand. */
+      Result eval();
+
+      /**
+       * Returns the index of the parameter the operand reads, or -1 if it
+       * isn't a parameter.
+       */
+      int get_parameter_index() const;
+
+      /**
+       * Evaluates the operand over a batch of parameters, storing the results
+       * in this operand.
+       * @param batch The parameters passed to each evaluation.
+       * @return <code>false</code> iff the operand can only be evaluated one
+       *         parameter at a time.
+       */
+      bool load(const EvaluatorBatch& batch);
+
+      /**
+       * Returns the values of the most recently loaded batch, or a pointer to
+       * the single value if the operand is a constant.
+       */
+      const Result* get_values() const;
+
+      /**
+       * Returns the value of an evaluation in the most recently loaded batch.
+       * @param row The evaluation whose value is returned.
+       */
+      const Result& get(std::size_t row) const;
+
+    private:
+      enum class Kind : std::uint8_t {
+        CONSTANT,
+        PARAMETER,
+        NODE
+      };
+      Kind m_kind;
+      const Result* m_constant;
+      ParameterEvaluatorNode<Result>* m_parameter;
+      std::unique_ptr<EvaluatorNode<Result>> m_node;
+      std::unique_ptr<Result[]> m_values;
+      std::size_t m_capacity;
+  };
+
+  /**
+   * Replaces an EvaluatorNode whose operands are all constants with a
+   * ConstantEvaluatorNode storing its value.
+   * @param node The EvaluatorNode to fold.
+   * @return A ConstantEvaluatorNode if the <i>node</i> is constant, otherwise
+   *         the <i>node</i> itself.
+   */
+  template<typename N> requires requires(const N& node) {
+    { node.is_constant() } -> std::convertible_to<bool>;
+  }
+  std::unique_ptr<EvaluatorNode<typename N::Result>> fold_constant(
+      std::unique_ptr<N> node) {
+    if(node->is_constant()) {
+      return std::make_unique<ConstantEvaluatorNode<typename N::Result>>(
+        node->eval());
+    }
+    return node;
+  }
+
+  template<typename T>
+  EvaluatorOperand<T>::EvaluatorOperand(
+      std::unique_ptr<EvaluatorNode<Result>> node)
+      : m_kind(Kind::NODE),
+        m_constant(nullptr),
+        m_parameter(nullptr),
+        m_node(std::move(node)),
+        m_capacity(0) {
+    if(auto constant =
+        dynamic_cast<ConstantEvaluatorNode<Result>*>(m_node.get())) {
+      m_kind = Kind::CONSTANT;
+      m_constant = &constant->get_constant();
+    } else if(auto parameter =
+        dynamic_cast<ParameterEvaluatorNode<Result>*>(m_node.get())) {
+      m_kind = Kind::PARAMETER;
+      m_parameter = parameter;
+    }
+  }
+
+  template<typename T>
+  bool EvaluatorOperand<T>::is_constant() const {
+    return m_kind == Kind::CONSTANT;
+  }
+
+  template<typename T>
+  inline const typename EvaluatorOperand<T>::Result*
+      EvaluatorOperand<T>::get_address() const {
+    if(m_kind == Kind::PARAMETER) {
+      return &m_parameter->get_value();
+    } else if(m_kind == Kind::CONSTANT) {
+      return m_constant;
+    }
+    return nullptr;
+  }
+
+  template<typename T>
+  inline typename EvaluatorOperand<T>::Result EvaluatorOperand<T>::eval() {
+    if(m_kind == Kind::PARAMETER) {
+      return m_parameter->get_value();
+    } else if(m_kind == Kind::CONSTANT) {
+      return *m_constant;
+    }
+    return m_node->eval();
+  }
+
+  template<typename T>
+  int EvaluatorOperand<T>::get_parameter_index() const {
+    if(m_kind == Kind::PARAMETER) {
+      return m_parameter->get_index();
+    }
+    return -1;
+  }
+
+  template<typename T>
+  bool EvaluatorOperand<T>::load(const EvaluatorBatch& batch) {
+    if(m_kind == Kind::CONSTANT) {
+      return true;
+    }
+    if constexpr(std::is_default_constructible_v<Result>) {
+      if(m_capacity < batch.get_size()) {
+        m_values = std::make_unique<Result[]>(batch.get_size());
+        m_capacity = batch.get_size();
+      }
+      return m_node->eval_batch(
+        batch, std::span(m_values.get(), batch.get_size()));
+    } else {
+      return false;
+    }
+  }
+
+  template<typename T>
+  const typename EvaluatorOperand<T>::Result*
+      EvaluatorOperand<T>::get_values() const {
+    if(m_kind == Kind::CONSTANT) {
+      return m_constant;
+    }
+    return m_values.get();
+  }
+
+  template<typename T>
+  const typename EvaluatorOperand<T>::Result&
+      EvaluatorOperand<T>::get(std::size_t row) const {
+    if(m_kind == Kind::CONSTANT) {
+      return *m_constant;
+    }
+    return m_values[row];
+  }
+}
+
+#endif
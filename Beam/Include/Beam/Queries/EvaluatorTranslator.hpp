@@ -157,6 +157,9 @@ namespace Beam {
       const VariableEntry& find_variable(const std::string& name) const;
       template<typename Operation, int COUNT>
       void translate(const FunctionExpression& expression);
+      template<typename Node>
+      void translate_logical(
+        const Expression& left, const Expression& right, bool absorbing_value);
   };
 
   template<typename QueryTypes>
@@ -216,10 +219,8 @@ namespace Beam {
 
   template<typename QueryTypes>
   void EvaluatorTranslator<QueryTypes>::visit(const AndExpression& expression) {
-    auto left = translate_operand<bool>(expression.get_left());
-    auto right = translate_operand<bool>(expression.get_right());
-    set_evaluator(
-      std::make_unique<AndEvaluatorNode>(std::move(left), std::move(right)));
+    translate_logical<AndEvaluatorNode>(
+      expression.get_left(), expression.get_right(), false);
   }
 
   template<typename QueryTypes>
@@ -293,15 +294,14 @@ namespace Beam {
   template<typename QueryTypes>
   void EvaluatorTranslator<QueryTypes>::visit(const NotExpression& expression) {
     auto operand = translate_operand<bool>(expression.get_operand());
-    set_evaluator(std::make_unique<NotEvaluatorNode>(std::move(operand)));
+    set_evaluator(
+      fold_constant(std::make_unique<NotEvaluatorNode>(std::move(operand))));
   }
 
   template<typename QueryTypes>
   void EvaluatorTranslator<QueryTypes>::visit(const OrExpression& expression) {
-    auto left = translate_operand<bool>(expression.get_left());
-    auto right = translate_operand<bool>(expression.get_right());
-    set_evaluator(
-      std::make_unique<OrEvaluatorNode>(std::move(left), std::move(right)));
+    translate_logical<OrEvaluatorNode>(
+      expression.get_left(), expression.get_right(), true);
   }
 
   template<typename QueryTypes>
@@ -386,6 +386,42 @@ namespace Beam {
     return static_pointer_cast<EvaluatorNode<T>>(translate_operand(expression));
   }
 
+  template<typename QueryTypes>
+  template<typename Node>
+  void EvaluatorTranslator<QueryTypes>::translate_logical(
+      const Expression& left, const Expression& right, bool absorbing_value) {
+    auto parameter_count = m_parameters.size();
+    auto left_evaluator = translate_operand<bool>(left);
+    auto has_left_parameters = m_parameters.size() != parameter_count;
+    parameter_count = m_parameters.size();
+    auto right_evaluator = translate_operand<bool>(right);
+    auto has_right_parameters = m_parameters.size() != parameter_count;
+
+    // An operand holding parameters is never dropped, since the Evaluator
+    // binds and type checks every parameter that was translated.
+    if(auto constant = dynamic_cast<ConstantEvaluatorNode<bool>*>(
+        left_evaluator.get())) {
+      if(constant->get_constant() != absorbing_value) {
+        set_evaluator(std::move(right_evaluator));
+        return;
+      } else if(!has_right_parameters) {
+        set_evaluator(std::move(left_evaluator));
+        return;
+      }
+    } else if(auto constant = dynamic_cast<ConstantEvaluatorNode<bool>*>(
+        right_evaluator.get())) {
+      if(constant->get_constant() != absorbing_value) {
+        set_evaluator(std::move(left_evaluator));
+        return;
+      } else if(!has_left_parameters) {
+        set_evaluator(std::move(right_evaluator));
+        return;
+      }
+    }
+    set_evaluator(std::make_unique<Node>(
+      std::move(left_evaluator), std::move(right_evaluator)));
+  }
+
   template<typename QueryTypes>
   template<typename Translator, int COUNT>
   void EvaluatorTranslator<QueryTypes>::translate(
@@ -0,0 +1,230 @@
+#ifndef BEAM_EXPRESSION_SIGNATURE_HPP
+#define BEAM_EXPRESSION_SIGNATURE_HPP
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <typeindex>
+#include <vector>
+#include <boost/functional/hash.hpp>
+#include "Beam/Queries/Expression.hpp"
+#include "Beam/Queries/TraversalExpressionVisitor.hpp"
+
+namespace Beam {
+
+  /**
+   * Identifies an Expression by its structure, so that two Expressions built
+   * separately, such as the filters of two identical queries, compare equal
+   * and hash to the same value.
+   */
+  class ExpressionSignature {
+    public:
+
+      /**
+       * Constructs an ExpressionSignature.
+       * @param expression The Expression to identify.
+       */
+      explicit ExpressionSignature(Expression expression);
+
+      /** Returns the Expression identified. */
+      const Expression& get_expression() const;
+
+      /**
+       * Returns <code>true</code> iff the Expression is made up only of
+       * expressions whose structure is known, otherwise the signature is only
+       * equal to itself.
+       */
+      bool is_comparable() const;
+
+      /** Returns the hash of the Expression's structure. */
+      std::size_t get_hash() const;
+
+      bool operator ==(const ExpressionSignature& rhs) const;
+
+    private:
+      enum class Kind : std::uint8_t {
+        AND,
+        CONSTANT,
+        FUNCTION,
+        GLOBAL_VARIABLE_DECLARATION,
+        MEMBER_ACCESS,
+        NOT,
+        OR,
+        PARAMETER,
+        REDUCE,
+        SET_VARIABLE,
+        VARIABLE
+      };
+      struct Node {
+        Kind m_kind;
+        std::type_index m_type;
+        const std::string* m_name;
+        int m_index;
+        const Value* m_value;
+
+        bool operator ==(const Node& rhs) const;
+      };
+      struct Builder : TraversalExpressionVisitor {
+        ExpressionSignature* m_signature;
+
+        void add(const VirtualExpression& expression, Kind kind,
+          const std::string* name = nullptr, int index = 0,
+          const Value* value = nullptr);
+        void visit(const AndExpression& expression) override;
+        void visit(const ConstantExpression& expression) override;
+        void visit(const FunctionExpression& expression) override;
+        void visit(
+          const GlobalVariableDeclarationExpression& expression) override;
+        void visit(const MemberAccessExpression& expression) override;
+        void visit(const NotExpression& expression) override;
+        void visit(const OrExpression& expression) override;
+        void visit(const ParameterExpression& expression) override;
+        void visit(const ReduceExpression& expression) override;
+        void visit(const SetVariableExpression& expression) override;
+        void visit(const VariableExpression& expression) override;
+        void visit(const VirtualExpression& expression) override;
+      };
+      Expression m_expression;
+      std::vector<Node> m_nodes;
+      std::size_t m_hash;
+      bool m_is_comparable;
+  };
+
+  inline ExpressionSignature::ExpressionSignature(Expression expression)
+      : m_expression(std::move(expression)),
+        m_hash(0),
+        m_is_comparable(true) {
+    auto builder = Builder();
+    builder.m_signature = this;
+    m_expression.apply(builder);
+  }
+
+  inline const Expression& ExpressionSignature::get_expression() const {
+    return m_expression;
+  }
+
+  inline bool ExpressionSignature::is_comparable() const {
+    return m_is_comparable;
+  }
+
+  inline std::size_t ExpressionSignature::get_hash() const {
+    return m_hash;
+  }
+
+  inline bool ExpressionSignature::operator ==(
+      const ExpressionSignature& rhs) const {
+    if(!m_is_comparable || !rhs.m_is_comparable) {
+      return this == &rhs;
+    }
+    return m_hash == rhs.m_hash && m_nodes == rhs.m_nodes;
+  }
+
+  inline bool ExpressionSignature::Node::operator ==(const Node& rhs) const {
+    return m_kind == rhs.m_kind && m_type == rhs.m_type &&
+      m_index == rhs.m_index &&
+      (m_name == rhs.m_name || (m_name && rhs.m_name &&
+        *m_name == *rhs.m_name)) &&
+      (m_value == rhs.m_value || (m_value && rhs.m_value &&
+        *m_value == *rhs.m_value));
+  }
+
+  inline void ExpressionSignature::Builder::add(
+      const VirtualExpression& expression, Kind kind, const std::string* name,
+      int index, const Value* value) {
+    auto& signature = *m_signature;
+    signature.m_nodes.push_back(
+      Node(kind, expression.get_type(), name, index, value));
+    boost::hash_combine(signature.m_hash, static_cast<int>(kind));
+    boost::hash_combine(signature.m_hash, expression.get_type().hash_code());
+    boost::hash_combine(signature.m_hash, index);
+    if(name) {
+      boost::hash_combine(signature.m_hash, std::hash<std::string>()(*name));
+    }
+    if(value) {
+      boost::hash_combine(signature.m_hash, value->get_type().hash_code());
+      boost::hash_combine(
+        signature.m_hash, std::hash<std::string>()(to_string(*value)));
+    }
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const AndExpression& expression) {
+    add(expression, Kind::AND);
+    TraversalExpressionVisitor::visit(expression);
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const ConstantExpression& expression) {
+    add(expression, Kind::CONSTANT, nullptr, 0, &expression.get_value());
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const FunctionExpression& expression) {
+    add(expression, Kind::FUNCTION, &expression.get_name(),
+      static_cast<int>(expression.get_parameters().size()));
+    TraversalExpressionVisitor::visit(expression);
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const GlobalVariableDeclarationExpression& expression) {
+    add(expression, Kind::GLOBAL_VARIABLE_DECLARATION, &expression.get_name());
+    TraversalExpressionVisitor::visit(expression);
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const MemberAccessExpression& expression) {
+    add(expression, Kind::MEMBER_ACCESS, &expression.get_name());
+    TraversalExpressionVisitor::visit(expression);
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const NotExpression& expression) {
+    add(expression, Kind::NOT);
+    TraversalExpressionVisitor::visit(expression);
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const OrExpression& expression) {
+    add(expression, Kind::OR);
+    TraversalExpressionVisitor::visit(expression);
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const ParameterExpression& expression) {
+    add(expression, Kind::PARAMETER, nullptr, expression.get_index());
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const ReduceExpression& expression) {
+    add(expression, Kind::REDUCE, nullptr, 0,
+      &expression.get_initial_value());
+    TraversalExpressionVisitor::visit(expression);
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const SetVariableExpression& expression) {
+    add(expression, Kind::SET_VARIABLE, &expression.get_name());
+    TraversalExpressionVisitor::visit(expression);
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const VariableExpression& expression) {
+    add(expression, Kind::VARIABLE, &expression.get_name());
+  }
+
+  inline void ExpressionSignature::Builder::visit(
+      const VirtualExpression& expression) {
+    m_signature->m_is_comparable = false;
+  }
+}
+
+namespace std {
+  template<>
+  struct hash<Beam::ExpressionSignature> {
+    std::size_t operator ()(
+        const Beam::ExpressionSignature& value) const noexcept {
+      return value.get_hash();
+    }
+  };
+}
+
+#endif
@@ -1,6 +1,11 @@
 #ifndef BEAM_FILTERED_QUERY_HPP
 #define BEAM_FILTERED_QUERY_HPP
+#include <cstddef>
+#include <exception>
+#include <functional>
 #include <ostream>
+#include <ranges>
+#include <span>
 #include <boost/throw_exception.hpp>
 #include "Beam/Queries/ConstantExpression.hpp"
 #include "Beam/Queries/Evaluator.hpp"
@@ -51,6 +56,28 @@ namespace Beam {
     }
   }
 
+  /**
+   * Tests whether each value in a range passes a filter, evaluating many
+   * values at a time where the filter allows it.
+   * @param evaluator The filter to test.
+   * @param values The values to test.
+   * @param selection Stores whether each value passes the filter.
+   * @param projection Maps each value to a reference to the value to test.
+   */
+  template<std::ranges::random_access_range R, typename P = std::identity>
+  void test_filter(Evaluator& evaluator, const R& values,
+      std::span<bool> selection, P projection = {}) {
+    try {
+      evaluator.select(values, selection, projection);
+    } catch(const std::exception&) {
+      auto first = std::ranges::begin(values);
+      for(auto i = std::size_t(0); i != selection.size(); ++i) {
+        selection[i] =
+          test_filter(evaluator, std::invoke(projection, first[i]));
+      }
+    }
+  }
+
   inline std::ostream& operator <<(
       std::ostream& out, const FilteredQuery& query) {
     return out << query.get_filter();
@@ -0,0 +1,303 @@
+#ifndef BEAM_FLUSH_CONTROLLER_HPP
+#define BEAM_FLUSH_CONTROLLER_HPP
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include "Beam/IO/OpenState.hpp"
+#include "Beam/Queries/BufferStatistics.hpp"
+#include "Beam/Queries/WriteAheadLog.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+#include "Beam/TimeService/LiveTimer.hpp"
+#include "Beam/Utilities/ReportException.hpp"
+
+namespace Beam {
+
+  /**
+   * Manages the backpressure, write-ahead log and flush retries of a data
+   * store that buffers writes.
+   * Stores are suspended once the number of buffered values reaches the
+   * high-water mark, until a flush commits them. A failed flush keeps its
+   * values buffered to be retried on the next flush, or repeatedly while stores
+   * are suspended. Each retry of consecutive failures waits twice as long as
+   * the last, from MIN_FLUSH_RETRY_DELAY up to MAX_FLUSH_RETRY_DELAY.
+   * Given a write-ahead log, stores are made durable before returning and the
+   * values left in the log by a crash are recovered. Recovered values the data
+   * store already committed are skipped, so a crash between a flush and the
+   * truncation of its log segments stores nothing twice. A store that fails to
+   * make its values durable throws, but the values remain buffered and are
+   * still committed by a later flush.
+   * @tparam T The type of value buffered.
+   */
+  template<typename T>
+  class FlushController {
+    public:
+
+      /** The type of value buffered. */
+      using Value = T;
+
+      /**
+       * The type of callback invoked when a flush, or the reservation or
+       * truncation of a log segment, fails.
+       */
+      using ExceptionHandler = std::function<void (const std::exception_ptr&)>;
+
+      /**
+       * Constructs a FlushController.
+       * @param mutex The mutex guarding the buffer.
+       * @param open_state The OpenState of the data store buffering writes.
+       * @param high_water_mark The number of buffered values at which stores
+       *        are suspended until a flush commits them.
+       * @param log The log that stores are made durable in, or null.
+       * @param exception_handler The callback invoked when a flush fails, or
+       *        null to print failures.
+       */
+      FlushController(boost::mutex& mutex, const OpenState& open_state,
+        std::size_t high_water_mark, std::unique_ptr<WriteAheadLog<Value>> log,
+        ExceptionHandler exception_handler);
+
+      /** Returns the buffer depth and flush metrics, with the lock held. */
+      const BufferStatistics& get_statistics() const;
+
+      /** Returns <code>true</code> iff the buffer is at its high-water mark. */
+      bool is_full() const;
+
+      /**
+       * Returns the values recovered from the log that a data store hasn't
+       * committed, counting them as buffered.
+       * @param data_store The data store the values are committed to.
+       */
+      template<typename D>
+      std::vector<Value> recover(D& data_store);
+
+      /**
+       * Waits until the buffer is below its high-water mark or the data store
+       * is closing.
+       * @param lock The lock held on the buffer's mutex.
+       */
+      void wait_for_capacity(boost::unique_lock<boost::mutex>& lock);
+
+      /**
+       * Counts values as buffered and writes them to the log, with the lock
+       * held.
+       * @param values The values to buffer.
+       * @return The position to sync to make the values durable.
+       */
+      std::uint64_t stage(std::span<const Value> values);
+
+      /**
+       * Waits until staged values are durable, without the lock held.
+       * @param position The position returned when the values were staged.
+       */
+      void sync(std::uint64_t position);
+
+      /**
+       * Flushes the buffer, retrying while stores are suspended.
+       * @param take Takes the buffered values with the lock held, returning
+       *        their count.
+       * @param commit Stores the taken values in the data store.
+       * @param restore Returns the taken values and their count to the buffer
+       *        after they failed to commit.
+       * @param release Called after every attempt.
+       */
+      template<typename Take, typename Commit, typename Restore,
+        typename Release>
+      void flush(Take&& take, Commit&& commit, Restore&& restore,
+        Release&& release);
+
+      /**
+       * Wakes the suspended stores and cancels a pending retry, once the data
+       * store is closing.
+       */
+      void close();
+
+    private:
+      boost::mutex* m_mutex;
+      const OpenState* m_open_state;
+      std::unique_ptr<WriteAheadLog<Value>> m_log;
+      ExceptionHandler m_exception_handler;
+      BufferStatistics m_statistics;
+      boost::posix_time::time_duration m_retry_delay;
+      std::shared_ptr<LiveTimer> m_retry_timer;
+      ConditionVariable m_drained;
+
+      FlushController(const FlushController&) = delete;
+      FlushController& operator =(const FlushController&) = delete;
+      void report(const std::exception_ptr& exception);
+      bool back_off();
+  };
+
+  template<typename T>
+  FlushController<T>::FlushController(boost::mutex& mutex,
+      const OpenState& open_state, std::size_t high_water_mark,
+      std::unique_ptr<WriteAheadLog<Value>> log,
+      ExceptionHandler exception_handler)
+      : m_mutex(&mutex),
+        m_open_state(&open_state),
+        m_log(std::move(log)),
+        m_exception_handler(std::move(exception_handler)) {
+    m_statistics.m_high_water_mark = std::max<std::size_t>(high_water_mark, 1);
+  }
+
+  template<typename T>
+  const BufferStatistics& FlushController<T>::get_statistics() const {
+    return m_statistics;
+  }
+
+  template<typename T>
+  bool FlushController<T>::is_full() const {
+    return m_statistics.m_depth >= m_statistics.m_high_water_mark;
+  }
+
+  template<typename T>
+  template<typename D>
+  std::vector<typename FlushController<T>::Value>
+      FlushController<T>::recover(D& data_store) {
+    if(!m_log) {
+      return {};
+    }
+    auto values = remove_committed(data_store, m_log->recover());
+    auto lock = boost::lock_guard(*m_mutex);
+    m_statistics.m_depth += values.size();
+    return values;
+  }
+
+  template<typename T>
+  void FlushController<T>::wait_for_capacity(
+      boost::unique_lock<boost::mutex>& lock) {
+    while(is_full() && m_open_state->is_open()) {
+      m_drained.wait(lock);
+    }
+  }
+
+  template<typename T>
+  std::uint64_t FlushController<T>::stage(std::span<const Value> values) {
+    auto position = std::uint64_t(0);
+    if(m_log) {
+      position = m_log->write(values);
+    }
+    m_statistics.m_depth += values.size();
+    return position;
+  }
+
+  template<typename T>
+  void FlushController<T>::sync(std::uint64_t position) {
+    if(m_log) {
+      m_log->sync(position);
+    }
+  }
+
+  template<typename T>
+  template<typename Take, typename Commit, typename Restore, typename Release>
+  void FlushController<T>::flush(
+      Take&& take, Commit&& commit, Restore&& restore, Release&& release) {
+    auto is_retrying = true;
+    while(is_retrying) {
+      auto count = std::size_t(0);
+      auto segment =
+        std::optional<typename WriteAheadLog<Value>::Segment>();
+      if(m_log) {
+        try {
+          m_log->reserve();
+        } catch(const std::exception&) {
+          report(std::current_exception());
+        }
+      }
+      {
+        auto lock = boost::lock_guard(*m_mutex);
+        if(m_log) {
+          segment = m_log->seal();
+        }
+        count = take();
+      }
+      auto start = boost::posix_time::microsec_clock::universal_time();
+      try {
+        commit();
+        auto latency =
+          boost::posix_time::microsec_clock::universal_time() - start;
+        if(segment) {
+          try {
+            m_log->truncate(*segment);
+          } catch(const std::exception&) {
+            report(std::current_exception());
+          }
+        }
+        auto lock = boost::lock_guard(*m_mutex);
+        m_statistics.m_depth -= count;
+        record_flush(m_statistics, latency);
+        m_retry_delay = boost::posix_time::time_duration();
+        m_drained.notify_all();
+        is_retrying = false;
+      } catch(...) {
+        restore(count);
+        {
+          auto lock = boost::lock_guard(*m_mutex);
+          ++m_statistics.m_failures;
+          is_retrying = is_full() && m_open_state->is_open();
+        }
+        report(std::current_exception());
+      }
+      release();
+      if(is_retrying && !back_off()) {
+        is_retrying = false;
+      }
+    }
+  }
+
+  template<typename T>
+  void FlushController<T>::close() {
+    auto retry_timer = std::shared_ptr<LiveTimer>();
+    {
+      auto lock = boost::lock_guard(*m_mutex);
+      m_drained.notify_all();
+      retry_timer = m_retry_timer;
+    }
+    if(retry_timer) {
+      retry_timer->cancel();
+    }
+  }
+
+  template<typename T>
+  void FlushController<T>::report(const std::exception_ptr& exception) {
+    if(m_exception_handler) {
+      m_exception_handler(exception);
+      return;
+    }
+    try {
+      std::rethrow_exception(exception);
+    } catch(...) {
+      std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+    }
+  }
+
+  template<typename T>
+  bool FlushController<T>::back_off() {
+    auto timer = std::shared_ptr<LiveTimer>();
+    {
+      auto lock = boost::lock_guard(*m_mutex);
+      if(!m_open_state->is_open()) {
+        return false;
+      }
+      m_retry_delay = std::clamp<boost::posix_time::time_duration>(
+        m_retry_delay * 2, MIN_FLUSH_RETRY_DELAY, MAX_FLUSH_RETRY_DELAY);
+      m_retry_timer = std::make_shared<LiveTimer>(m_retry_delay);
+      m_retry_timer->start();
+      timer = m_retry_timer;
+    }
+    timer->wait();
+    auto lock = boost::lock_guard(*m_mutex);
+    m_retry_timer.reset();
+    return m_open_state->is_open();
+  }
+}
+
+#endif
@@ -1,9 +1,15 @@
 #ifndef BEAM_FUNCTION_EVALUATOR_NODE_HPP
 #define BEAM_FUNCTION_EVALUATOR_NODE_HPP
 #include <memory>
+#include <span>
+#include <stdexcept>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <boost/callable_traits.hpp>
-#include "Beam/Queries/EvaluatorNode.hpp"
+#include <boost/throw_exception.hpp>
+#include "Beam/Queries/EvaluatorOperand.hpp"
 #include "Beam/Utilities/Casts.hpp"
 
 namespace Beam {
@@ -13,12 +19,66 @@ namespace Details {
 
   template<typename R, typename... Args>
   struct function_parameter_tuple<R(Args...)> {
-    using type =
-      std::tuple<std::unique_ptr<EvaluatorNode<std::remove_cvref_t<Args>>>...>;
+    using type = std::tuple<EvaluatorOperand<std::remove_cvref_t<Args>>...>;
   };
 
   template<typename F>
   using function_parameter_tuple_t = typename function_parameter_tuple<F>::type;
+
+  template<typename T, std::size_t... I>
+  T make_function_arguments(
+      std::vector<std::unique_ptr<BaseEvaluatorNode>>& args,
+      std::index_sequence<I...>) {
+    if(args.size() != sizeof...(I)) {
+      boost::throw_with_location(
+        std::invalid_argument("args has the wrong size."));
+    }
+    return T(static_pointer_cast<
+      EvaluatorNode<typename std::tuple_element_t<I, T>::Result>>(
+        std::move(args[I]))...);
+  }
+
+  template<typename T>
+  struct BatchColumn {
+    const T* m_values;
+
+    const T& operator [](std::size_t row) const {
+      return m_values[row];
+    }
+  };
+
+  template<typename T>
+  struct BatchScalar {
+    T m_value;
+
+    const T& operator [](std::size_t row) const {
+      return m_value;
+    }
+  };
+
+  template<typename F, typename R, typename... Views>
+  void apply_batch(
+      F& function, std::span<R> results, const std::tuple<Views...>& views) {
+    std::apply([&] (const auto&... view) {
+      for(auto i = std::size_t(0); i != results.size(); ++i) {
+        results[i] = function(view[i]...);
+      }
+    }, views);
+  }
+
+  template<typename F, typename R, typename... Views, typename T,
+    typename... Operands>
+  void apply_batch(F& function, std::span<R> results,
+      const std::tuple<Views...>& views, const EvaluatorOperand<T>& operand,
+      const Operands&... operands) {
+    if(operand.is_constant()) {
+      apply_batch(function, results, std::tuple_cat(views,
+        std::tuple(BatchScalar<T>(*operand.get_values()))), operands...);
+    } else {
+      apply_batch(function, results, std::tuple_cat(views,
+        std::tuple(BatchColumn<T>(operand.get_values()))), operands...);
+    }
+  }
 }
 
   /**
@@ -53,7 +113,12 @@ namespace Details {
       FunctionEvaluatorNode(Function function,
         std::vector<std::unique_ptr<BaseEvaluatorNode>> args);
 
+      /** Returns <code>true</code> iff all arguments are constants. */
+      bool is_constant() const;
+
       Result eval() override;
+      bool eval_batch(
+        const EvaluatorBatch& batch, std::span<Result> results) override;
 
     private:
       Function m_function;
@@ -74,7 +139,8 @@ namespace Details {
   }
 
   /**
-   * Translates a FunctionExpression into a FunctionEvaluatorNode.
+   * Translates a FunctionExpression into a FunctionEvaluatorNode, folding it
+   * into a ConstantEvaluatorNode if all of its arguments are constants.
    * @tparam F The type of function to evaluate.
    */
   template<typename F>
@@ -85,8 +151,8 @@ namespace Details {
     BaseEvaluatorNode* operator ()(
         std::vector<std::unique_ptr<BaseEvaluatorNode>> parameters) const {
       using Operation = typename F::template Operation<Args...>;
-      return new FunctionEvaluatorNode<Operation>(
-        Operation(), std::move(parameters));
+      return fold_constant(std::make_unique<FunctionEvaluatorNode<Operation>>(
+        Operation(), std::move(parameters))).release();
     };
   };
 
@@ -99,25 +165,44 @@ namespace Details {
 
   template<typename F>
   FunctionEvaluatorNode<F>::FunctionEvaluatorNode(
-      Function function, std::vector<std::unique_ptr<BaseEvaluatorNode>> args)
-      : m_function(std::move(function)) {
-    if(args.size() != std::tuple_size_v<decltype(m_arguments)>) {
-      boost::throw_with_location(
-        std::invalid_argument("args has the wrong size."));
-    }
-    std::apply([&] (auto&... arg) {
-      auto index = 0;
-      ((arg = static_pointer_cast<std::remove_cvref_t<decltype(*arg)>>(
-        std::move(args[index++]))), ...);
+    Function function, std::vector<std::unique_ptr<BaseEvaluatorNode>> args)
+    : m_function(std::move(function)),
+      m_arguments(Details::make_function_arguments<decltype(m_arguments)>(
+        args, std::make_index_sequence<
+          std::tuple_size_v<decltype(m_arguments)>>())) {}
+
+  template<typename F>
+  bool FunctionEvaluatorNode<F>::is_constant() const {
+    return std::apply([] (const auto&... arg) {
+      return (arg.is_constant() && ...);
     }, m_arguments);
   }
 
   template<typename F>
   typename FunctionEvaluatorNode<F>::Result FunctionEvaluatorNode<F>::eval() {
     return std::apply([&] (auto&... arg) {
-      return m_function(arg->eval()...);
+      return m_function(arg.eval()...);
     }, m_arguments);
   }
+
+  template<typename F>
+  bool FunctionEvaluatorNode<F>::eval_batch(
+      const EvaluatorBatch& batch, std::span<Result> results) {
+    if constexpr(std::is_copy_assignable_v<Result>) {
+      auto is_loaded = std::apply([&] (auto&... arg) {
+        return (arg.load(batch) && ...);
+      }, m_arguments);
+      if(!is_loaded) {
+        return false;
+      }
+      std::apply([&] (const auto&... arg) {
+        Details::apply_batch(m_function, results, std::tuple(), arg...);
+      }, m_arguments);
+      return true;
+    } else {
+      return false;
+    }
+  }
 }
 
 #endif
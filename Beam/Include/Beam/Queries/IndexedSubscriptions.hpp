@@ -1,6 +1,6 @@
 #ifndef BEAM_INDEXED_QUERY_SUBSCRIPTIONS_HPP
 #define BEAM_INDEXED_QUERY_SUBSCRIPTIONS_HPP
-#include <boost/functional/factory.hpp>
+#include <memory>
 #include <boost/range/adaptor/map.hpp>
 #include "Beam/Collections/SynchronizedMap.hpp"
 #include "Beam/Queries/IndexedValue.hpp"
@@ -31,9 +31,20 @@ namespace Beam {
       /** The type of ServiceProtocolClients subscribing to queries. */
       using ServiceProtocolClient = C;
 
+      /** The type of function used to translate filters added by Expression. */
+      using Translator =
+        typename Subscriptions<BaseValue, ServiceProtocolClient>::Translator;
+
       /** Constructs an IndexedSubscriptions object. */
       IndexedSubscriptions() = default;
 
+      /**
+       * Constructs an IndexedSubscriptions object with a custom Translator.
+       * @param translator The Translator used for filters added by
+       *        Expression.
+       */
+      explicit IndexedSubscriptions(Translator translator);
+
       /**
        * Adds a subscription combining the initialization and commit.
        * @param index The subscription's index.
@@ -45,6 +56,18 @@ namespace Beam {
       int add(const Index& index, ServiceProtocolClient& client,
         const Range& range, std::unique_ptr<Evaluator> filter);
 
+      /**
+       * Adds a subscription whose filter is indexed, combining the
+       * initialization and commit.
+       * @param index The subscription's index.
+       * @param client The client initializing the subscription.
+       * @param range The Range of the query.
+       * @param filter The filter to apply to published values.
+       * @return The query's unique id.
+       */
+      int add(const Index& index, ServiceProtocolClient& client,
+        const Range& range, const Expression& filter);
+
       /**
        * Initializes a subscription.
        * @param index The subscription's index.
@@ -56,6 +79,17 @@ namespace Beam {
       int init(const Index& index, ServiceProtocolClient& client,
         const Range& range, std::unique_ptr<Evaluator> filter);
 
+      /**
+       * Initializes a subscription whose filter is indexed.
+       * @param index The subscription's index.
+       * @param client The client initializing the subscription.
+       * @param range The Range of the query.
+       * @param filter The filter to apply to published values.
+       * @return The query's unique id.
+       */
+      int init(const Index& index, ServiceProtocolClient& client,
+        const Range& range, const Expression& filter);
+
       /**
        * Commits a previously initialized subscription.
        * @param index The index of the subscription to commit.
@@ -114,54 +148,64 @@ namespace Beam {
 
     private:
       using BaseSubscriptions = Subscriptions<BaseValue, ServiceProtocolClient>;
+      Translator m_translator;
       SynchronizedUnorderedMap<Index, std::shared_ptr<BaseSubscriptions>>
         m_subscriptions;
 
       IndexedSubscriptions(const IndexedSubscriptions&) = delete;
       IndexedSubscriptions& operator =(const IndexedSubscriptions&) = delete;
+      BaseSubscriptions& load(const Index& index);
   };
 
+  template<typename V, typename I, typename C>
+  IndexedSubscriptions<V, I, C>::IndexedSubscriptions(Translator translator)
+    : m_translator(std::move(translator)) {}
+
   template<typename V, typename I, typename C>
   int IndexedSubscriptions<V, I, C>::add(
       const Index& index, ServiceProtocolClient& client, const Range& range,
       std::unique_ptr<Evaluator> filter) {
-    auto& subscriptions = *m_subscriptions.get_or_insert(
-      index, boost::factory<std::shared_ptr<BaseSubscriptions>>());
-    return subscriptions.add(client, range, std::move(filter));
+    return load(index).add(client, range, std::move(filter));
+  }
+
+  template<typename V, typename I, typename C>
+  int IndexedSubscriptions<V, I, C>::add(
+      const Index& index, ServiceProtocolClient& client, const Range& range,
+      const Expression& filter) {
+    return load(index).add(client, range, filter);
   }
 
   template<typename V, typename I, typename C>
   int IndexedSubscriptions<V, I, C>::init(const Index& index,
       ServiceProtocolClient& client, const Range& range,
       std::unique_ptr<Evaluator> filter) {
-    auto& subscriptions = *m_subscriptions.get_or_insert(
-      index, boost::factory<std::shared_ptr<BaseSubscriptions>>());
-    return subscriptions.init(client, range, std::move(filter));
+    return load(index).init(client, range, std::move(filter));
+  }
+
+  template<typename V, typename I, typename C>
+  int IndexedSubscriptions<V, I, C>::init(const Index& index,
+      ServiceProtocolClient& client, const Range& range,
+      const Expression& filter) {
+    return load(index).init(client, range, filter);
   }
 
   template<typename V, typename I, typename C>
   template<typename F>
   void IndexedSubscriptions<V, I, C>::commit(const Index& index,
       QueryResult<SequencedValue<BaseValue>> result, F&& f) {
-    auto& subscriptions = *m_subscriptions.get_or_insert(
-      index, boost::factory<std::shared_ptr<BaseSubscriptions>>());
-    return subscriptions.commit(std::move(result), std::forward<F>(f));
+    return load(index).commit(std::move(result), std::forward<F>(f));
   }
 
   template<typename V, typename I, typename C>
   void IndexedSubscriptions<V, I, C>::end(
       const Index& index, const ServiceProtocolClient& client, int id) {
-    auto& subscriptions = *m_subscriptions.get_or_insert(
-      index, boost::factory<std::shared_ptr<BaseSubscriptions>>());
-    subscriptions.end(client, id);
+    load(index).end(client, id);
   }
 
   template<typename V, typename I, typename C>
   void IndexedSubscriptions<V, I, C>::discard(
       const Index& index, const ServiceProtocolClient& client, int id) {
-    auto& subscriptions = *m_subscriptions.get_or_insert(
-      index, boost::factory<std::shared_ptr<BaseSubscriptions>>());
-    subscriptions.discard(client, id);
+    load(index).discard(client, id);
   }
 
   template<typename V, typename I, typename C>
@@ -176,18 +220,25 @@ namespace Beam {
   template<typename ClientFilter, typename Sender>
   void IndexedSubscriptions<V, I, C>::publish(const Value& value,
       const ClientFilter& client_filter, const Sender& sender) {
-    auto& subscriptions = *m_subscriptions.get_or_insert(
-      value->get_index(), boost::factory<std::shared_ptr<BaseSubscriptions>>());
-    subscriptions.publish(value, client_filter, sender);
+    load(value->get_index()).publish(value, client_filter, sender);
   }
 
   template<typename V, typename I, typename C>
   template<typename Sender>
   void IndexedSubscriptions<V, I, C>::publish(
       const Value& value, const Sender& sender) {
-    auto& subscriptions = *m_subscriptions.get_or_insert(
-      value->get_index(), boost::factory<std::shared_ptr<BaseSubscriptions>>());
-    subscriptions.publish(value, sender);
+    load(value->get_index()).publish(value, sender);
+  }
+
+  template<typename V, typename I, typename C>
+  typename IndexedSubscriptions<V, I, C>::BaseSubscriptions&
+      IndexedSubscriptions<V, I, C>::load(const Index& index) {
+    return *m_subscriptions.get_or_insert(index, [&] {
+      if(m_translator) {
+        return std::make_shared<BaseSubscriptions>(m_translator);
+      }
+      return std::make_shared<BaseSubscriptions>();
+    });
   }
 }
 
@@ -1,6 +1,7 @@
 #ifndef BEAM_LOCAL_DATA_STORE_HPP
 #define BEAM_LOCAL_DATA_STORE_HPP
 #include <algorithm>
+#include <span>
 #include <utility>
 #include <vector>
 #include "Beam/Collections/SynchronizedMap.hpp"
@@ -53,6 +54,15 @@ namespace Beam {
        */
       std::vector<SequencedValue> load(const Query& query) const;
 
+      /**
+       * Loads a batch of queries.
+       * @param queries The queries to load.
+       * @return The values loaded by each query, in the same order as the
+       *         queries.
+       */
+      std::vector<std::vector<SequencedValue>> load(
+        std::span<const Query> queries) const;
+
       /**
        * Stores a Value.
        * @param value The Value to store.
@@ -111,6 +121,17 @@ namespace Beam {
     return {};
   }
 
+  template<typename Q, typename V, typename T>
+  std::vector<std::vector<typename LocalDataStore<Q, V, T>::SequencedValue>>
+      LocalDataStore<Q, V, T>::load(std::span<const Query> queries) const {
+    auto values = std::vector<std::vector<SequencedValue>>();
+    values.reserve(queries.size());
+    for(auto& query : queries) {
+      values.push_back(load(query));
+    }
+    return values;
+  }
+
   template<typename Q, typename V, typename T>
   void LocalDataStore<Q, V, T>::store(const IndexedValue& value) {
     auto& entry = m_entries.get_or_insert(value->get_index(), [&] {
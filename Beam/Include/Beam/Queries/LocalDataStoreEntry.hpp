@@ -1,11 +1,15 @@
 #ifndef BEAM_LOCAL_DATA_STORE_ENTRY_HPP
 #define BEAM_LOCAL_DATA_STORE_ENTRY_HPP
 #include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <ranges>
+#include <span>
 #include <vector>
 #include <boost/date_time/posix_time/ptime.hpp>
-#include <boost/range/adaptor/reversed.hpp>
 #include "Beam/Collections/SynchronizedList.hpp"
 #include "Beam/Queries/Evaluator.hpp"
 #include "Beam/Queries/EvaluatorTranslator.hpp"
@@ -56,6 +60,9 @@ namespace Beam {
        */
       explicit LocalDataStoreEntry(const Translator& translator);
 
+      /** Returns the number of values stored by this data store. */
+      std::size_t get_size() const;
+
       /** Returns all the values stored by this data store. */
       std::vector<SequencedValue> load_all() const;
 
@@ -72,6 +79,15 @@ namespace Beam {
        */
       void store(const SequencedValue& value);
 
+      /**
+       * Stores a Value, passing the Value it replaces to a callback.
+       * @param value The Value to store.
+       * @param on_replace Called with the stored Value that has the same
+       *        Sequence as <i>value</i>, just before it's overwritten.
+       */
+      template<std::invocable<const Beam::SequencedValue<V>&> F>
+      void store(const SequencedValue& value, F&& on_replace);
+
       /**
        * Stores a list of Values.
        * @param values The Values to store.
@@ -79,21 +95,40 @@ namespace Beam {
       void store(const std::vector<SequencedValue>& values);
 
     private:
+      static constexpr auto MIN_FILTER_BATCH_SIZE = std::ptrdiff_t(16);
+      static constexpr auto MAX_FILTER_BATCH_SIZE = std::ptrdiff_t(1024);
       using ValueList = SynchronizedVector<SequencedValue>;
       ValueList m_values;
+      std::size_t m_unordered_timestamp_count;
       Translator m_translator;
+
+      static std::size_t count_unordered(
+        const SequencedValue* previous, const SequencedValue* next);
+      static typename std::vector<SequencedValue>::const_iterator lower_bound(
+        const std::vector<SequencedValue>& values, const Range::Point& point);
+      static typename std::vector<SequencedValue>::const_iterator upper_bound(
+        const std::vector<SequencedValue>& values, const Range::Point& point);
   };
 
   template<typename Q, typename V, typename T>
   LocalDataStoreEntry<Q, V, T>::LocalDataStoreEntry()
-    : m_translator([] (const auto& expression) {
+    : m_unordered_timestamp_count(0),
+      m_translator([] (const auto& expression) {
         return translate<EvaluatorTranslatorFilter>(expression);
       }) {}
 
   template<typename Q, typename V, typename T>
   LocalDataStoreEntry<Q, V, T>::LocalDataStoreEntry(
     const Translator& translator)
-    : m_translator(translator) {}
+    : m_unordered_timestamp_count(0),
+      m_translator(translator) {}
+
+  template<typename Q, typename V, typename T>
+  std::size_t LocalDataStoreEntry<Q, V, T>::get_size() const {
+    return m_values.with([] (const auto& values) {
+      return values.size();
+    });
+  }
 
   template<typename Q, typename V, typename T>
   std::vector<typename LocalDataStoreEntry<Q, V, T>::SequencedValue>
@@ -114,30 +149,56 @@ namespace Beam {
     auto& end = query.get_range().get_end();
     auto filter = m_translator(query.get_filter());
     m_values.with([&] (const auto& values) {
-      if(query.get_snapshot_limit().get_type() == SnapshotLimit::Type::TAIL) {
-        for(auto& value : boost::adaptors::reverse(values)) {
-          if(range_point_greater_or_equal(value, start) &&
-              range_point_lesser_or_equal(value, end) &&
-              test_filter(*filter, *value)) {
-            matches.push_back(value);
-            if(static_cast<int>(matches.size()) >=
-                query.get_snapshot_limit().get_size()) {
-              break;
-            }
-          }
+      auto is_indexed = [&] (const Range::Point& point) {
+        return boost::get<Sequence>(&point) ||
+          m_unordered_timestamp_count == 0;
+      };
+      auto first = values.begin();
+      if(is_indexed(start)) {
+        first = lower_bound(values, start);
+      }
+      auto last = values.end();
+      if(is_indexed(end)) {
+        last = upper_bound(values, end);
+      }
+      if(first >= last) {
+        return;
+      }
+      auto is_bounded = is_indexed(start) && is_indexed(end);
+      auto match = [&] (const SequencedValue& value) {
+        if(is_bounded || (range_point_greater_or_equal(value, start) &&
+            range_point_lesser_or_equal(value, end))) {
+          matches.push_back(value);
+          return static_cast<int>(matches.size()) >=
+            query.get_snapshot_limit().get_size();
         }
-      } else {
-        for(auto& value : values) {
-          if(range_point_greater_or_equal(value, start) &&
-              range_point_lesser_or_equal(value, end) &&
-              test_filter(*filter, *value)) {
-            matches.push_back(value);
-            if(static_cast<int>(matches.size()) >=
-                query.get_snapshot_limit().get_size()) {
-              break;
-            }
+        return false;
+      };
+      auto project = [] (const SequencedValue& value) -> const Value& {
+        return *value;
+      };
+      auto selection = std::array<bool, MAX_FILTER_BATCH_SIZE>();
+      auto batch_size = MIN_FILTER_BATCH_SIZE;
+      auto is_tail =
+        query.get_snapshot_limit().get_type() == SnapshotLimit::Type::TAIL;
+      while(first != last) {
+        auto count = std::min<std::ptrdiff_t>(batch_size, last - first);
+        auto batch = is_tail ? std::ranges::subrange(last - count, last) :
+          std::ranges::subrange(first, first + count);
+        test_filter(
+          *filter, batch, std::span(selection.data(), count), project);
+        for(auto i = std::ptrdiff_t(0); i != count; ++i) {
+          auto index = is_tail ? count - i - 1 : i;
+          if(selection[index] && match(batch[index])) {
+            return;
           }
         }
+        if(is_tail) {
+          last -= count;
+        } else {
+          first += count;
+        }
+        batch_size = std::min(2 * batch_size, MAX_FILTER_BATCH_SIZE);
       }
     });
     if(query.get_snapshot_limit().get_type() == SnapshotLimit::Type::TAIL) {
@@ -148,17 +209,38 @@ namespace Beam {
 
   template<typename Q, typename V, typename T>
   void LocalDataStoreEntry<Q, V, T>::store(const SequencedValue& value) {
+    store(value, [] (const SequencedValue&) {});
+  }
+
+  template<typename Q, typename V, typename T>
+  template<std::invocable<const Beam::SequencedValue<V>&> F>
+  void LocalDataStoreEntry<Q, V, T>::store(
+      const SequencedValue& value, F&& on_replace) {
     m_values.with([&] (auto& values) {
       if(values.empty() ||
           value.get_sequence() > values.back().get_sequence()) {
+        if(!values.empty()) {
+          m_unordered_timestamp_count +=
+            count_unordered(&values.back(), &value);
+        }
         values.push_back(value);
         return;
       }
       auto i = std::lower_bound(
         values.begin(), values.end(), value, SequenceComparator());
-      if(i != values.end() && i->get_sequence() == value.get_sequence()) {
+      auto previous = i == values.begin() ? nullptr : &*(i - 1);
+      if(i->get_sequence() == value.get_sequence()) {
+        auto next = i + 1 == values.end() ? nullptr : &*(i + 1);
+        m_unordered_timestamp_count -=
+          count_unordered(previous, &*i) + count_unordered(&*i, next);
+        on_replace(*i);
         *i = value;
+        m_unordered_timestamp_count +=
+          count_unordered(previous, &*i) + count_unordered(&*i, next);
       } else {
+        m_unordered_timestamp_count +=
+          count_unordered(previous, &value) + count_unordered(&value, &*i) -
+            count_unordered(previous, &*i);
         values.insert(i, value);
       }
     });
@@ -171,6 +253,49 @@ namespace Beam {
       store(value);
     }
   }
+
+  template<typename Q, typename V, typename T>
+  std::size_t LocalDataStoreEntry<Q, V, T>::count_unordered(
+      const SequencedValue* previous, const SequencedValue* next) {
+    if(!previous || !next) {
+      return 0;
+    }
+    return get_timestamp(*next) < get_timestamp(*previous) ? 1 : 0;
+  }
+
+  template<typename Q, typename V, typename T>
+  typename std::vector<typename LocalDataStoreEntry<Q, V, T>::SequencedValue>::
+      const_iterator LocalDataStoreEntry<Q, V, T>::lower_bound(
+        const std::vector<SequencedValue>& values, const Range::Point& point) {
+    if(auto sequence = boost::get<Sequence>(&point)) {
+      return std::lower_bound(values.begin(), values.end(), *sequence,
+        [] (const auto& value, const auto& sequence) {
+          return value.get_sequence() < sequence;
+        });
+    }
+    return std::lower_bound(values.begin(), values.end(),
+      boost::get<boost::posix_time::ptime>(point),
+      [] (const auto& value, const auto& timestamp) {
+        return get_timestamp(value) < timestamp;
+      });
+  }
+
+  template<typename Q, typename V, typename T>
+  typename std::vector<typename LocalDataStoreEntry<Q, V, T>::SequencedValue>::
+      const_iterator LocalDataStoreEntry<Q, V, T>::upper_bound(
+        const std::vector<SequencedValue>& values, const Range::Point& point) {
+    if(auto sequence = boost::get<Sequence>(&point)) {
+      return std::upper_bound(values.begin(), values.end(), *sequence,
+        [] (const auto& sequence, const auto& value) {
+          return sequence < value.get_sequence();
+        });
+    }
+    return std::upper_bound(values.begin(), values.end(),
+      boost::get<boost::posix_time::ptime>(point),
+      [] (const auto& timestamp, const auto& value) {
+        return timestamp < get_timestamp(value);
+      });
+  }
 }
 
 #endif
@@ -1,9 +1,10 @@
 #ifndef BEAM_MEMBER_ACCESS_EVALUATOR_NODE_HPP
 #define BEAM_MEMBER_ACCESS_EVALUATOR_NODE_HPP
 #include <memory>
+#include <span>
 #include <type_traits>
 #include <utility>
-#include "Beam/Queries/EvaluatorNode.hpp"
+#include "Beam/Queries/EvaluatorOperand.hpp"
 
 namespace Beam {
 
@@ -33,10 +34,15 @@ namespace Beam {
         std::unique_ptr<EvaluatorNode<Object>> evaluator,
         MemberAccessor accessor);
 
+      /** Returns <code>true</code> iff the object accessed is a constant. */
+      bool is_constant() const;
+
       Result eval() override;
+      bool eval_batch(
+        const EvaluatorBatch& batch, std::span<Result> results) override;
 
     private:
-      std::unique_ptr<EvaluatorNode<Object>> m_evaluator;
+      EvaluatorOperand<Object> m_evaluator;
       MemberAccessor m_accessor;
   };
 
@@ -52,10 +58,42 @@ namespace Beam {
     : m_evaluator(std::move(evaluator)),
       m_accessor(accessor) {}
 
+  template<typename T, typename M>
+  bool MemberAccessEvaluatorNode<T, M>::is_constant() const {
+    return m_evaluator.is_constant();
+  }
+
   template<typename T, typename M>
   typename MemberAccessEvaluatorNode<T, M>::Result
       MemberAccessEvaluatorNode<T, M>::eval() {
-    return m_evaluator->eval().*m_accessor;
+    if(auto object = m_evaluator.get_address()) {
+      return object->*m_accessor;
+    }
+    return m_evaluator.eval().*m_accessor;
+  }
+
+  template<typename T, typename M>
+  bool MemberAccessEvaluatorNode<T, M>::eval_batch(
+      const EvaluatorBatch& batch, std::span<Result> results) {
+    if constexpr(std::is_copy_assignable_v<Result>) {
+      auto index = m_evaluator.get_parameter_index();
+      if(index != -1) {
+        for(auto i = std::size_t(0); i != results.size(); ++i) {
+          results[i] = static_cast<const Object*>(
+            batch.get_parameter(i, index))->*m_accessor;
+        }
+        return true;
+      }
+      if(!m_evaluator.load(batch)) {
+        return false;
+      }
+      for(auto i = std::size_t(0); i != results.size(); ++i) {
+        results[i] = m_evaluator.get(i).*m_accessor;
+      }
+      return true;
+    } else {
+      return false;
+    }
   }
 }
 
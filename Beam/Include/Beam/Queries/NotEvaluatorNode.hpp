@@ -1,7 +1,8 @@
 #ifndef BEAM_NOT_EVALUATOR_NODE_HPP
 #define BEAM_NOT_EVALUATOR_NODE_HPP
+#include <span>
 #include <utility>
-#include "Beam/Queries/EvaluatorNode.hpp"
+#include "Beam/Queries/EvaluatorOperand.hpp"
 
 namespace Beam {
 
@@ -16,18 +17,38 @@ namespace Beam {
        */
       explicit NotEvaluatorNode(std::unique_ptr<EvaluatorNode<bool>> operand);
 
+      /** Returns <code>true</code> iff the operand is a constant. */
+      bool is_constant() const;
+
       bool eval() override;
+      bool eval_batch(
+        const EvaluatorBatch& batch, std::span<bool> results) override;
 
     private:
-      std::unique_ptr<EvaluatorNode<bool>> m_operand;
+      EvaluatorOperand<bool> m_operand;
   };
 
   inline NotEvaluatorNode::NotEvaluatorNode(
     std::unique_ptr<EvaluatorNode<bool>> operand)
     : m_operand(std::move(operand)) {}
 
+  inline bool NotEvaluatorNode::is_constant() const {
+    return m_operand.is_constant();
+  }
+
   inline bool NotEvaluatorNode::eval() {
-    return !m_operand->eval();
+    return !m_operand.eval();
+  }
+
+  inline bool NotEvaluatorNode::eval_batch(
+      const EvaluatorBatch& batch, std::span<bool> results) {
+    if(!m_operand.load(batch)) {
+      return false;
+    }
+    for(auto i = std::size_t(0); i != results.size(); ++i) {
+      results[i] = !m_operand.get(i);
+    }
+    return true;
   }
 }
 
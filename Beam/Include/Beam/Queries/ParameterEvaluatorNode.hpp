@@ -1,5 +1,6 @@
 #ifndef BEAM_PARAMETER_EVALUATOR_NODE_HPP
 #define BEAM_PARAMETER_EVALUATOR_NODE_HPP
+#include <type_traits>
 #include "Beam/Queries/ParameterExpression.hpp"
 #include "Beam/Queries/EvaluatorNode.hpp"
 
@@ -36,10 +37,15 @@ namespace Beam {
        */
       explicit ParameterEvaluatorNode(int index);
 
+      /** Returns the parameter currently being evaluated, without a copy. */
+      const Result& get_value() const;
+
       std::type_index get_type() const override;
       int get_index() const override;
       void set_parameter(const void** parameter) override;
       Result eval() override;
+      bool eval_batch(
+        const EvaluatorBatch& batch, std::span<Result> results) override;
 
     private:
       int m_index;
@@ -66,6 +72,12 @@ namespace Beam {
     : m_index(index),
       m_parameter(nullptr) {}
 
+  template<typename T>
+  const typename ParameterEvaluatorNode<T>::Result&
+      ParameterEvaluatorNode<T>::get_value() const {
+    return **m_parameter;
+  }
+
   template<typename T>
   std::type_index ParameterEvaluatorNode<T>::get_type() const {
     return EvaluatorNode<T>::get_type();
@@ -85,6 +97,20 @@ namespace Beam {
   typename ParameterEvaluatorNode<T>::Result ParameterEvaluatorNode<T>::eval() {
     return **m_parameter;
   }
+
+  template<typename T>
+  bool ParameterEvaluatorNode<T>::eval_batch(
+      const EvaluatorBatch& batch, std::span<Result> results) {
+    if constexpr(std::is_copy_assignable_v<Result>) {
+      for(auto i = std::size_t(0); i != results.size(); ++i) {
+        results[i] =
+          *static_cast<const Result*>(batch.get_parameter(i, m_index));
+      }
+      return true;
+    } else {
+      return false;
+    }
+  }
 }
 
 #endif
@@ -0,0 +1,540 @@
+#ifndef BEAM_PREDICATE_INDEX_HPP
+#define BEAM_PREDICATE_INDEX_HPP
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Beam/Queries/AndExpression.hpp"
+#include "Beam/Queries/ConstantExpression.hpp"
+#include "Beam/Queries/Evaluator.hpp"
+#include "Beam/Queries/EvaluatorTranslator.hpp"
+#include "Beam/Queries/FilteredQuery.hpp"
+#include "Beam/Queries/FunctionExpression.hpp"
+#include "Beam/Queries/MemberAccessExpression.hpp"
+#include "Beam/Queries/ParameterExpression.hpp"
+#include "Beam/Queries/StandardFunctionExpressions.hpp"
+#include "Beam/Utilities/Instantiate.hpp"
+
+namespace Beam {
+namespace Details {
+  template<typename T>
+  const T* try_as(const Expression& expression) {
+    return dynamic_cast<const T*>(&expression.as<VirtualExpression>());
+  }
+
+  inline bool is_predicate_key(const Expression& expression) {
+    if(auto parameter = try_as<ParameterExpression>(expression)) {
+      return parameter->get_index() == 0;
+    } else if(auto access = try_as<MemberAccessExpression>(expression)) {
+      return is_predicate_key(access->get_expression());
+    }
+    return false;
+  }
+
+  struct PredicateBound {
+    const ConstantExpression* m_value;
+    bool m_is_inclusive;
+  };
+
+  struct PredicateComparison {
+    const Expression* m_key;
+    const ConstantExpression* m_equals;
+    std::optional<PredicateBound> m_lower;
+    std::optional<PredicateBound> m_upper;
+  };
+
+  inline std::optional<PredicateComparison> parse_predicate_comparison(
+      const Expression& expression) {
+    auto function = try_as<FunctionExpression>(expression);
+    if(!function || function->get_parameters().size() != 2) {
+      return std::nullopt;
+    }
+    auto& left = function->get_parameters()[0];
+    auto& right = function->get_parameters()[1];
+    auto name = function->get_name();
+    auto key = &left;
+    auto constant = try_as<ConstantExpression>(right);
+    if(!constant) {
+      key = &right;
+      constant = try_as<ConstantExpression>(left);
+      if(name == LESS_NAME) {
+        name = GREATER_NAME;
+      } else if(name == LESS_EQUALS_NAME) {
+        name = GREATER_EQUALS_NAME;
+      } else if(name == GREATER_NAME) {
+        name = LESS_NAME;
+      } else if(name == GREATER_EQUALS_NAME) {
+        name = LESS_EQUALS_NAME;
+      }
+    }
+    if(!constant || !is_predicate_key(*key) ||
+        key->get_type() != constant->get_type()) {
+      return std::nullopt;
+    }
+    auto comparison = PredicateComparison(key, nullptr);
+    if(name == EQUALS_NAME) {
+      comparison.m_equals = constant;
+    } else if(name == LESS_NAME || name == LESS_EQUALS_NAME) {
+      comparison.m_upper = PredicateBound(constant, name == LESS_EQUALS_NAME);
+    } else if(name == GREATER_NAME || name == GREATER_EQUALS_NAME) {
+      comparison.m_lower =
+        PredicateBound(constant, name == GREATER_EQUALS_NAME);
+    } else {
+      return std::nullopt;
+    }
+    return comparison;
+  }
+
+  inline std::string get_predicate_key_name(const Expression& expression) {
+    auto name = std::ostringstream();
+    name << expression << ':' << expression.get_type().name();
+    return std::move(name).str();
+  }
+}
+
+  /**
+   * Tests a value against a set of filters, testing each distinct predicate
+   * only once. Constant filters, equality between a key and a constant, and
+   * ranges of constants over a key are indexed by key, where a key is the
+   * parameter or one of its members, so that a key is evaluated only once
+   * per value regardless of how many filters use it. All other filters are
+   * evaluated individually.
+   * Keys are recognized by the shape of the Expression, not by the
+   * Translator. A key must be a ParameterExpression with index 0 or a chain
+   * of MemberAccessExpressions over one. Comparisons against anything else
+   * that a custom Translator supports, such as a FunctionExpression or
+   * another parameter, still give correct results but are not indexed.
+   * @tparam V The type of value to test.
+   * @tparam Q The types supported by the filters.
+   */
+  template<typename V, typename Q = QueryTypes>
+  class PredicateIndex {
+    public:
+
+      /** The type of value to test. */
+      using Value = V;
+
+      /** The types supported by the filters. */
+      using QueryTypes = Q;
+
+      /**
+       * The type of function used to translate an Expression.
+       * @param expression The Expression to translate.
+       * @return The Evaluator representing the <i>expression</i>.
+       */
+      using Translator = std::function<
+        std::unique_ptr<Evaluator> (const Expression& expression)>;
+
+      /** Constructs a PredicateIndex using an EvaluatorTranslator. */
+      PredicateIndex();
+
+      /**
+       * Constructs a PredicateIndex with a custom Translator.
+       * @param translator The Translator to use.
+       */
+      explicit PredicateIndex(Translator translator);
+
+      /**
+       * Adds a filter to the index.
+       * @param filter The filter to add.
+       * @return The id of the predicate the <i>filter</i> is tested by, which
+       *         is shared by equivalent filters.
+       */
+      int add(const Expression& filter);
+
+      /**
+       * Removes a filter from the index.
+       * @param id The id returned when the filter was added.
+       */
+      void remove(int id);
+
+      /**
+       * Tests a value against every predicate.
+       * @param value The value to test.
+       */
+      void test(const Value& value);
+
+      /**
+       * Returns <code>true</code> iff a predicate passed the most recently
+       * tested value.
+       * @param id The id of the predicate.
+       */
+      bool is_match(int id) const;
+
+    private:
+      class Key {
+        public:
+          virtual ~Key() = default;
+          virtual int add(const Details::PredicateComparison& comparison,
+            PredicateIndex& index) = 0;
+          virtual void remove(int id) = 0;
+          virtual bool is_empty() const = 0;
+          virtual void test(const Value& value, PredicateIndex& index) = 0;
+      };
+      template<typename K>
+      class TypedKey : public Key {
+        public:
+          explicit TypedKey(std::unique_ptr<Evaluator> evaluator);
+          int add(const Details::PredicateComparison& comparison,
+            PredicateIndex& index) override;
+          void remove(int id) override;
+          bool is_empty() const override;
+          void test(const Value& value, PredicateIndex& index) override;
+
+        private:
+          struct Bound {
+            K m_value;
+            bool m_is_inclusive;
+
+            bool operator ==(const Bound&) const = default;
+          };
+          struct Interval {
+            std::optional<Bound> m_lower;
+            std::optional<Bound> m_upper;
+            int m_id;
+          };
+          std::unique_ptr<Evaluator> m_evaluator;
+          std::map<K, int> m_equals;
+          std::vector<Interval> m_intervals;
+
+          static bool is_indexable(const K& value);
+          static std::optional<Bound> make_bound(
+            const std::optional<Details::PredicateBound>& bound);
+          static bool is_before(const Interval& left, const Interval& right);
+      };
+      struct KeyBuilder {
+        using type = typename QueryTypes::ComparableTypes;
+
+        template<typename K>
+        std::unique_ptr<Key> operator ()(
+            std::unique_ptr<Evaluator> evaluator) const {
+          return std::make_unique<TypedKey<K>>(std::move(evaluator));
+        }
+      };
+      struct Predicate {
+        int m_count;
+        std::uint64_t m_match;
+        Key* m_key;
+        std::unique_ptr<Evaluator> m_filter;
+      };
+      Translator m_translator;
+      std::vector<Predicate> m_predicates;
+      std::vector<int> m_free_ids;
+      std::vector<int> m_filter_ids;
+      std::unordered_map<std::string, std::unique_ptr<Key>> m_keys;
+      int m_true_id;
+      int m_false_id;
+      std::uint64_t m_epoch;
+
+      PredicateIndex(const PredicateIndex&) = delete;
+      PredicateIndex& operator =(const PredicateIndex&) = delete;
+      int make_predicate(Key* key);
+      void mark(int id);
+      int add_constant(bool value);
+      int add_comparison(const Details::PredicateComparison& comparison);
+      std::optional<Details::PredicateComparison> parse_range(
+        const Expression& filter) const;
+  };
+
+  template<typename V, typename Q>
+  PredicateIndex<V, Q>::PredicateIndex()
+    : PredicateIndex([] (const auto& expression) {
+        return translate<EvaluatorTranslator<QueryTypes>>(expression);
+      }) {}
+
+  template<typename V, typename Q>
+  PredicateIndex<V, Q>::PredicateIndex(Translator translator)
+    : m_translator(std::move(translator)),
+      m_true_id(-1),
+      m_false_id(-1),
+      m_epoch(1) {}
+
+  template<typename V, typename Q>
+  int PredicateIndex<V, Q>::add(const Expression& filter) {
+    if(auto constant = Details::try_as<ConstantExpression>(filter);
+        constant && constant->get_type() == typeid(bool)) {
+      return add_constant(constant->get_value().template as<bool>());
+    }
+    auto comparison = Details::parse_predicate_comparison(filter);
+    if(!comparison) {
+      comparison = parse_range(filter);
+    }
+    if(comparison) {
+      if(auto id = add_comparison(*comparison); id != -1) {
+        return id;
+      }
+    }
+    auto id = make_predicate(nullptr);
+    m_predicates[id].m_filter = m_translator(filter);
+    m_filter_ids.push_back(id);
+    return id;
+  }
+
+  template<typename V, typename Q>
+  void PredicateIndex<V, Q>::remove(int id) {
+    auto& predicate = m_predicates[id];
+    --predicate.m_count;
+    if(predicate.m_count != 0) {
+      return;
+    }
+    if(id == m_true_id) {
+      m_true_id = -1;
+    } else if(id == m_false_id) {
+      m_false_id = -1;
+    } else if(predicate.m_key) {
+      predicate.m_key->remove(id);
+      if(predicate.m_key->is_empty()) {
+        std::erase_if(m_keys, [&] (const auto& key) {
+          return key.second.get() == predicate.m_key;
+        });
+      }
+      predicate.m_key = nullptr;
+    } else {
+      predicate.m_filter = nullptr;
+      std::erase(m_filter_ids, id);
+    }
+    m_free_ids.push_back(id);
+  }
+
+  template<typename V, typename Q>
+  void PredicateIndex<V, Q>::test(const Value& value) {
+    ++m_epoch;
+    if(m_true_id != -1) {
+      mark(m_true_id);
+    }
+    for(auto& key : m_keys) {
+      key.second->test(value, *this);
+    }
+    for(auto id : m_filter_ids) {
+      if(test_filter(*m_predicates[id].m_filter, value)) {
+        mark(id);
+      }
+    }
+  }
+
+  template<typename V, typename Q>
+  bool PredicateIndex<V, Q>::is_match(int id) const {
+    return m_predicates[id].m_match == m_epoch;
+  }
+
+  template<typename V, typename Q>
+  int PredicateIndex<V, Q>::make_predicate(Key* key) {
+    auto id = 0;
+    if(m_free_ids.empty()) {
+      id = static_cast<int>(m_predicates.size());
+      m_predicates.emplace_back();
+    } else {
+      id = m_free_ids.back();
+      m_free_ids.pop_back();
+    }
+    auto& predicate = m_predicates[id];
+    predicate.m_count = 1;
+    predicate.m_match = 0;
+    predicate.m_key = key;
+    return id;
+  }
+
+  template<typename V, typename Q>
+  void PredicateIndex<V, Q>::mark(int id) {
+    m_predicates[id].m_match = m_epoch;
+  }
+
+  template<typename V, typename Q>
+  int PredicateIndex<V, Q>::add_constant(bool value) {
+    auto& id = value ? m_true_id : m_false_id;
+    if(id == -1) {
+      id = make_predicate(nullptr);
+    } else {
+      ++m_predicates[id].m_count;
+    }
+    return id;
+  }
+
+  template<typename V, typename Q>
+  int PredicateIndex<V, Q>::add_comparison(
+      const Details::PredicateComparison& comparison) {
+    auto name = Details::get_predicate_key_name(*comparison.m_key);
+    auto key = m_keys.find(name);
+    if(key == m_keys.end()) {
+      auto evaluator = m_translator(*comparison.m_key);
+      try {
+        key = m_keys.emplace(std::move(name), instantiate<KeyBuilder>(
+          comparison.m_key->get_type())(std::move(evaluator))).first;
+      } catch(const std::invalid_argument&) {
+        return -1;
+      }
+    }
+    auto id = key->second->add(comparison, *this);
+    if(key->second->is_empty()) {
+      m_keys.erase(key);
+    }
+    return id;
+  }
+
+  template<typename V, typename Q>
+  std::optional<Details::PredicateComparison>
+      PredicateIndex<V, Q>::parse_range(const Expression& filter) const {
+    auto conjunction = Details::try_as<AndExpression>(filter);
+    if(!conjunction) {
+      return std::nullopt;
+    }
+    auto left = Details::parse_predicate_comparison(conjunction->get_left());
+    auto right = Details::parse_predicate_comparison(conjunction->get_right());
+    if(!left || !right || left->m_equals || right->m_equals ||
+        Details::get_predicate_key_name(*left->m_key) !=
+          Details::get_predicate_key_name(*right->m_key)) {
+      return std::nullopt;
+    }
+    if(left->m_lower && !left->m_upper && !right->m_lower && right->m_upper) {
+      left->m_upper = right->m_upper;
+      return left;
+    } else if(!left->m_lower && left->m_upper && right->m_lower &&
+        !right->m_upper) {
+      left->m_lower = right->m_lower;
+      return left;
+    }
+    return std::nullopt;
+  }
+
+  template<typename V, typename Q>
+  template<typename K>
+  PredicateIndex<V, Q>::TypedKey<K>::TypedKey(
+    std::unique_ptr<Evaluator> evaluator)
+    : m_evaluator(std::move(evaluator)) {}
+
+  template<typename V, typename Q>
+  template<typename K>
+  int PredicateIndex<V, Q>::TypedKey<K>::add(
+      const Details::PredicateComparison& comparison, PredicateIndex& index) {
+    if(comparison.m_equals) {
+      auto& value = comparison.m_equals->get_value().template as<K>();
+      if(!is_indexable(value)) {
+        return -1;
+      }
+      auto equals = m_equals.find(value);
+      if(equals != m_equals.end()) {
+        ++index.m_predicates[equals->second].m_count;
+        return equals->second;
+      }
+      auto id = index.make_predicate(this);
+      m_equals.emplace(value, id);
+      return id;
+    }
+    auto interval = Interval(make_bound(comparison.m_lower),
+      make_bound(comparison.m_upper), -1);
+    if((interval.m_lower && !is_indexable(interval.m_lower->m_value)) ||
+        (interval.m_upper && !is_indexable(interval.m_upper->m_value))) {
+      return -1;
+    }
+    auto i = std::find_if(m_intervals.begin(), m_intervals.end(),
+      [&] (const auto& existing) {
+        return existing.m_lower == interval.m_lower &&
+          existing.m_upper == interval.m_upper;
+      });
+    if(i != m_intervals.end()) {
+      ++index.m_predicates[i->m_id].m_count;
+      return i->m_id;
+    }
+    interval.m_id = index.make_predicate(this);
+    m_intervals.insert(std::upper_bound(
+      m_intervals.begin(), m_intervals.end(), interval, is_before), interval);
+    return interval.m_id;
+  }
+
+  template<typename V, typename Q>
+  template<typename K>
+  void PredicateIndex<V, Q>::TypedKey<K>::remove(int id) {
+    std::erase_if(m_equals, [&] (const auto& equals) {
+      return equals.second == id;
+    });
+    std::erase_if(m_intervals, [&] (const auto& interval) {
+      return interval.m_id == id;
+    });
+  }
+
+  template<typename V, typename Q>
+  template<typename K>
+  bool PredicateIndex<V, Q>::TypedKey<K>::is_empty() const {
+    return m_equals.empty() && m_intervals.empty();
+  }
+
+  template<typename V, typename Q>
+  template<typename K>
+  void PredicateIndex<V, Q>::TypedKey<K>::test(
+      const Value& value, PredicateIndex& index) {
+    auto key = std::optional<K>();
+    try {
+      key.emplace(m_evaluator->template eval<K>(value));
+    } catch(const std::exception&) {
+      return;
+    }
+    if(!is_indexable(*key)) {
+      return;
+    }
+    if(auto equals = m_equals.find(*key); equals != m_equals.end()) {
+      index.mark(equals->second);
+    }
+    for(auto& interval : m_intervals) {
+      auto& lower = interval.m_lower;
+      if(lower && (lower->m_is_inclusive ? *key < lower->m_value :
+          !(lower->m_value < *key))) {
+        break;
+      }
+      auto& upper = interval.m_upper;
+      if(!upper || (upper->m_is_inclusive ? !(upper->m_value < *key) :
+          *key < upper->m_value)) {
+        index.mark(interval.m_id);
+      }
+    }
+  }
+
+  template<typename V, typename Q>
+  template<typename K>
+  bool PredicateIndex<V, Q>::TypedKey<K>::is_indexable(const K& value) {
+    if constexpr(std::is_floating_point_v<K>) {
+      return !std::isnan(value);
+    } else {
+      return true;
+    }
+  }
+
+  template<typename V, typename Q>
+  template<typename K>
+  std::optional<typename PredicateIndex<V, Q>::template TypedKey<K>::Bound>
+      PredicateIndex<V, Q>::TypedKey<K>::make_bound(
+        const std::optional<Details::PredicateBound>& bound) {
+    if(!bound) {
+      return std::nullopt;
+    }
+    return Bound(
+      bound->m_value->get_value().template as<K>(), bound->m_is_inclusive);
+  }
+
+  template<typename V, typename Q>
+  template<typename K>
+  bool PredicateIndex<V, Q>::TypedKey<K>::is_before(
+      const Interval& left, const Interval& right) {
+    if(!right.m_lower) {
+      return false;
+    } else if(!left.m_lower) {
+      return true;
+    } else if(left.m_lower->m_value < right.m_lower->m_value) {
+      return true;
+    } else if(right.m_lower->m_value < left.m_lower->m_value) {
+      return false;
+    }
+    return left.m_lower->m_is_inclusive && !right.m_lower->m_is_inclusive;
+  }
+}
+
+#endif
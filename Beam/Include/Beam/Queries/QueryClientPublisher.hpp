@@ -1,6 +1,8 @@
 #ifndef BEAM_QUERY_CLIENT_PUBLISHER_HPP
 #define BEAM_QUERY_CLIENT_PUBLISHER_HPP
+#include <algorithm>
 #include <exception>
+#include <limits>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -13,6 +15,7 @@
 #include "Beam/Queries/IndexedValue.hpp"
 #include "Beam/Queries/SequencedValue.hpp"
 #include "Beam/Queries/SequencedValuePublisher.hpp"
+#include "Beam/Queries/SnapshotLimit.hpp"
 #include "Beam/Queues/ConverterQueueWriter.hpp"
 #include "Beam/Routines/RoutineHandlerGroup.hpp"
 #include "Beam/Threading/Sync.hpp"
@@ -69,6 +72,22 @@ namespace Beam {
       explicit QueryClientPublisher(
         Ref<ServiceProtocolClientHandler> client_handler);
 
+      /**
+       * Constructs a QueryClientPublisher that streams snapshots in pages.
+       * Rather than loading a query's snapshot with a single request, it is
+       * loaded with a series of requests returning at most <i>page_size</i>
+       * values each, and every page is published as soon as it arrives.
+       * Only the final request subscribes to real time data, so that the
+       * server commits the subscription at the end of the last page.
+       * Queries whose snapshot is limited from the tail are loaded with a
+       * single request.
+       * @param client_handler The ServiceProtocolClientHandler providing
+       *        ServiceProtocolClients to submit queries to.
+       * @param page_size The maximum number of values to request at a time.
+       */
+      QueryClientPublisher(
+        Ref<ServiceProtocolClientHandler> client_handler, int page_size);
+
       ~QueryClientPublisher();
 
       /**
@@ -115,19 +134,30 @@ namespace Beam {
       using PublisherList = SynchronizedVector<std::shared_ptr<Publisher>>;
       using Publishers = std::unordered_map<Index, PublisherList>;
       ServiceProtocolClientHandler* m_client_handler;
+      int m_page_size;
       SynchronizedMap<Publishers> m_publishers;
       Sync<std::exception_ptr> m_break_exception;
       RoutineHandlerGroup m_query_routines;
 
       QueryClientPublisher(const QueryClientPublisher&) = delete;
       QueryClientPublisher& operator =(const QueryClientPublisher&) = delete;
+      template<typename F>
+      int load(ServiceProtocolClient& client, const Query& query, F&& f);
   };
 
   template<typename V, typename Q, typename E, typename C, typename S,
     typename M>
   QueryClientPublisher<V, Q, E, C, S, M>::QueryClientPublisher(
     Ref<ServiceProtocolClientHandler> client_handler)
-    : m_client_handler(client_handler.get()) {}
+    : QueryClientPublisher(
+        std::move(client_handler), std::numeric_limits<int>::max()) {}
+
+  template<typename V, typename Q, typename E, typename C, typename S,
+    typename M>
+  QueryClientPublisher<V, Q, E, C, S, M>::QueryClientPublisher(
+    Ref<ServiceProtocolClientHandler> client_handler, int page_size)
+    : m_client_handler(client_handler.get()),
+      m_page_size(std::max(1, page_size)) {}
 
   template<typename V, typename Q, typename E, typename C, typename S,
     typename M>
@@ -158,10 +188,10 @@ namespace Beam {
             });
           if(send_request) {
             auto client = m_client_handler->get_client();
-            auto result = client->template send_request<QueryService>(query);
-            publisher->push_snapshot(
-              result.m_snapshot.begin(), result.m_snapshot.end());
-            publisher->end_snapshot(result.m_id);
+            auto id = load(*client, query, [&] (auto& snapshot) {
+              publisher->push_snapshot(snapshot.begin(), snapshot.end());
+            });
+            publisher->end_snapshot(id);
           }
         } catch(const std::exception&) {
           publisher->close();
@@ -172,10 +202,11 @@ namespace Beam {
       m_query_routines.spawn([=, this, queue = std::move(queue)] () mutable {
         try {
           auto client = m_client_handler->get_client();
-          auto result = client->template send_request<QueryService>(query);
-          for(auto& value : result.m_snapshot) {
-            queue.push(std::move(value));
-          }
+          load(*client, query, [&] (auto& snapshot) {
+            for(auto& value : snapshot) {
+              queue.push(std::move(value));
+            }
+          });
         } catch(const std::exception&) {}
         queue.close();
       });
@@ -234,10 +265,10 @@ namespace Beam {
       auto& publisher = std::get<1>(disconnected_publisher);
       try {
         auto query = publisher->begin_recovery();
-        auto result = client.template send_request<QueryService>(query);
-        publisher->push_snapshot(
-          result.m_snapshot.begin(), result.m_snapshot.end());
-        publisher->end_recovery(result.m_id);
+        auto id = load(client, query, [&] (auto& snapshot) {
+          publisher->push_snapshot(snapshot.begin(), snapshot.end());
+        });
+        publisher->end_recovery(id);
       } catch(const std::exception&) {
         publisher->close();
         publisher_list.erase(publisher);
@@ -274,6 +305,58 @@ namespace Beam {
       });
     });
   }
+
+  template<typename V, typename Q, typename E, typename C, typename S,
+    typename M>
+  template<typename F>
+  int QueryClientPublisher<V, Q, E, C, S, M>::load(
+      ServiceProtocolClient& client, const Query& query, F&& f) {
+    auto limit = query.get_snapshot_limit();
+    if(limit.get_type() == SnapshotLimit::Type::TAIL ||
+        limit.get_size() <= m_page_size) {
+      auto result = client.template send_request<QueryService>(query);
+      f(result.m_snapshot);
+      return result.m_id;
+    }
+    auto is_real_time = query.get_range().get_end() == Sequence::LAST;
+    auto end = [&] () -> Range::Point {
+      if(is_real_time) {
+        return Sequence::PRESENT;
+      }
+      return query.get_range().get_end();
+    }();
+    auto page_query = query;
+    auto start = query.get_range().get_start();
+    auto remaining = limit.get_size();
+    while(remaining > m_page_size) {
+      page_query.set_range(start, end);
+      page_query.set_snapshot_limit(SnapshotLimit::from_head(m_page_size));
+      auto result = client.template send_request<QueryService>(page_query);
+      auto size = static_cast<int>(result.m_snapshot.size());
+      if(size != 0) {
+        start = increment(result.m_snapshot.back().get_sequence());
+        f(result.m_snapshot);
+      }
+      if(limit != SnapshotLimit::UNLIMITED) {
+        remaining -= size;
+      }
+      if(size < m_page_size) {
+        if(!is_real_time) {
+          return -1;
+        }
+        break;
+      }
+    }
+    page_query.set_range(start, query.get_range().get_end());
+    if(limit == SnapshotLimit::UNLIMITED) {
+      page_query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    } else {
+      page_query.set_snapshot_limit(SnapshotLimit::from_head(remaining));
+    }
+    auto result = client.template send_request<QueryService>(page_query);
+    f(result.m_snapshot);
+    return result.m_id;
+  }
 }
 
 #endif
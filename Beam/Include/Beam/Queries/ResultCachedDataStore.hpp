@@ -0,0 +1,383 @@
+#ifndef BEAM_RESULT_CACHED_DATA_STORE_HPP
+#define BEAM_RESULT_CACHED_DATA_STORE_HPP
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/functional/hash.hpp>
+#include "Beam/IO/OpenState.hpp"
+#include "Beam/Pointers/Dereference.hpp"
+#include "Beam/Pointers/LocalPtr.hpp"
+#include "Beam/Queries/BatchLoad.hpp"
+#include "Beam/Queries/CacheBudget.hpp"
+#include "Beam/Queries/Evaluator.hpp"
+#include "Beam/Queries/ExpressionSignature.hpp"
+#include "Beam/Queries/FilteredQuery.hpp"
+#include "Beam/Queries/Range.hpp"
+#include "Beam/Queries/SnapshotLimit.hpp"
+#include "Beam/Threading/Sync.hpp"
+
+namespace Beam {
+
+  /**
+   * Caches the results of queries made to a data store, so that repeating a
+   * query with the same index, range, snapshot limit and filter doesn't load
+   * it again. Storing a value patches the cached results it extends and
+   * discards the ones it would otherwise change.
+   * @tparam D The type of data store to cache.
+   * @tparam F The type of EvaluatorTranslator used for filtering values.
+   */
+  template<typename D,
+    typename F = typename dereference_t<D>::EvaluatorTranslatorFilter>
+  class ResultCachedDataStore {
+    public:
+
+      /** The type of data store to cache. */
+      using DataStore = dereference_t<D>;
+
+      /** The type of query used to load values. */
+      using Query = typename DataStore::Query;
+
+      /** The type of index used. */
+      using Index = typename DataStore::Index;
+
+      /** The type of value to store. */
+      using Value = typename DataStore::Value;
+
+      /** The SequencedValue to store. */
+      using SequencedValue = typename DataStore::SequencedValue;
+
+      /** The IndexedValue to store. */
+      using IndexedValue = typename DataStore::IndexedValue;
+
+      /** The type of EvaluatorTranslator used for filtering values. */
+      using EvaluationTranslatorFilter = F;
+
+      /**
+       * Constructs a ResultCachedDataStore.
+       * @param data_store Initializes the data store to cache.
+       * @param capacity The estimated number of bytes that may be cached,
+       *        evicting results not used since the last CLOCK sweep once
+       *        exceeded.
+       * @param estimator Estimates the heap memory owned by each value.
+       */
+      template<Initializes<D> DF>
+      ResultCachedDataStore(DF&& data_store, std::size_t capacity,
+        HeapSizeEstimator<Value> estimator = {});
+
+      ~ResultCachedDataStore();
+
+      /** Returns the hit, miss and eviction counts of the cache. */
+      CacheStatistics get_statistics() const;
+
+      std::vector<SequencedValue> load(const Query& query);
+      std::vector<std::vector<SequencedValue>> load(
+        std::span<const Query> queries);
+      void store(const IndexedValue& value);
+      void store(const std::vector<IndexedValue>& values);
+      void close();
+
+    private:
+      struct Key {
+        Range m_range;
+        SnapshotLimit m_snapshot_limit;
+        ExpressionSignature m_filter;
+
+        bool operator ==(const Key&) const = default;
+      };
+      struct KeyHash {
+        std::size_t operator ()(const Key& key) const;
+      };
+      struct Result : CacheBudget::Block {
+        ResultCachedDataStore* m_owner;
+        Index m_index;
+        Key m_key;
+        std::unique_ptr<Evaluator> m_filter;
+        std::vector<SequencedValue> m_values;
+        std::size_t m_heap_size;
+
+        Result(ResultCachedDataStore& owner, Index index, Key key,
+          std::unique_ptr<Evaluator> filter,
+          std::vector<SequencedValue> values);
+        std::size_t get_memory_usage() const;
+        void evict() override;
+      };
+      struct IndexEntry {
+        std::uint64_t m_version = 0;
+        int m_pending_loads = 0;
+        std::unordered_map<Key, std::shared_ptr<Result>, KeyHash> m_results;
+      };
+      enum class Update {
+        NONE,
+        PATCH,
+        DISCARD
+      };
+      using IndexEntries = std::unordered_map<Index, IndexEntry>;
+      local_ptr_t<D> m_data_store;
+      HeapSizeEstimator<Value> m_estimator;
+      CacheBudget m_budget;
+      Sync<IndexEntries> m_entries;
+      OpenState m_open_state;
+
+      ResultCachedDataStore(const ResultCachedDataStore&) = delete;
+      ResultCachedDataStore& operator =(const ResultCachedDataStore&) = delete;
+      static void erase_if_unused(
+        IndexEntries& entries, typename IndexEntries::iterator i);
+      std::size_t get_heap_size(const SequencedValue& value) const;
+      Update update(Result& result, const IndexedValue& value) const;
+      void update(std::span<const IndexedValue> values);
+  };
+
+  template<typename D, typename F>
+  std::size_t ResultCachedDataStore<D, F>::KeyHash::operator ()(
+      const Key& key) const {
+    auto seed = hash_value(key.m_range);
+    boost::hash_combine(
+      seed, static_cast<int>(key.m_snapshot_limit.get_type()));
+    boost::hash_combine(seed, key.m_snapshot_limit.get_size());
+    boost::hash_combine(seed, key.m_filter.get_hash());
+    return seed;
+  }
+
+  template<typename D, typename F>
+  ResultCachedDataStore<D, F>::Result::Result(ResultCachedDataStore& owner,
+    Index index, Key key, std::unique_ptr<Evaluator> filter,
+    std::vector<SequencedValue> values)
+    : m_owner(&owner),
+      m_index(std::move(index)),
+      m_key(std::move(key)),
+      m_filter(std::move(filter)),
+      m_values(std::move(values)),
+      m_heap_size(0) {
+    for(auto& value : m_values) {
+      m_heap_size += m_owner->get_heap_size(value);
+    }
+  }
+
+  template<typename D, typename F>
+  std::size_t ResultCachedDataStore<D, F>::Result::get_memory_usage() const {
+    return sizeof(Result) + m_values.capacity() * sizeof(SequencedValue) +
+      m_heap_size;
+  }
+
+  template<typename D, typename F>
+  void ResultCachedDataStore<D, F>::Result::evict() {
+    m_owner->m_entries.with([&] (auto& entries) {
+      auto i = entries.find(m_index);
+      if(i == entries.end()) {
+        return;
+      }
+      auto j = i->second.m_results.find(m_key);
+      if(j != i->second.m_results.end() && j->second.get() == this) {
+        i->second.m_results.erase(j);
+        erase_if_unused(entries, i);
+      }
+    });
+  }
+
+  template<typename D, typename F>
+  template<Initializes<D> DF>
+  ResultCachedDataStore<D, F>::ResultCachedDataStore(DF&& data_store,
+    std::size_t capacity, HeapSizeEstimator<Value> estimator)
+    : m_data_store(std::forward<DF>(data_store)),
+      m_estimator(std::move(estimator)),
+      m_budget(capacity) {}
+
+  template<typename D, typename F>
+  ResultCachedDataStore<D, F>::~ResultCachedDataStore() {
+    close();
+  }
+
+  template<typename D, typename F>
+  CacheStatistics ResultCachedDataStore<D, F>::get_statistics() const {
+    return m_budget.get_statistics();
+  }
+
+  template<typename D, typename F>
+  std::vector<typename ResultCachedDataStore<D, F>::SequencedValue>
+      ResultCachedDataStore<D, F>::load(const Query& query) {
+    auto key = Key(query.get_range(), query.get_snapshot_limit(),
+      ExpressionSignature(query.get_filter()));
+    if(!key.m_filter.is_comparable()) {
+      return m_data_store->load(query);
+    }
+    auto version = std::uint64_t(0);
+    auto cached_values = m_entries.with(
+      [&] (auto& entries) -> std::optional<std::vector<SequencedValue>> {
+        auto& entry = entries[query.get_index()];
+        auto i = entry.m_results.find(key);
+        if(i == entry.m_results.end()) {
+          version = entry.m_version;
+          ++entry.m_pending_loads;
+          return std::nullopt;
+        }
+        i->second->touch();
+        return i->second->m_values;
+      });
+    if(cached_values) {
+      m_budget.record_hit();
+      return std::move(*cached_values);
+    }
+    m_budget.record_miss();
+    auto end_load = [&] (auto& entries) -> IndexEntry& {
+      auto i = entries.find(query.get_index());
+      --i->second.m_pending_loads;
+      return i->second;
+    };
+    auto values = std::vector<SequencedValue>();
+    auto result = std::shared_ptr<Result>();
+    try {
+      values = m_data_store->load(query);
+      result = std::make_shared<Result>(*this, query.get_index(),
+        std::move(key), translate<F>(query.get_filter()), values);
+    } catch(const std::exception&) {
+      m_entries.with([&] (auto& entries) {
+        end_load(entries);
+        erase_if_unused(entries, entries.find(query.get_index()));
+      });
+      throw;
+    }
+    auto is_inserted = m_entries.with([&] (auto& entries) {
+      auto& entry = end_load(entries);
+      if(entry.m_version == version &&
+          entry.m_results.try_emplace(result->m_key, result).second) {
+        return true;
+      }
+      erase_if_unused(entries, entries.find(query.get_index()));
+      return false;
+    });
+    if(is_inserted) {
+      m_budget.add(*result, result->get_memory_usage());
+      auto is_cached = m_entries.with([&] (auto& entries) {
+        auto i = entries.find(query.get_index());
+        if(i == entries.end()) {
+          return false;
+        }
+        auto j = i->second.m_results.find(result->m_key);
+        return j != i->second.m_results.end() && j->second == result;
+      });
+      if(!is_cached) {
+        m_budget.remove(*result);
+      }
+    }
+    return values;
+  }
+
+  template<typename D, typename F>
+  std::vector<std::vector<typename ResultCachedDataStore<D, F>::SequencedValue>>
+      ResultCachedDataStore<D, F>::load(std::span<const Query> queries) {
+    return load_concurrently(queries, [&] (const auto& query) {
+      return load(query);
+    });
+  }
+
+  template<typename D, typename F>
+  void ResultCachedDataStore<D, F>::store(const IndexedValue& value) {
+    m_data_store->store(value);
+    update(std::span(&value, 1));
+  }
+
+  template<typename D, typename F>
+  void ResultCachedDataStore<D, F>::store(
+      const std::vector<IndexedValue>& values) {
+    m_data_store->store(values);
+    update(values);
+  }
+
+  template<typename D, typename F>
+  void ResultCachedDataStore<D, F>::close() {
+    m_open_state.close();
+  }
+
+  template<typename D, typename F>
+  void ResultCachedDataStore<D, F>::erase_if_unused(
+      IndexEntries& entries, typename IndexEntries::iterator i) {
+    if(i->second.m_results.empty() && i->second.m_pending_loads == 0) {
+      entries.erase(i);
+    }
+  }
+
+  template<typename D, typename F>
+  std::size_t ResultCachedDataStore<D, F>::get_heap_size(
+      const SequencedValue& value) const {
+    if(!m_estimator) {
+      return 0;
+    }
+    return m_estimator(*value);
+  }
+
+  template<typename D, typename F>
+  typename ResultCachedDataStore<D, F>::Update
+      ResultCachedDataStore<D, F>::update(
+        Result& result, const IndexedValue& value) const {
+    auto& range = result.m_key.m_range;
+    auto& limit = result.m_key.m_snapshot_limit;
+    auto sequenced_value =
+      SequencedValue(value->get_value(), value.get_sequence());
+    if(!range_point_greater_or_equal(sequenced_value, range.get_start()) ||
+        !range_point_lesser_or_equal(sequenced_value, range.get_end())) {
+      return Update::NONE;
+    }
+    if(!result.m_values.empty() && sequenced_value.get_sequence() <=
+        result.m_values.back().get_sequence()) {
+      return Update::DISCARD;
+    }
+    if(limit.get_size() == 0 ||
+        !test_filter(*result.m_filter, *sequenced_value)) {
+      return Update::NONE;
+    }
+    if(limit.get_type() == SnapshotLimit::Type::HEAD) {
+      if(static_cast<int>(result.m_values.size()) >= limit.get_size()) {
+        return Update::NONE;
+      }
+    } else if(static_cast<int>(result.m_values.size()) >= limit.get_size()) {
+      result.m_heap_size -= get_heap_size(result.m_values.front());
+      result.m_values.erase(result.m_values.begin());
+    }
+    result.m_heap_size += get_heap_size(sequenced_value);
+    result.m_values.push_back(std::move(sequenced_value));
+    return Update::PATCH;
+  }
+
+  template<typename D, typename F>
+  void ResultCachedDataStore<D, F>::update(
+      std::span<const IndexedValue> values) {
+    auto discarded = std::vector<std::shared_ptr<Result>>();
+    auto patched =
+      std::vector<std::pair<std::shared_ptr<Result>, std::size_t>>();
+    m_entries.with([&] (auto& entries) {
+      for(auto& value : values) {
+        auto i = entries.find(value->get_index());
+        if(i == entries.end()) {
+          continue;
+        }
+        auto& entry = i->second;
+        ++entry.m_version;
+        for(auto j = entry.m_results.begin(); j != entry.m_results.end();) {
+          auto update = this->update(*j->second, value);
+          if(update == Update::DISCARD) {
+            discarded.push_back(std::move(j->second));
+            j = entry.m_results.erase(j);
+          } else {
+            if(update == Update::PATCH) {
+              patched.emplace_back(j->second, j->second->get_memory_usage());
+            }
+            ++j;
+          }
+        }
+        erase_if_unused(entries, i);
+      }
+    });
+    for(auto& result : discarded) {
+      m_budget.remove(*result);
+    }
+    for(auto& result : patched) {
+      m_budget.resize(*result.first, result.second);
+    }
+  }
+}
+
+#endif
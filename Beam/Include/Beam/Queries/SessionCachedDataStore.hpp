@@ -1,9 +1,12 @@
 #ifndef BEAM_SESSION_CACHED_DATA_STORE_HPP
 #define BEAM_SESSION_CACHED_DATA_STORE_HPP
+#include <span>
+#include <vector>
 #include "Beam/Collections/SynchronizedMap.hpp"
 #include "Beam/IO/OpenState.hpp"
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
+#include "Beam/Queries/BatchLoad.hpp"
 #include "Beam/Queries/SessionCachedDataStoreEntry.hpp"
 
 namespace Beam {
@@ -50,6 +53,8 @@ namespace Beam {
       ~SessionCachedDataStore();
 
       std::vector<SequencedValue> load(const Query& query);
+      std::vector<std::vector<SequencedValue>> load(
+        std::span<const Query> queries);
       void store(const IndexedValue& value);
       void store(const std::vector<IndexedValue>& values);
       void close();
@@ -87,6 +92,15 @@ namespace Beam {
     return cache.load(query);
   }
 
+  template<typename D, typename F>
+  std::vector<
+      std::vector<typename SessionCachedDataStore<D, F>::SequencedValue>>
+        SessionCachedDataStore<D, F>::load(std::span<const Query> queries) {
+    return load_concurrently(queries, [&] (const auto& query) {
+      return load(query);
+    });
+  }
+
   template<typename D, typename F>
   void SessionCachedDataStore<D, F>::store(const IndexedValue& value) {
     auto& cache = load_cache(value->get_index());
@@ -1,19 +1,25 @@
 #ifndef BEAM_SQL_DATA_STORE_HPP
 #define BEAM_SQL_DATA_STORE_HPP
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
+#include <ostream>
+#include <span>
 #include <vector>
 #include <Viper/Viper.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/throw_exception.hpp>
 #include "Beam/IO/ConnectException.hpp"
 #include "Beam/Pointers/Ref.hpp"
 #include "Beam/Queries/BasicQuery.hpp"
+#include "Beam/Queries/BatchLoad.hpp"
 #include "Beam/Queries/IndexedValue.hpp"
 #include "Beam/Queries/SequencedValue.hpp"
 #include "Beam/Queries/SqlTranslator.hpp"
 #include "Beam/Queries/SqlUtilities.hpp"
 #include "Beam/Sql/DatabaseConnectionPool.hpp"
 #include "Beam/Sql/PosixTimeToSqlDateTime.hpp"
+#include "Beam/Threading/Sync.hpp"
 
 namespace Beam {
 
@@ -30,8 +36,49 @@ namespace Beam {
     CREATE
   };
 
+  /** The default number of rows an SqlDataStore writes per insert. */
+  inline constexpr auto DEFAULT_MAX_ROWS_PER_INSERT = std::size_t(1000);
+
+  /** Stores the metrics of the rows written by an SqlDataStore. */
+  struct SqlWriteStatistics {
+
+    /** The number of rows written. */
+    std::uint64_t m_rows = 0;
+
+    /** The number of insert statements executed. */
+    std::uint64_t m_statements = 0;
+
+    /**
+     * The time during which at least one write was in progress, so that
+     * concurrent writes are only counted once.
+     */
+    boost::posix_time::time_duration m_elapsed;
+  };
+
   /**
-   * Loads and stores SequencedValue's in an SQL database.
+   * Returns the number of rows written per second, or 0 if no time was spent
+   * writing rows.
+   * @param statistics The statistics to compute the rate of.
+   */
+  inline double get_rows_per_second(const SqlWriteStatistics& statistics) {
+    auto microseconds = statistics.m_elapsed.total_microseconds();
+    if(microseconds <= 0) {
+      return 0;
+    }
+    return 1000000. * statistics.m_rows / microseconds;
+  }
+
+  inline std::ostream& operator <<(
+      std::ostream& out, const SqlWriteStatistics& statistics) {
+    return out << "rows: " << statistics.m_rows << ", statements: " <<
+      statistics.m_statements << ", elapsed: " << statistics.m_elapsed <<
+      ", rows per second: " << get_rows_per_second(statistics);
+  }
+
+  /**
+   * Loads and stores SequencedValue's in an SQL database. A batch of values is
+   * written in a single transaction, so that a failed batch commits nothing and
+   * can be stored again in full.
    * @tparam C The type of SQL connection to query.
    * @tparam V The type of SQL row to store the value.
    * @tparam I The type of SQL row to store the index.
@@ -95,8 +142,30 @@ namespace Beam {
         Ref<DatabaseConnectionPool<Connection>> writer_pool,
         SqlConnectionOption connection_option);
 
+      /**
+       * Constructs an SqlDataStore.
+       * @param table The name of the SQL table.
+       * @param value_row The SQL row to store the value.
+       * @param index_row The SQL row to store the index.
+       * @param reader_pool The pool of SQL connections used for reading.
+       * @param writer_pool The pool of SQL connections used for writing.
+       * @param connection_option Specifies the ConnectionOption to use.
+       * @param max_rows_per_insert The maximum number of rows written by a
+       *        single insert statement, sized so that a statement of the
+       *        widest rows fits within the database's limits, such as MySQL's
+       *        max_allowed_packet.
+       */
+      SqlDataStore(std::string table, ValueRow value_row, IndexRow index_row,
+        Ref<DatabaseConnectionPool<Connection>> reader_pool,
+        Ref<DatabaseConnectionPool<Connection>> writer_pool,
+        SqlConnectionOption connection_option,
+        std::size_t max_rows_per_insert);
+
       ~SqlDataStore();
 
+      /** Returns the metrics of the rows written. */
+      SqlWriteStatistics get_write_statistics() const;
+
       /**
        * Executes a search query.
        * @param query The search query to execute.
@@ -105,11 +174,18 @@ namespace Beam {
       std::vector<SequencedValue> load(const Viper::Expression& query);
 
       std::vector<SequencedValue> load(const Query& query);
+      std::vector<std::vector<SequencedValue>> load(
+        std::span<const Query> queries);
       void store(const IndexedValue& value);
       void store(const std::vector<IndexedValue>& values);
       void close();
 
     private:
+      struct WriteState {
+        SqlWriteStatistics m_statistics;
+        int m_active_writes = 0;
+        boost::posix_time::ptime m_busy_start;
+      };
       std::string m_table;
       ValueRow m_value_row;
       IndexRow m_index_row;
@@ -117,18 +193,26 @@ namespace Beam {
       Viper::Row<SequencedValue> m_sequenced_row;
       DatabaseConnectionPool<Connection>* m_reader_pool;
       DatabaseConnectionPool<Connection>* m_writer_pool;
+      std::size_t m_max_rows_per_insert;
+      Sync<WriteState> m_write_state;
+
+      template<typename Iterator>
+      void insert(Iterator first, Iterator last);
+      void start_write();
+      void end_write(std::uint64_t rows, std::uint64_t statements);
   };
 
   template<typename C, typename V, typename I, typename T>
   SqlDataStore<C, V, I, T>::SqlDataStore(std::string table, ValueRow value_row,
       IndexRow index_row, Ref<DatabaseConnectionPool<Connection>> reader_pool,
       Ref<DatabaseConnectionPool<Connection>> writer_pool,
-      SqlConnectionOption connection_option)
+      SqlConnectionOption connection_option, std::size_t max_rows_per_insert)
       : m_table(std::move(table)),
         m_value_row(std::move(value_row)),
         m_index_row(std::move(index_row)),
         m_reader_pool(reader_pool.get()),
-        m_writer_pool(writer_pool.get()) {
+        m_writer_pool(writer_pool.get()),
+        m_max_rows_per_insert(std::max<std::size_t>(max_rows_per_insert, 1)) {
     m_value_row = m_value_row.
       add_column("timestamp",
         [] (const auto& row) {
@@ -205,6 +289,15 @@ namespace Beam {
     : SqlDataStore(std::move(table), std::move(value_row), std::move(index_row),
         Ref(reader_pool), Ref(writer_pool), SqlConnectionOption::CREATE) {}
 
+  template<typename C, typename V, typename I, typename T>
+  SqlDataStore<C, V, I, T>::SqlDataStore(std::string table, ValueRow value_row,
+    IndexRow index_row, Ref<DatabaseConnectionPool<Connection>> reader_pool,
+    Ref<DatabaseConnectionPool<Connection>> writer_pool,
+    SqlConnectionOption connection_option)
+    : SqlDataStore(std::move(table), std::move(value_row), std::move(index_row),
+        Ref(reader_pool), Ref(writer_pool), connection_option,
+        DEFAULT_MAX_ROWS_PER_INSERT) {}
+
   template<typename C, typename V, typename I, typename T>
   SqlDataStore<C, V, I, T>::~SqlDataStore() {
     close();
@@ -233,6 +326,14 @@ namespace Beam {
       query, m_sequenced_row, m_table, *index, *m_reader_pool);
   }
 
+  template<typename C, typename V, typename I, typename T>
+  std::vector<std::vector<typename SqlDataStore<C, V, I, T>::SequencedValue>>
+      SqlDataStore<C, V, I, T>::load(std::span<const Query> queries) {
+    return load_concurrently(queries, [&] (const auto& query) {
+      return load(query);
+    });
+  }
+
   template<typename C, typename V, typename I, typename T>
   std::vector<typename SqlDataStore<C, V, I, T>::SequencedValue>
       SqlDataStore<C, V, I, T>::load(const Viper::Expression& query) {
@@ -242,21 +343,82 @@ namespace Beam {
   template<typename C, typename V, typename I, typename T>
   void SqlDataStore<C, V, I, T>::store(const IndexedValue& value) {
     auto connection = m_writer_pool->load();
-    connection->execute(Viper::insert(m_row, m_table, &value));
+    start_write();
+    try {
+      connection->execute(Viper::insert(m_row, m_table, &value));
+    } catch(...) {
+      end_write(0, 0);
+      throw;
+    }
+    end_write(1, 1);
   }
 
   template<typename C, typename V, typename I, typename T>
   void SqlDataStore<C, V, I, T>::store(
       const std::vector<IndexedValue>& values) {
-    auto connection = m_writer_pool->load();
-    Viper::transaction(*connection, [&] {
-      connection->execute(
-        Viper::insert(m_row, m_table, values.begin(), values.end()));
+    if(values.empty()) {
+      return;
+    }
+    insert(values.begin(), values.end());
+  }
+
+  template<typename C, typename V, typename I, typename T>
+  SqlWriteStatistics SqlDataStore<C, V, I, T>::get_write_statistics() const {
+    return m_write_state.with([] (const auto& state) {
+      return state.m_statistics;
     });
   }
 
   template<typename C, typename V, typename I, typename T>
   void SqlDataStore<C, V, I, T>::close() {}
+
+  template<typename C, typename V, typename I, typename T>
+  void SqlDataStore<C, V, I, T>::start_write() {
+    auto now = boost::posix_time::microsec_clock::universal_time();
+    m_write_state.with([&] (auto& state) {
+      if(state.m_active_writes == 0) {
+        state.m_busy_start = now;
+      }
+      ++state.m_active_writes;
+    });
+  }
+
+  template<typename C, typename V, typename I, typename T>
+  template<typename Iterator>
+  void SqlDataStore<C, V, I, T>::insert(Iterator first, Iterator last) {
+    auto connection = m_writer_pool->load();
+    auto statements = std::uint64_t(0);
+    start_write();
+    try {
+      Viper::transaction(*connection, [&] {
+        for(auto i = first; i != last;) {
+          auto end = i + std::min<std::size_t>(
+            m_max_rows_per_insert, std::distance(i, last));
+          connection->execute(Viper::insert(m_row, m_table, i, end));
+          ++statements;
+          i = end;
+        }
+      });
+    } catch(...) {
+      end_write(0, 0);
+      throw;
+    }
+    end_write(std::distance(first, last), statements);
+  }
+
+  template<typename C, typename V, typename I, typename T>
+  void SqlDataStore<C, V, I, T>::end_write(
+      std::uint64_t rows, std::uint64_t statements) {
+    auto now = boost::posix_time::microsec_clock::universal_time();
+    m_write_state.with([&] (auto& state) {
+      state.m_statistics.m_rows += rows;
+      state.m_statistics.m_statements += statements;
+      --state.m_active_writes;
+      if(state.m_active_writes == 0) {
+        state.m_statistics.m_elapsed += now - state.m_busy_start;
+      }
+    });
+  }
 }
 
 #endif
@@ -8,6 +8,7 @@
 #include "Beam/Collections/SynchronizedMap.hpp"
 #include "Beam/Queries/Evaluator.hpp"
 #include "Beam/Queries/FilteredQuery.hpp"
+#include "Beam/Queries/PredicateIndex.hpp"
 #include "Beam/Queries/QueryResult.hpp"
 #include "Beam/Queries/Range.hpp"
 #include "Beam/Queries/SequencedValue.hpp"
@@ -30,8 +31,21 @@ namespace Beam {
       /** The type of ServiceProtocolClients subscribing to queries. */
       using ServiceProtocolClient = C;
 
+      /**
+       * The type of function used to translate the filters of subscriptions
+       * added by Expression.
+       */
+      using Translator = typename PredicateIndex<V>::Translator;
+
       /** Constructs a Subscriptions object. */
-      Subscriptions() noexcept;
+      Subscriptions();
+
+      /**
+       * Constructs a Subscriptions object with a custom Translator.
+       * @param translator The Translator used for filters added by
+       *        Expression.
+       */
+      explicit Subscriptions(Translator translator);
 
       /**
        * Adds a subscription combining the initialization and commit.
@@ -43,6 +57,18 @@ namespace Beam {
       int add(ServiceProtocolClient& client, const Range& range,
         std::unique_ptr<Evaluator> filter);
 
+      /**
+       * Adds a subscription combining the initialization and commit. Filters
+       * added by Expression are shared with equivalent subscriptions and
+       * indexed so that publishing doesn't evaluate them one by one.
+       * @param client The client initializing the subscription.
+       * @param range The Range of the query.
+       * @param filter The filter to apply to published values.
+       * @return The query's unique id.
+       */
+      int add(ServiceProtocolClient& client, const Range& range,
+        const Expression& filter);
+
       /**
        * Initializes a subscription.
        * @param client The client initializing the subscription.
@@ -53,6 +79,16 @@ namespace Beam {
       int init(ServiceProtocolClient& client, const Range& range,
         std::unique_ptr<Evaluator> filter);
 
+      /**
+       * Initializes a subscription whose filter is indexed.
+       * @param client The client initializing the subscription.
+       * @param range The Range of the query.
+       * @param filter The filter to apply to published values.
+       * @return The query's unique id.
+       */
+      int init(ServiceProtocolClient& client, const Range& range,
+        const Expression& filter);
+
       /**
        * Commits a previously initialized subscription.
        * @param result The result of the query.
@@ -112,6 +148,7 @@ namespace Beam {
         ServiceProtocolClient* m_client;
         Range m_range;
         std::unique_ptr<Evaluator> m_filter;
+        int m_predicate;
         std::vector<Value> m_write_log;
         boost::mutex m_mutex;
 
@@ -120,12 +157,17 @@ namespace Beam {
       };
       std::atomic_int m_next_query_id;
       SynchronizedVector<std::shared_ptr<SubscriptionEntry>> m_subscriptions;
+      PredicateIndex<V> m_predicates;
       std::vector<ServiceProtocolClient*> m_receiving_clients;
       Beam::SynchronizedUnorderedMap<int, std::shared_ptr<SubscriptionEntry>>
         m_initializing_subscriptions;
 
       Subscriptions(const Subscriptions&) = delete;
       Subscriptions& operator =(const Subscriptions&) = delete;
+      int init(ServiceProtocolClient& client, const Range& range,
+        std::unique_ptr<Evaluator> filter, const Expression* expression);
+      template<typename F>
+      void erase_if(F&& f);
   };
 
   template<typename V, typename C>
@@ -136,12 +178,18 @@ namespace Beam {
       m_id(id),
       m_client(&client),
       m_range(range),
-      m_filter(std::move(filter)) {}
+      m_filter(std::move(filter)),
+      m_predicate(-1) {}
 
   template<typename V, typename C>
-  Subscriptions<V, C>::Subscriptions() noexcept
+  Subscriptions<V, C>::Subscriptions()
     : m_next_query_id(0) {}
 
+  template<typename V, typename C>
+  Subscriptions<V, C>::Subscriptions(Translator translator)
+    : m_next_query_id(0),
+      m_predicates(std::move(translator)) {}
+
   template<typename V, typename C>
   int Subscriptions<V, C>::add(ServiceProtocolClient& client,
       const Range& range, std::unique_ptr<Evaluator> filter) {
@@ -152,17 +200,43 @@ namespace Beam {
     return id;
   }
 
+  template<typename V, typename C>
+  int Subscriptions<V, C>::add(ServiceProtocolClient& client,
+      const Range& range, const Expression& filter) {
+    auto id = init(client, range, filter);
+    auto result = QueryResult<Value>();
+    result.m_id = id;
+    commit(std::move(result), [] (const QueryResult<Value>&) {});
+    return id;
+  }
+
   template<typename V, typename C>
   int Subscriptions<V, C>::init(ServiceProtocolClient& client,
       const Range& range, std::unique_ptr<Evaluator> filter) {
+    return init(client, range, std::move(filter), nullptr);
+  }
+
+  template<typename V, typename C>
+  int Subscriptions<V, C>::init(ServiceProtocolClient& client,
+      const Range& range, const Expression& filter) {
+    return init(client, range, nullptr, &filter);
+  }
+
+  template<typename V, typename C>
+  int Subscriptions<V, C>::init(ServiceProtocolClient& client,
+      const Range& range, std::unique_ptr<Evaluator> filter,
+      const Expression* expression) {
     if(range.get_end() != Beam::Sequence::LAST) {
       return -1;
     }
     auto id = ++m_next_query_id;
     auto entry =
       std::make_shared<SubscriptionEntry>(id, client, range, std::move(filter));
-    m_initializing_subscriptions.insert(id, entry);
     m_subscriptions.with([&] (auto& subscriptions) {
+      if(expression) {
+        entry->m_predicate = m_predicates.add(*expression);
+      }
+      m_initializing_subscriptions.insert(id, entry);
       auto i =
         std::lower_bound(subscriptions.begin(), subscriptions.end(), entry,
           [] (const auto& lhs, const auto& rhs) {
@@ -204,7 +278,7 @@ namespace Beam {
 
   template<typename V, typename C>
   void Subscriptions<V, C>::end(const ServiceProtocolClient& client, int id) {
-    m_subscriptions.erase_if([&] (const auto& entry) {
+    erase_if([&] (const auto& entry) {
       return entry->m_client == &client && entry->m_id == id;
     });
   }
@@ -216,7 +290,7 @@ namespace Beam {
         subscription && (*subscription)->m_client == &client) {
       m_initializing_subscriptions.erase(id);
     }
-    m_subscriptions.erase_if([&] (const auto& entry) {
+    erase_if([&] (const auto& entry) {
       return entry->m_client == &client && entry->m_id == id;
     });
   }
@@ -232,7 +306,7 @@ namespace Beam {
     for(auto id : ids) {
       m_initializing_subscriptions.erase(id);
     }
-    m_subscriptions.erase_if([&] (const auto& entry) {
+    erase_if([&] (const auto& entry) {
       return entry->m_client == &client;
     });
   }
@@ -244,6 +318,7 @@ namespace Beam {
     auto last_client = static_cast<const ServiceProtocolClient*>(nullptr);
     auto is_excluded = false;
     auto is_receiving = false;
+    auto is_tested = false;
     m_subscriptions.with([&] (const auto& subscriptions) {
       m_receiving_clients.clear();
       for(auto& entry : subscriptions) {
@@ -252,21 +327,31 @@ namespace Beam {
           is_excluded = !client_filter(*entry->m_client);
           is_receiving = false;
         }
-        if(is_excluded) {
+        if(is_excluded || (entry->m_range.get_start() != Sequence::PRESENT &&
+            !range_point_greater_or_equal(value, entry->m_range.get_start())) ||
+              !range_point_lesser_or_equal(value, entry->m_range.get_end())) {
           continue;
         }
-        auto lock = boost::lock_guard(entry->m_mutex);
-        if((entry->m_range.get_start() == Sequence::PRESENT ||
-            range_point_greater_or_equal(value, entry->m_range.get_start())) &&
-              range_point_lesser_or_equal(value, entry->m_range.get_end()) &&
-                test_filter(*entry->m_filter, *value)) {
-          if(entry->m_state == SubscriptionEntry::State::INITIALIZING) {
-            entry->m_write_log.push_back(value);
-          } else if(!is_receiving) {
-            is_receiving = true;
-            m_receiving_clients.push_back(entry->m_client);
+        if(entry->m_predicate == -1) {
+          if(!test_filter(*entry->m_filter, *value)) {
+            continue;
+          }
+        } else {
+          if(!is_tested) {
+            m_predicates.test(*value);
+            is_tested = true;
+          }
+          if(!m_predicates.is_match(entry->m_predicate)) {
+            continue;
           }
         }
+        auto lock = boost::lock_guard(entry->m_mutex);
+        if(entry->m_state == SubscriptionEntry::State::INITIALIZING) {
+          entry->m_write_log.push_back(value);
+        } else if(!is_receiving) {
+          is_receiving = true;
+          m_receiving_clients.push_back(entry->m_client);
+        }
       }
       if(!m_receiving_clients.empty()) {
         std::forward<Sender>(sender)(m_receiving_clients);
@@ -280,6 +365,22 @@ namespace Beam {
     publish(value, [] (ServiceProtocolClient&) { return true; },
       std::forward<Sender>(sender));
   }
+
+  template<typename V, typename C>
+  template<typename F>
+  void Subscriptions<V, C>::erase_if(F&& f) {
+    m_subscriptions.with([&] (auto& subscriptions) {
+      std::erase_if(subscriptions, [&] (const auto& entry) {
+        if(!f(entry)) {
+          return false;
+        }
+        if(entry->m_predicate != -1) {
+          m_predicates.remove(entry->m_predicate);
+        }
+        return true;
+      });
+    });
+  }
 }
 
 #endif
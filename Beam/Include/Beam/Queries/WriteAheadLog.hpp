@@ -0,0 +1,460 @@
+#ifndef BEAM_WRITE_AHEAD_LOG_HPP
+#define BEAM_WRITE_AHEAD_LOG_HPP
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <boost/crc.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#ifdef _WIN32
+  #include <fcntl.h>
+  #include <io.h>
+  #include <sys/stat.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+#include "Beam/IO/IOException.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Pointers/Ref.hpp"
+#include "Beam/Queries/Sequence.hpp"
+#include "Beam/Queries/SnapshotLimit.hpp"
+#include "Beam/Serialization/BinaryReceiver.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
+#include "Beam/Serialization/ShuttleVector.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+#include "Beam/Threading/LockRelease.hpp"
+#include "Beam/Threading/ThreadPool.hpp"
+
+namespace Beam {
+namespace Details {
+  class WriteAheadLogSegment {
+    public:
+      explicit WriteAheadLogSegment(const std::filesystem::path& path);
+      ~WriteAheadLogSegment();
+      void write(const char* data, std::size_t size);
+      void sync();
+
+    private:
+      int m_descriptor;
+
+      WriteAheadLogSegment(const WriteAheadLogSegment&) = delete;
+      WriteAheadLogSegment& operator =(const WriteAheadLogSegment&) = delete;
+  };
+
+  /**
+   * Flushes a directory's entries to disk, so that files created in or
+   * removed from it survive a power failure. Windows commits directory
+   * entries along with the files themselves, so this has no effect there.
+   * @param directory The directory to flush.
+   */
+  inline void sync_directory(const std::filesystem::path& directory) {
+#ifndef _WIN32
+    auto descriptor = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if(descriptor == -1) {
+      boost::throw_with_location(
+        IOException("Unable to open log directory: " + directory.string()));
+    }
+    auto result = ::fsync(descriptor);
+    ::close(descriptor);
+    if(result != 0) {
+      boost::throw_with_location(IOException("Log directory sync failed."));
+    }
+#endif
+  }
+
+  inline WriteAheadLogSegment::WriteAheadLogSegment(
+      const std::filesystem::path& path) {
+#ifdef _WIN32
+    m_descriptor = ::_wopen(path.c_str(),
+      _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    m_descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+    if(m_descriptor == -1) {
+      boost::throw_with_location(
+        IOException("Unable to open log segment: " + path.string()));
+    }
+  }
+
+  inline WriteAheadLogSegment::~WriteAheadLogSegment() {
+#ifdef _WIN32
+    ::_close(m_descriptor);
+#else
+    ::close(m_descriptor);
+#endif
+  }
+
+  inline void WriteAheadLogSegment::write(const char* data, std::size_t size) {
+    while(size != 0) {
+#ifdef _WIN32
+      auto count =
+        ::_write(m_descriptor, data, static_cast<unsigned int>(size));
+#else
+      auto count = ::write(m_descriptor, data, size);
+      if(count == -1 && errno == EINTR) {
+        continue;
+      }
+#endif
+      if(count <= 0) {
+        boost::throw_with_location(IOException("Log segment write failed."));
+      }
+      data += count;
+      size -= count;
+    }
+  }
+
+  inline void WriteAheadLogSegment::sync() {
+#ifdef _WIN32
+    auto result = ::_commit(m_descriptor);
+#else
+    auto result = ::fsync(m_descriptor);
+#endif
+    if(result != 0) {
+      boost::throw_with_location(IOException("Log segment sync failed."));
+    }
+  }
+}
+
+  /**
+   * Stages values in a durable, checksummed log of segment files until they
+   * are committed elsewhere. Writes are made durable by sync, which lets
+   * concurrent writers share a single flush to disk.
+   * @tparam T The type of value logged.
+   */
+  template<typename T>
+  class WriteAheadLog {
+    public:
+
+      /** The type of value logged. */
+      using Value = T;
+
+      /** Identifies the position of a write within the log. */
+      using Position = std::uint64_t;
+
+      /** Identifies a segment of the log. */
+      using Segment = std::uint64_t;
+
+      /**
+       * Constructs a WriteAheadLog, recovering the values left in any
+       * segments found in the directory.
+       * @param directory The directory to store the segments in.
+       */
+      explicit WriteAheadLog(std::filesystem::path directory);
+
+      /**
+       * Returns the values recovered when the log was opened, in the order
+       * they were written. Records cut short or failing their checksum end
+       * the recovery of their segment.
+       */
+      std::vector<Value> recover();
+
+      /**
+       * Writes values to the current segment without waiting for them to be
+       * durable.
+       * @param values The values to write.
+       * @return The position to sync to make the values durable.
+       */
+      Position write(std::span<const Value> values);
+
+      /**
+       * Waits until every write up to a position is durable. Only one flush to
+       * disk runs at a time and it covers every write made before it started.
+       * @param position The position to make durable.
+       */
+      void sync(Position position);
+
+      /**
+       * Creates the segment the next seal switches to, unless one is already
+       * reserved. The file is created and made durable off the calling thread,
+       * so that seal never blocks on the disk.
+       */
+      void reserve();
+
+      /**
+       * Switches subsequent writes to the reserved segment, unless nothing was
+       * written to the current segment or no segment is reserved, in which
+       * case writes continue in the current segment.
+       * @return The last segment ended, if any.
+       */
+      std::optional<Segment> seal();
+
+      /**
+       * Removes all segments up to and including a sealed segment, once the
+       * values written to them are committed. Segments that can't be removed
+       * are left to be removed by a later truncation, but a failure to make
+       * the removals durable is thrown.
+       * @param segment The last segment to remove.
+       */
+      void truncate(Segment segment);
+
+    private:
+      struct OpenSegment {
+        Segment m_id;
+        std::shared_ptr<Details::WriteAheadLogSegment> m_file;
+      };
+      mutable boost::mutex m_mutex;
+      std::filesystem::path m_directory;
+      std::vector<Value> m_recovered;
+      OpenSegment m_segment;
+      OpenSegment m_reserved_segment;
+      std::vector<OpenSegment> m_unsynced_segments;
+      Position m_written_position;
+      Position m_sealed_position;
+      Position m_synced_position;
+      bool m_is_syncing;
+      ConditionVariable m_synced;
+
+      WriteAheadLog(const WriteAheadLog&) = delete;
+      WriteAheadLog& operator =(const WriteAheadLog&) = delete;
+      std::filesystem::path get_path(Segment segment) const;
+      std::vector<Segment> load_segments() const;
+      void read_segment(Segment segment);
+  };
+
+  /**
+   * Removes the values a data store already committed from the values
+   * recovered out of a WriteAheadLog. A crash between committing values and
+   * truncating their segments leaves them in the log, so replaying it would
+   * otherwise store them twice.
+   * @param data_store The data store the values are committed to.
+   * @param values The values recovered from the log.
+   * @return The <i>values</i> not yet committed to the <i>data_store</i>.
+   */
+  template<typename D>
+  std::vector<typename D::IndexedValue> remove_committed(
+      D& data_store, std::vector<typename D::IndexedValue> values) {
+    using Index = typename D::Index;
+    auto ranges = std::unordered_map<Index, std::pair<Sequence, Sequence>>();
+    for(auto& value : values) {
+      auto& range = ranges.try_emplace(value->get_index(),
+        value.get_sequence(), value.get_sequence()).first->second;
+      range.first = std::min(range.first, value.get_sequence());
+      range.second = std::max(range.second, value.get_sequence());
+    }
+    auto committed = std::unordered_map<Index, std::unordered_set<Sequence>>();
+    for(auto& [index, range] : ranges) {
+      auto query = typename D::Query();
+      query.set_index(index);
+      query.set_range(range.first, range.second);
+      query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+      auto& sequences = committed[index];
+      for(auto& value : data_store.load(query)) {
+        sequences.insert(value.get_sequence());
+      }
+    }
+    std::erase_if(values, [&] (const auto& value) {
+      return committed[value->get_index()].contains(value.get_sequence());
+    });
+    return values;
+  }
+
+  template<typename T>
+  WriteAheadLog<T>::WriteAheadLog(std::filesystem::path directory)
+      : m_directory(std::move(directory)),
+        m_written_position(0),
+        m_sealed_position(0),
+        m_synced_position(0),
+        m_is_syncing(false) {
+    std::filesystem::create_directories(m_directory);
+    auto segments = load_segments();
+    for(auto segment : segments) {
+      read_segment(segment);
+    }
+    m_segment.m_id = segments.empty() ? 0 : segments.back() + 1;
+    m_segment.m_file = std::make_shared<Details::WriteAheadLogSegment>(
+      get_path(m_segment.m_id));
+    m_reserved_segment.m_id = m_segment.m_id + 1;
+    m_reserved_segment.m_file =
+      std::make_shared<Details::WriteAheadLogSegment>(
+        get_path(m_reserved_segment.m_id));
+    Details::sync_directory(m_directory);
+  }
+
+  template<typename T>
+  std::vector<typename WriteAheadLog<T>::Value> WriteAheadLog<T>::recover() {
+    auto lock = boost::lock_guard(m_mutex);
+    return std::move(m_recovered);
+  }
+
+  template<typename T>
+  typename WriteAheadLog<T>::Position WriteAheadLog<T>::write(
+      std::span<const Value> values) {
+    auto payload = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.set(Ref(payload));
+    sender.start_sequence(nullptr, static_cast<int>(values.size()));
+    for(auto& value : values) {
+      sender.send(value);
+    }
+    sender.end_sequence();
+    auto checksum = boost::crc_32_type();
+    checksum.process_bytes(payload.get_data(), payload.get_size());
+    auto record = SharedBuffer();
+    append(record, static_cast<std::uint32_t>(payload.get_size()));
+    append(record, static_cast<std::uint32_t>(checksum.checksum()));
+    append(record, payload);
+    auto lock = boost::lock_guard(m_mutex);
+    m_segment.m_file->write(record.get_data(), record.get_size());
+    return ++m_written_position;
+  }
+
+  template<typename T>
+  void WriteAheadLog<T>::sync(Position position) {
+    auto lock = boost::unique_lock(m_mutex);
+    while(m_synced_position < position) {
+      if(m_is_syncing) {
+        m_synced.wait(lock);
+        continue;
+      }
+      m_is_syncing = true;
+      auto target = m_written_position;
+      auto segments = std::move(m_unsynced_segments);
+      segments.push_back(m_segment);
+      try {
+        auto release = LockRelease(lock);
+        park([&] {
+          for(auto& segment : segments) {
+            segment.m_file->sync();
+          }
+        });
+      } catch(const std::exception&) {
+        segments.pop_back();
+        m_unsynced_segments.insert(
+          m_unsynced_segments.begin(), segments.begin(), segments.end());
+        m_is_syncing = false;
+        m_synced.notify_all();
+        throw;
+      }
+      m_is_syncing = false;
+      m_synced_position = std::max(m_synced_position, target);
+      m_synced.notify_all();
+    }
+  }
+
+  template<typename T>
+  void WriteAheadLog<T>::reserve() {
+    auto lock = boost::unique_lock(m_mutex);
+    if(m_reserved_segment.m_file) {
+      return;
+    }
+    auto id = m_segment.m_id + 1;
+    auto file = std::shared_ptr<Details::WriteAheadLogSegment>();
+    {
+      auto release = LockRelease(lock);
+      park([&] {
+        file = std::make_shared<Details::WriteAheadLogSegment>(get_path(id));
+        Details::sync_directory(m_directory);
+      });
+    }
+    if(!m_reserved_segment.m_file && m_segment.m_id + 1 == id) {
+      m_reserved_segment = OpenSegment(id, std::move(file));
+    }
+  }
+
+  template<typename T>
+  std::optional<typename WriteAheadLog<T>::Segment> WriteAheadLog<T>::seal() {
+    auto lock = boost::lock_guard(m_mutex);
+    if(m_written_position != m_sealed_position && m_reserved_segment.m_file) {
+      m_unsynced_segments.push_back(std::move(m_segment));
+      m_segment = std::exchange(m_reserved_segment, OpenSegment());
+      m_sealed_position = m_written_position;
+    }
+    if(m_segment.m_id == 0) {
+      return std::nullopt;
+    }
+    return m_segment.m_id - 1;
+  }
+
+  template<typename T>
+  void WriteAheadLog<T>::truncate(Segment segment) {
+    park([&] {
+      for(auto id : load_segments()) {
+        if(id > segment) {
+          break;
+        }
+        auto error = std::error_code();
+        std::filesystem::remove(get_path(id), error);
+      }
+      Details::sync_directory(m_directory);
+    });
+  }
+
+  template<typename T>
+  std::filesystem::path WriteAheadLog<T>::get_path(Segment segment) const {
+    return m_directory / (std::to_string(segment) + ".wal");
+  }
+
+  template<typename T>
+  std::vector<typename WriteAheadLog<T>::Segment>
+      WriteAheadLog<T>::load_segments() const {
+    auto segments = std::vector<Segment>();
+    for(auto& entry : std::filesystem::directory_iterator(m_directory)) {
+      if(entry.path().extension() != ".wal") {
+        continue;
+      }
+      try {
+        segments.push_back(std::stoull(entry.path().stem().string()));
+      } catch(const std::exception&) {}
+    }
+    std::ranges::sort(segments);
+    return segments;
+  }
+
+  template<typename T>
+  void WriteAheadLog<T>::read_segment(Segment segment) {
+    auto error = std::error_code();
+    auto remaining = std::filesystem::file_size(get_path(segment), error);
+    if(error) {
+      return;
+    }
+    auto file = std::ifstream(get_path(segment), std::ios::binary);
+    while(true) {
+      auto size = std::uint32_t();
+      auto expected_checksum = std::uint32_t();
+      if(!file.read(reinterpret_cast<char*>(&size), sizeof(size)) ||
+          !file.read(reinterpret_cast<char*>(&expected_checksum),
+            sizeof(expected_checksum))) {
+        return;
+      }
+      remaining -= sizeof(size) + sizeof(expected_checksum);
+      if(size > remaining) {
+        return;
+      }
+      remaining -= size;
+      auto payload = SharedBuffer(size);
+      if(!file.read(payload.get_mutable_data(), size)) {
+        return;
+      }
+      auto checksum = boost::crc_32_type();
+      checksum.process_bytes(payload.get_data(), payload.get_size());
+      if(checksum.checksum() != expected_checksum) {
+        return;
+      }
+      auto receiver = BinaryReceiver<SharedBuffer>();
+      receiver.set(Ref(payload));
+      auto values = std::vector<Value>();
+      try {
+        receiver.shuttle(values);
+      } catch(const std::exception&) {
+        return;
+      }
+      m_recovered.insert(m_recovered.end(),
+        std::make_move_iterator(values.begin()),
+        std::make_move_iterator(values.end()));
+    }
+  }
+}
+
+#endif
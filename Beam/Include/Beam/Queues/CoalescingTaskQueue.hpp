@@ -0,0 +1,201 @@
+#ifndef BEAM_COALESCING_TASK_QUEUE_HPP
+#define BEAM_COALESCING_TASK_QUEUE_HPP
+#include <concepts>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include "Beam/Queues/CallbackQueueWriter.hpp"
+#include "Beam/Queues/Queue.hpp"
+#include "Beam/Queues/ScopedQueueGroup.hpp"
+#include "Beam/Queues/ScopedQueueWriter.hpp"
+#include "Beam/Routines/Routine.hpp"
+#include "Beam/Threading/Task.hpp"
+#include "Beam/Utilities/ReportException.hpp"
+
+namespace Beam {
+
+  /**
+   * Translates queue pushes into Tasks that are run in batches. Unlike a
+   * TaskQueue, a push onto a slot directly enqueues a Task whose callable is
+   * stored inline for small values, and all pending Tasks can be popped with
+   * a single lock acquisition.
+   */
+  class CoalescingTaskQueue : public AbstractQueue<Task> {
+    public:
+      using Target = AbstractQueue<Task>::Target;
+      using Source = AbstractQueue<Task>::Source;
+
+      ~CoalescingTaskQueue() override;
+
+      /**
+       * Returns a slot.
+       * @param callback The callback when a new value is pushed.
+       * @return A queue that translates a push into a callback.
+       */
+      template<typename T, std::invocable<const T&> F>
+      auto get_slot(F&& callback);
+
+      /**
+       * Returns a slot.
+       * @param callback The callback when a new value is pushed.
+       * @param on_break The callback when the queue is broken.
+       * @return A queue that translates a push into a callback.
+       */
+      template<typename T, std::invocable<const T&> F,
+        std::invocable<const std::exception_ptr&> B>
+      auto get_slot(F&& callback, B&& on_break);
+
+      Source pop() override;
+      boost::optional<Source> try_pop() override;
+      std::size_t try_pop_batch(
+        Out<std::vector<Source>> values, std::size_t max) override;
+      std::vector<Source> pop_all() override;
+      void push(const Target& value) override;
+      void push(Target&& value) override;
+      void close(const std::exception_ptr& exception) override;
+      using AbstractQueue<Task>::close;
+
+    private:
+      boost::mutex m_mutex;
+      std::exception_ptr m_exception;
+      ScopedQueueGroup m_slots;
+      Queue<Task> m_tasks;
+  };
+
+  /**
+   * Implements a loop that pops all pending tasks from a task Queue at once
+   * and runs them back-to-back.
+   * @param queue The Queue to run tasks for.
+   */
+  template<typename Q>
+  void batch_loop(Q queue) requires std::derived_from<
+      dereference_t<Q>, QueueReader<typename dereference_t<Q>::Source>> &&
+        std::invocable<typename dereference_t<Q>::Source&> {
+    try {
+      while(true) {
+        auto tasks = queue->pop_all();
+        for(auto& task : tasks) {
+          task();
+        }
+      }
+    } catch(const PipeBrokenException&) {
+      return;
+    } catch(const std::exception&) {
+      std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+    }
+  }
+
+  /**
+   * Spawns a Routine that executes tasks in batches.
+   * @param queue The Queue to read the tasks from.
+   * @return The spawned Routine's Id.
+   */
+  template<typename Q> requires std::derived_from<
+      dereference_t<Q>, QueueReader<typename dereference_t<Q>::Source>> &&
+        std::invocable<typename dereference_t<Q>::Source&>
+  Routine::Id spawn_batch_loop(Q queue) {
+    return spawn([queue = std::move(queue)] {
+      batch_loop(queue);
+    });
+  }
+
+  /**
+   * Pops off all tasks pushed onto a CoalescingTaskQueue and invokes them.
+   * @param tasks The CoalescingTaskQueue to handle.
+   */
+  inline void flush(CoalescingTaskQueue& tasks) {
+    auto batch = std::vector<Task>();
+    while(tasks.try_pop_batch(out(batch), std::size_t(-1)) != 0) {
+      for(auto& task : batch) {
+        task();
+      }
+      batch.clear();
+    }
+  }
+
+  inline CoalescingTaskQueue::~CoalescingTaskQueue() {
+    close();
+  }
+
+  template<typename T, std::invocable<const T&> F>
+  auto CoalescingTaskQueue::get_slot(F&& callback) {
+    return get_slot<T>(
+      std::forward<F>(callback), [] (const std::exception_ptr&) {});
+  }
+
+  template<typename T, std::invocable<const T&> F,
+    std::invocable<const std::exception_ptr&> B>
+  auto CoalescingTaskQueue::get_slot(F&& callback, B&& on_break) {
+    auto slot = Beam::callback<T>(
+      [this, callback = std::make_shared<std::remove_cvref_t<F>>(
+          std::forward<F>(callback))] (auto&& value) {
+        m_tasks.push(Task(
+          [=, value = std::forward<decltype(value)>(value)] {
+            (*callback)(value);
+          }));
+      },
+      [this, on_break = std::make_shared<std::remove_cvref_t<B>>(
+          std::forward<B>(on_break))] (const std::exception_ptr& e) {
+        m_tasks.push(Task([=] {
+          (*on_break)(e);
+        }));
+      });
+    auto exception = [&] {
+      auto lock = boost::lock_guard(m_mutex);
+      if(!m_exception) {
+        m_slots.add(slot);
+      }
+      return m_exception;
+    }();
+    if(exception) {
+      slot->close(exception);
+    }
+    return ScopedQueueWriter(std::move(slot));
+  }
+
+  inline CoalescingTaskQueue::Source CoalescingTaskQueue::pop() {
+    return m_tasks.pop();
+  }
+
+  inline boost::optional<CoalescingTaskQueue::Source>
+      CoalescingTaskQueue::try_pop() {
+    return m_tasks.try_pop();
+  }
+
+  inline std::size_t CoalescingTaskQueue::try_pop_batch(
+      Out<std::vector<Source>> values, std::size_t max) {
+    return m_tasks.try_pop_batch(out(values), max);
+  }
+
+  inline std::vector<CoalescingTaskQueue::Source>
+      CoalescingTaskQueue::pop_all() {
+    return m_tasks.pop_all();
+  }
+
+  inline void CoalescingTaskQueue::push(const Target& value) {
+    m_tasks.push(value);
+  }
+
+  inline void CoalescingTaskQueue::push(Target&& value) {
+    m_tasks.push(std::move(value));
+  }
+
+  inline void CoalescingTaskQueue::close(
+      const std::exception_ptr& exception) {
+    {
+      auto lock = boost::lock_guard(m_mutex);
+      if(m_exception) {
+        return;
+      }
+      m_exception = exception;
+    }
+    m_slots.close(exception);
+    m_tasks.push(Task([=, this] {
+      m_tasks.close(exception);
+    }));
+  }
+}
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef BEAM_CONVERTER_QUEUE_WRITER_HPP
 #define BEAM_CONVERTER_QUEUE_WRITER_HPP
 #include <concepts>
+#include <stdexcept>
 #include <type_traits>
+#include <boost/throw_exception.hpp>
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Queues/ScopedQueueWriter.hpp"
 #include "Beam/Utilities/TypeTraits.hpp"
@@ -68,7 +70,12 @@ namespace Beam {
 
   template<typename T, std::invocable<T&&> C>
   void ConverterQueueWriter<T, C>::push(const Target& value) {
-    m_target.push(m_converter(value));
+    if constexpr(std::copy_constructible<T>) {
+      m_target.push(m_converter(value));
+    } else {
+      boost::throw_with_location(
+        std::logic_error("Values of this QueueWriter can only be moved."));
+    }
   }
 
   template<typename T, std::invocable<T&&> C>
@@ -0,0 +1,173 @@
+#ifndef BEAM_MPSC_QUEUE_HPP
+#define BEAM_MPSC_QUEUE_HPP
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <boost/optional/optional.hpp>
+#include "Beam/Queues/RingQueue.hpp"
+
+namespace Beam {
+
+  /**
+   * Implements a bounded lock-free ring buffer with any number of producer
+   * threads and a single consumer thread.
+   * @tparam T The type of value to store.
+   */
+  template<typename T>
+  class MpscRingBuffer {
+    public:
+
+      /** The type of value to store. */
+      using Value = T;
+
+      /**
+       * Constructs an MpscRingBuffer.
+       * @param capacity The maximum number of values that can be stored,
+       *        rounded up to a power of two.
+       */
+      explicit MpscRingBuffer(std::size_t capacity);
+
+      ~MpscRingBuffer();
+
+      /** Returns the maximum number of values that can be stored. */
+      std::size_t get_capacity() const;
+
+      /** Returns an approximation of the number of values stored. */
+      std::size_t get_size() const;
+
+      /** Returns <code>true</code> iff the buffer appears empty. */
+      bool is_empty() const;
+
+      /** Returns <code>true</code> iff the buffer appears full. */
+      bool is_full() const;
+
+      /**
+       * Pushes a value, may be called from any thread.
+       * @param value The value to push, left untouched if the buffer is full.
+       * @return <code>false</code> iff the buffer is full.
+       */
+      template<typename V>
+      bool try_push(V&& value);
+
+      /** Pops a value, must only be called by the consumer. */
+      boost::optional<Value> try_pop();
+
+    private:
+      struct Slot {
+        std::atomic_uint64_t m_sequence;
+        alignas(Value) std::byte m_storage[sizeof(Value)];
+      };
+      std::uint64_t m_mask;
+      std::unique_ptr<Slot[]> m_slots;
+      alignas(64) std::atomic_uint64_t m_head;
+      alignas(64) std::atomic_uint64_t m_tail;
+
+      Value& get(Slot& slot);
+      MpscRingBuffer(const MpscRingBuffer&) = delete;
+      MpscRingBuffer& operator =(const MpscRingBuffer&) = delete;
+  };
+
+  /**
+   * Implements a Queue with any number of pushing Routines and a single
+   * popping Routine.
+   * @tparam T The data to store in the Queue.
+   */
+  template<typename T>
+  using MpscQueue = RingQueue<T, MpscRingBuffer<T>>;
+
+  template<typename T>
+  MpscRingBuffer<T>::MpscRingBuffer(std::size_t capacity)
+      : m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1),
+        m_slots(std::make_unique<Slot[]>(m_mask + 1)),
+        m_head(0),
+        m_tail(0) {
+    for(auto i = std::uint64_t(0); i <= m_mask; ++i) {
+      m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  template<typename T>
+  MpscRingBuffer<T>::~MpscRingBuffer() {
+    while(try_pop()) {}
+  }
+
+  template<typename T>
+  std::size_t MpscRingBuffer<T>::get_capacity() const {
+    return static_cast<std::size_t>(m_mask + 1);
+  }
+
+  template<typename T>
+  std::size_t MpscRingBuffer<T>::get_size() const {
+    auto head = m_head.load(std::memory_order_acquire);
+    auto tail = m_tail.load(std::memory_order_acquire);
+    if(tail <= head) {
+      return 0;
+    }
+    return static_cast<std::size_t>(tail - head);
+  }
+
+  template<typename T>
+  bool MpscRingBuffer<T>::is_empty() const {
+    auto head = m_head.load(std::memory_order_acquire);
+    return m_slots[head & m_mask].m_sequence.load(std::memory_order_acquire) !=
+      head + 1;
+  }
+
+  template<typename T>
+  bool MpscRingBuffer<T>::is_full() const {
+    auto tail = m_tail.load(std::memory_order_acquire);
+    return m_slots[tail & m_mask].m_sequence.load(std::memory_order_acquire) !=
+      tail;
+  }
+
+  template<typename T>
+  template<typename V>
+  bool MpscRingBuffer<T>::try_push(V&& value) {
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    while(true) {
+      auto& slot = m_slots[tail & m_mask];
+      auto sequence = slot.m_sequence.load(std::memory_order_acquire);
+      auto difference =
+        static_cast<std::int64_t>(sequence) - static_cast<std::int64_t>(tail);
+      if(difference == 0) {
+        if(m_tail.compare_exchange_weak(
+            tail, tail + 1, std::memory_order_relaxed)) {
+          std::construct_at(reinterpret_cast<Value*>(slot.m_storage),
+            std::forward<V>(value));
+          slot.m_sequence.store(tail + 1, std::memory_order_release);
+          return true;
+        }
+      } else if(difference < 0) {
+        return false;
+      } else {
+        tail = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template<typename T>
+  boost::optional<typename MpscRingBuffer<T>::Value>
+      MpscRingBuffer<T>::try_pop() {
+    auto head = m_head.load(std::memory_order_relaxed);
+    auto& slot = m_slots[head & m_mask];
+    if(slot.m_sequence.load(std::memory_order_acquire) != head + 1) {
+      return boost::none;
+    }
+    auto& stored_value = get(slot);
+    auto value = boost::optional<Value>(std::move(stored_value));
+    std::destroy_at(&stored_value);
+    slot.m_sequence.store(head + m_mask + 1, std::memory_order_release);
+    m_head.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  template<typename T>
+  typename MpscRingBuffer<T>::Value& MpscRingBuffer<T>::get(Slot& slot) {
+    return *std::launder(reinterpret_cast<Value*>(slot.m_storage));
+  }
+}
+
+#endif
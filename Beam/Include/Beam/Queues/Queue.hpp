@@ -1,13 +1,32 @@
 #ifndef BEAM_QUEUE_HPP
 #define BEAM_QUEUE_HPP
+#include <algorithm>
+#include <concepts>
 #include <deque>
+#include <limits>
+#include <stdexcept>
 #include <boost/thread/mutex.hpp>
+#include <boost/throw_exception.hpp>
 #include "Beam/Queues/AbstractQueue.hpp"
 #include "Beam/Queues/PipeBrokenException.hpp"
+#include "Beam/Queues/QueueFullException.hpp"
 #include "Beam/Threading/ConditionVariable.hpp"
 
 namespace Beam {
 
+  /** Specifies what happens when a value is pushed onto a full Queue. */
+  enum class OverflowPolicy {
+
+    /** The pushing Routine is suspended until space is available. */
+    BLOCK,
+
+    /** A QueueFullException is thrown. */
+    FAIL,
+
+    /** The oldest value in the Queue is discarded. */
+    DROP_OLDEST
+  };
+
   /**
    * Implements a Queue that can safely block within a Routine waiting for data
    * to arrive.
@@ -19,14 +38,49 @@ namespace Beam {
       using Target = typename AbstractQueue<T>::Target;
       using Source = typename AbstractQueue<T>::Source;
 
-      /** Constructs a Queue. */
-      Queue() = default;
+      /** Constructs an unbounded Queue. */
+      Queue();
+
+      /**
+       * Constructs a bounded Queue.
+       * @param capacity The maximum number of values the Queue can store.
+       * @param policy The policy applied when pushing onto a full Queue.
+       */
+      explicit Queue(
+        std::size_t capacity, OverflowPolicy policy = OverflowPolicy::BLOCK);
+
+      /** Returns the maximum number of values this Queue can store. */
+      std::size_t get_capacity() const;
+
+      /** Returns the policy applied when pushing onto a full Queue. */
+      OverflowPolicy get_overflow_policy() const;
+
+      /** Returns the number of values in this Queue. */
+      std::size_t get_size() const;
 
       /** Returns <code>true</code> iff this Queue is broken. */
       bool is_broken() const;
 
+      /**
+       * Adds a value to the end of this Queue without blocking.
+       * @param value The value to add.
+       * @return <code>false</code> iff this Queue is full.
+       */
+      bool try_push(const Target& value);
+
+      /**
+       * Adds a value to the end of this Queue without blocking.
+       * @param value The value to add.
+       * @return <code>false</code> iff this Queue is full.
+       */
+      bool try_push(Target&& value);
+
       Source pop() override;
       boost::optional<Source> try_pop() override;
+      std::size_t try_pop_batch(
+        Out<std::vector<Source>> values, std::size_t max) override;
+      std::vector<Source> pop_all() override;
+
       void push(const Target& value) override;
       void push(Target&& value) override;
       void close(const std::exception_ptr& exception) override;
@@ -35,18 +89,61 @@ namespace Beam {
     private:
       mutable boost::mutex m_mutex;
       mutable ConditionVariable m_is_available_condition;
+      mutable ConditionVariable m_is_space_available_condition;
+      std::size_t m_capacity;
+      OverflowPolicy m_policy;
+      std::size_t m_blocked_count;
       std::deque<T> m_queue;
       std::exception_ptr m_break_exception;
 
       bool unlocked_is_available() const;
+      template<typename V>
+      bool emplace(V&& value, bool is_blocking);
+      void notify_space_available(std::size_t previous_size);
   };
 
+  template<typename T>
+  Queue<T>::Queue()
+    : Queue(std::numeric_limits<std::size_t>::max()) {}
+
+  template<typename T>
+  Queue<T>::Queue(std::size_t capacity, OverflowPolicy policy)
+    : m_capacity(std::max<std::size_t>(capacity, 1)),
+      m_policy(policy),
+      m_blocked_count(0) {}
+
+  template<typename T>
+  std::size_t Queue<T>::get_capacity() const {
+    return m_capacity;
+  }
+
+  template<typename T>
+  OverflowPolicy Queue<T>::get_overflow_policy() const {
+    return m_policy;
+  }
+
+  template<typename T>
+  std::size_t Queue<T>::get_size() const {
+    auto lock = boost::lock_guard(m_mutex);
+    return m_queue.size();
+  }
+
   template<typename T>
   bool Queue<T>::is_broken() const {
     auto lock = boost::lock_guard(m_mutex);
     return m_break_exception && m_queue.empty();
   }
 
+  template<typename T>
+  bool Queue<T>::try_push(const Target& value) {
+    return emplace(value, false);
+  }
+
+  template<typename T>
+  bool Queue<T>::try_push(Target&& value) {
+    return emplace(std::move(value), false);
+  }
+
   template<typename T>
   typename Queue<T>::Source Queue<T>::pop() {
     auto lock = boost::unique_lock(m_mutex);
@@ -58,6 +155,7 @@ namespace Beam {
     }
     auto value = std::move(m_queue.front());
     m_queue.pop_front();
+    notify_space_available(m_queue.size() + 1);
     return value;
   }
 
@@ -69,31 +167,53 @@ namespace Beam {
     }
     auto value = std::move(m_queue.front());
     m_queue.pop_front();
+    notify_space_available(m_queue.size() + 1);
     return value;
   }
 
   template<typename T>
-  void Queue<T>::push(const Target& value) {
+  std::size_t Queue<T>::try_pop_batch(
+      Out<std::vector<Source>> values, std::size_t max) {
     auto lock = boost::lock_guard(m_mutex);
-    if(m_break_exception) {
+    auto count = std::min(max, m_queue.size());
+    auto previous_size = m_queue.size();
+    values->insert(values->end(), std::make_move_iterator(m_queue.begin()),
+      std::make_move_iterator(m_queue.begin() + count));
+    m_queue.erase(m_queue.begin(), m_queue.begin() + count);
+    notify_space_available(previous_size);
+    return count;
+  }
+
+  template<typename T>
+  std::vector<typename Queue<T>::Source> Queue<T>::pop_all() {
+    auto lock = boost::unique_lock(m_mutex);
+    while(!unlocked_is_available()) {
+      m_is_available_condition.wait(lock);
+    }
+    if(m_queue.empty()) {
       std::rethrow_exception(m_break_exception);
     }
-    m_queue.push_back(value);
-    if(m_queue.size() == 1) {
-      m_is_available_condition.notify_one();
+    auto previous_size = m_queue.size();
+    auto values = std::vector<Source>(std::make_move_iterator(m_queue.begin()),
+      std::make_move_iterator(m_queue.end()));
+    m_queue.clear();
+    notify_space_available(previous_size);
+    return values;
+  }
+
+  template<typename T>
+  void Queue<T>::push(const Target& value) {
+    if constexpr(std::copy_constructible<T>) {
+      emplace(value, true);
+    } else {
+      boost::throw_with_location(
+        std::logic_error("Values of this Queue can only be moved."));
     }
   }
 
   template<typename T>
   void Queue<T>::push(Target&& value) {
-    auto lock = boost::lock_guard(m_mutex);
-    if(m_break_exception) {
-      std::rethrow_exception(m_break_exception);
-    }
-    m_queue.push_back(std::move(value));
-    if(m_queue.size() == 1) {
-      m_is_available_condition.notify_one();
-    }
+    emplace(std::move(value), true);
   }
 
   template<typename T>
@@ -104,12 +224,57 @@ namespace Beam {
     }
     m_break_exception = exception;
     m_is_available_condition.notify_all();
+    m_is_space_available_condition.notify_all();
   }
 
   template<typename T>
   bool Queue<T>::unlocked_is_available() const {
     return !m_queue.empty() || m_break_exception;
   }
+
+  template<typename T>
+  template<typename V>
+  bool Queue<T>::emplace(V&& value, bool is_blocking) {
+    auto lock = boost::unique_lock(m_mutex);
+    if(m_break_exception) {
+      std::rethrow_exception(m_break_exception);
+    }
+    if(m_queue.size() >= m_capacity) {
+      if(!is_blocking) {
+        return false;
+      } else if(m_policy == OverflowPolicy::FAIL) {
+        boost::throw_with_location(QueueFullException());
+      } else if(m_policy == OverflowPolicy::DROP_OLDEST) {
+        m_queue.pop_front();
+      } else {
+        while(m_queue.size() >= m_capacity) {
+          ++m_blocked_count;
+          m_is_space_available_condition.wait(lock);
+          --m_blocked_count;
+          if(m_break_exception) {
+            std::rethrow_exception(m_break_exception);
+          }
+        }
+      }
+    }
+    m_queue.push_back(std::forward<V>(value));
+    if(m_queue.size() == 1) {
+      m_is_available_condition.notify_one();
+    }
+    return true;
+  }
+
+  template<typename T>
+  void Queue<T>::notify_space_available(std::size_t previous_size) {
+    if(m_blocked_count == 0 || m_queue.size() >= previous_size) {
+      return;
+    }
+    if(previous_size - m_queue.size() == 1) {
+      m_is_space_available_condition.notify_one();
+    } else {
+      m_is_space_available_condition.notify_all();
+    }
+  }
 }
 
 #endif
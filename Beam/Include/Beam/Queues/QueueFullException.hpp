@@ -0,0 +1,20 @@
+#ifndef BEAM_QUEUE_FULL_EXCEPTION_HPP
+#define BEAM_QUEUE_FULL_EXCEPTION_HPP
+#include <stdexcept>
+
+namespace Beam {
+
+  /** Thrown when a value is pushed onto a Queue that is at capacity. */
+  class QueueFullException : public std::runtime_error {
+    public:
+      using std::runtime_error::runtime_error;
+
+      /** Constructs a QueueFullException. */
+      QueueFullException();
+  };
+
+  inline QueueFullException::QueueFullException()
+    : QueueFullException("Queue full.") {}
+}
+
+#endif
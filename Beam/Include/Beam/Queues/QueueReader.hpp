@@ -1,6 +1,8 @@
 #ifndef BEAM_QUEUE_READER_HPP
 #define BEAM_QUEUE_READER_HPP
 #include <concepts>
+#include <limits>
+#include <vector>
 #include <boost/optional/optional.hpp>
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Pointers/Out.hpp"
@@ -30,8 +32,47 @@ namespace Beam {
        * without blocking, otherwise returns <i>boost::none</i>.
        */
       virtual boost::optional<Source> try_pop() = 0;
+
+      /**
+       * Pops values without blocking until either the queue is empty or a
+       * maximum number of values have been popped.
+       * @param values The vector to append the popped values to.
+       * @param max The maximum number of values to pop.
+       * @return The number of values popped.
+       */
+      virtual std::size_t try_pop_batch(
+        Out<std::vector<Source>> values, std::size_t max);
+
+      /**
+       * Blocks until a value is available and then pops every value in the
+       * queue.
+       */
+      virtual std::vector<Source> pop_all();
   };
 
+  template<typename T>
+  std::size_t QueueReader<T>::try_pop_batch(
+      Out<std::vector<Source>> values, std::size_t max) {
+    auto count = std::size_t(0);
+    while(count != max) {
+      auto value = try_pop();
+      if(!value) {
+        break;
+      }
+      values->push_back(std::move(*value));
+      ++count;
+    }
+    return count;
+  }
+
+  template<typename T>
+  std::vector<typename QueueReader<T>::Source> QueueReader<T>::pop_all() {
+    auto values = std::vector<Source>();
+    values.push_back(pop());
+    try_pop_batch(out(values), std::numeric_limits<std::size_t>::max());
+    return values;
+  }
+
   /**
    * Invokes a callable for each value popped from a queue until the queue is
    * broken.
@@ -0,0 +1,231 @@
+#ifndef BEAM_RING_QUEUE_HPP
+#define BEAM_RING_QUEUE_HPP
+#include <atomic>
+#include <concepts>
+#include <stdexcept>
+#include <boost/thread/mutex.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/Queues/AbstractQueue.hpp"
+#include "Beam/Queues/PipeBrokenException.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+
+namespace Beam {
+
+  /**
+   * Implements a Queue on top of a bounded lock-free ring buffer. Values are
+   * pushed and popped without acquiring a lock, a mutex is only used to
+   * suspend a Routine pushing onto a full queue or popping from an empty one.
+   * A Routine suspended pushing onto a full queue is resumed once the queue
+   * drains to half of its capacity, so that producers and consumers are not
+   * switched in and out on every value.
+   * @tparam T The data to store in the Queue.
+   * @tparam B The type of ring buffer, which determines how many threads may
+   *         push and pop concurrently.
+   */
+  template<typename T, typename B>
+  class RingQueue : public AbstractQueue<T> {
+    public:
+      using Target = typename AbstractQueue<T>::Target;
+      using Source = typename AbstractQueue<T>::Source;
+
+      /** The type of ring buffer used. */
+      using RingBuffer = B;
+
+      /** The default capacity. */
+      static constexpr auto DEFAULT_CAPACITY = std::size_t(1024);
+
+      /** Constructs a RingQueue with the default capacity. */
+      RingQueue();
+
+      /**
+       * Constructs a RingQueue.
+       * @param capacity The maximum number of values that can be stored,
+       *        rounded up to a power of two.
+       */
+      explicit RingQueue(std::size_t capacity);
+
+      /** Returns the maximum number of values that can be stored. */
+      std::size_t get_capacity() const;
+
+      /** Returns <code>true</code> iff this Queue is broken. */
+      bool is_broken() const;
+
+      /**
+       * Adds a value to the end of this Queue without blocking.
+       * @param value The value to add.
+       * @return <code>false</code> iff this Queue is full.
+       */
+      bool try_push(const Target& value);
+
+      /**
+       * Adds a value to the end of this Queue without blocking.
+       * @param value The value to add.
+       * @return <code>false</code> iff this Queue is full.
+       */
+      bool try_push(Target&& value);
+
+      Source pop() override;
+      boost::optional<Source> try_pop() override;
+
+      void push(const Target& value) override;
+      void push(Target&& value) override;
+      void close(const std::exception_ptr& exception) override;
+      using QueueWriter<T>::close;
+
+    private:
+      RingBuffer m_buffer;
+      std::atomic_bool m_is_broken;
+      std::atomic_bool m_is_reader_waiting;
+      std::atomic_size_t m_waiting_writer_count;
+      mutable boost::mutex m_mutex;
+      ConditionVariable m_is_available_condition;
+      ConditionVariable m_is_space_available_condition;
+      std::exception_ptr m_break_exception;
+
+      template<typename V>
+      bool emplace(V&& value);
+      template<typename V>
+      void wait_and_push(V&& value);
+      void notify_reader();
+      void notify_writers();
+  };
+
+  template<typename T, typename B>
+  RingQueue<T, B>::RingQueue()
+    : RingQueue(DEFAULT_CAPACITY) {}
+
+  template<typename T, typename B>
+  RingQueue<T, B>::RingQueue(std::size_t capacity)
+    : m_buffer(capacity),
+      m_is_broken(false),
+      m_is_reader_waiting(false),
+      m_waiting_writer_count(0) {}
+
+  template<typename T, typename B>
+  std::size_t RingQueue<T, B>::get_capacity() const {
+    return m_buffer.get_capacity();
+  }
+
+  template<typename T, typename B>
+  bool RingQueue<T, B>::is_broken() const {
+    return m_is_broken.load(std::memory_order_acquire) && m_buffer.is_empty();
+  }
+
+  template<typename T, typename B>
+  bool RingQueue<T, B>::try_push(const Target& value) {
+    return emplace(value);
+  }
+
+  template<typename T, typename B>
+  bool RingQueue<T, B>::try_push(Target&& value) {
+    return emplace(std::move(value));
+  }
+
+  template<typename T, typename B>
+  typename RingQueue<T, B>::Source RingQueue<T, B>::pop() {
+    while(true) {
+      if(auto value = try_pop()) {
+        return std::move(*value);
+      }
+      auto lock = boost::unique_lock(m_mutex);
+      m_is_reader_waiting.store(true, std::memory_order_seq_cst);
+      if(!m_buffer.is_empty()) {
+        m_is_reader_waiting.store(false, std::memory_order_relaxed);
+        continue;
+      }
+      if(m_break_exception) {
+        m_is_reader_waiting.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(m_break_exception);
+      }
+      m_is_available_condition.wait(lock);
+      m_is_reader_waiting.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  template<typename T, typename B>
+  boost::optional<typename RingQueue<T, B>::Source>
+      RingQueue<T, B>::try_pop() {
+    auto value = m_buffer.try_pop();
+    if(!value || m_buffer.get_size() == m_buffer.get_capacity() / 2) {
+      notify_writers();
+    }
+    return value;
+  }
+
+  template<typename T, typename B>
+  void RingQueue<T, B>::push(const Target& value) {
+    if constexpr(std::copy_constructible<T>) {
+      wait_and_push(value);
+    } else {
+      boost::throw_with_location(
+        std::logic_error("Values of this Queue can only be moved."));
+    }
+  }
+
+  template<typename T, typename B>
+  void RingQueue<T, B>::push(Target&& value) {
+    wait_and_push(std::move(value));
+  }
+
+  template<typename T, typename B>
+  void RingQueue<T, B>::close(const std::exception_ptr& exception) {
+    auto lock = boost::lock_guard(m_mutex);
+    if(m_break_exception) {
+      return;
+    }
+    m_break_exception = exception;
+    m_is_broken.store(true, std::memory_order_release);
+    m_is_available_condition.notify_all();
+    m_is_space_available_condition.notify_all();
+  }
+
+  template<typename T, typename B>
+  template<typename V>
+  bool RingQueue<T, B>::emplace(V&& value) {
+    if(m_is_broken.load(std::memory_order_acquire)) {
+      auto lock = boost::lock_guard(m_mutex);
+      std::rethrow_exception(m_break_exception);
+    }
+    if(!m_buffer.try_push(std::forward<V>(value))) {
+      return false;
+    }
+    notify_reader();
+    return true;
+  }
+
+  template<typename T, typename B>
+  template<typename V>
+  void RingQueue<T, B>::wait_and_push(V&& value) {
+    while(!emplace(std::forward<V>(value))) {
+      auto lock = boost::unique_lock(m_mutex);
+      m_waiting_writer_count.fetch_add(1, std::memory_order_seq_cst);
+      if(m_buffer.get_size() <= m_buffer.get_capacity() / 2 ||
+          m_break_exception) {
+        m_waiting_writer_count.fetch_sub(1, std::memory_order_relaxed);
+        continue;
+      }
+      m_is_space_available_condition.wait(lock);
+      m_waiting_writer_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  template<typename T, typename B>
+  void RingQueue<T, B>::notify_reader() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(m_is_reader_waiting.load(std::memory_order_relaxed)) {
+      auto lock = boost::lock_guard(m_mutex);
+      m_is_available_condition.notify_all();
+    }
+  }
+
+  template<typename T, typename B>
+  void RingQueue<T, B>::notify_writers() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(m_waiting_writer_count.load(std::memory_order_relaxed) != 0) {
+      auto lock = boost::lock_guard(m_mutex);
+      m_is_space_available_condition.notify_all();
+    }
+  }
+}
+
+#endif
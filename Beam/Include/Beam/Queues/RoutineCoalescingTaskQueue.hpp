@@ -0,0 +1,92 @@
+#ifndef BEAM_ROUTINE_COALESCING_TASK_QUEUE_HPP
+#define BEAM_ROUTINE_COALESCING_TASK_QUEUE_HPP
+#include <concepts>
+#include "Beam/Queues/CoalescingTaskQueue.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+
+namespace Beam {
+
+  /**
+   * Runs pushed tasks within a Routine, executing all pending tasks
+   * back-to-back each time the Routine is resumed.
+   */
+  class RoutineCoalescingTaskQueue : public QueueWriter<Task> {
+    public:
+
+      /** The type being pushed. */
+      using Target = QueueWriter<Task>::Target;
+
+      /** Constructs a RoutineCoalescingTaskQueue. */
+      RoutineCoalescingTaskQueue();
+
+      ~RoutineCoalescingTaskQueue();
+
+      /**
+       * Returns a slot.
+       * @param callback The callback when a new value is pushed.
+       * @return A queue that translates a push into a callback.
+       */
+      template<typename T, std::invocable<const T&> F>
+      auto get_slot(F&& callback);
+
+      /**
+       * Returns a slot.
+       * @param callback The callback when a new value is pushed.
+       * @param on_break The callback when the queue is broken.
+       * @return A queue that translates a push into a callback.
+       */
+      template<typename T, std::invocable<const T&> F,
+        std::invocable<const std::exception_ptr&> B>
+      auto get_slot(F&& callback, B&& on_break);
+
+      /** Waits for this queue to be broken and all tasks to complete. */
+      void wait();
+
+      void push(const Target& value) override;
+      void push(Target&& value) override;
+      void close(const std::exception_ptr& exception) override;
+      using QueueWriter<Task>::close;
+
+    private:
+      CoalescingTaskQueue m_tasks;
+      RoutineHandler m_routine;
+  };
+
+  inline RoutineCoalescingTaskQueue::RoutineCoalescingTaskQueue()
+    : m_routine(spawn_batch_loop(&m_tasks)) {}
+
+  inline RoutineCoalescingTaskQueue::~RoutineCoalescingTaskQueue() {
+    close();
+  }
+
+  template<typename T, std::invocable<const T&> F>
+  auto RoutineCoalescingTaskQueue::get_slot(F&& callback) {
+    return m_tasks.get_slot<T>(std::forward<F>(callback));
+  }
+
+  template<typename T, std::invocable<const T&> F,
+    std::invocable<const std::exception_ptr&> B>
+  auto RoutineCoalescingTaskQueue::get_slot(F&& callback, B&& on_break) {
+    return m_tasks.get_slot<T>(
+      std::forward<F>(callback), std::forward<B>(on_break));
+  }
+
+  inline void RoutineCoalescingTaskQueue::wait() {
+    m_routine.wait();
+  }
+
+  inline void RoutineCoalescingTaskQueue::push(const Target& value) {
+    m_tasks.push(value);
+  }
+
+  inline void RoutineCoalescingTaskQueue::push(Target&& value) {
+    m_tasks.push(std::move(value));
+  }
+
+  inline void RoutineCoalescingTaskQueue::close(
+      const std::exception_ptr& exception) {
+    m_tasks.close(exception);
+  }
+}
+
+#endif
@@ -40,6 +40,9 @@ namespace Beam {
 
       Source pop() override;
       boost::optional<Source> try_pop() override;
+      std::size_t try_pop_batch(
+        Out<std::vector<Source>> values, std::size_t max) override;
+      std::vector<Source> pop_all() override;
       void close(const std::exception_ptr& e) override;
       template<typename U>
       ScopedQueueReader& operator =(
@@ -90,6 +93,24 @@ namespace Beam {
     return boost::none;
   }
 
+  template<typename T, typename Q>
+  std::size_t ScopedQueueReader<T, Q>::try_pop_batch(
+      Out<std::vector<Source>> values, std::size_t max) {
+    if(m_queue) {
+      return m_queue->try_pop_batch(out(values), max);
+    }
+    return 0;
+  }
+
+  template<typename T, typename Q>
+  std::vector<typename ScopedQueueReader<T, Q>::Source>
+      ScopedQueueReader<T, Q>::pop_all() {
+    if(m_queue) {
+      return m_queue->pop_all();
+    }
+    boost::throw_with_location(PipeBrokenException());
+  }
+
   template<typename T, typename Q>
   void ScopedQueueReader<T, Q>::close(const std::exception_ptr& e) {
     if(m_queue) {
@@ -0,0 +1,168 @@
+#ifndef BEAM_SPSC_QUEUE_HPP
+#define BEAM_SPSC_QUEUE_HPP
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <boost/optional/optional.hpp>
+#include "Beam/Queues/RingQueue.hpp"
+
+namespace Beam {
+
+  /**
+   * Implements a bounded lock-free ring buffer with a single producer thread
+   * and a single consumer thread.
+   * @tparam T The type of value to store.
+   */
+  template<typename T>
+  class SpscRingBuffer {
+    public:
+
+      /** The type of value to store. */
+      using Value = T;
+
+      /**
+       * Constructs an SpscRingBuffer.
+       * @param capacity The maximum number of values that can be stored,
+       *        rounded up to a power of two.
+       */
+      explicit SpscRingBuffer(std::size_t capacity);
+
+      ~SpscRingBuffer();
+
+      /** Returns the maximum number of values that can be stored. */
+      std::size_t get_capacity() const;
+
+      /** Returns an approximation of the number of values stored. */
+      std::size_t get_size() const;
+
+      /** Returns <code>true</code> iff the buffer appears empty. */
+      bool is_empty() const;
+
+      /** Returns <code>true</code> iff the buffer appears full. */
+      bool is_full() const;
+
+      /**
+       * Pushes a value, must only be called by the producer.
+       * @param value The value to push, left untouched if the buffer is full.
+       * @return <code>false</code> iff the buffer is full.
+       */
+      template<typename V>
+      bool try_push(V&& value);
+
+      /** Pops a value, must only be called by the consumer. */
+      boost::optional<Value> try_pop();
+
+    private:
+      struct Slot {
+        alignas(Value) std::byte m_storage[sizeof(Value)];
+      };
+      std::uint64_t m_mask;
+      std::unique_ptr<Slot[]> m_slots;
+      alignas(64) std::atomic_uint64_t m_head;
+      std::uint64_t m_cached_tail;
+      alignas(64) std::atomic_uint64_t m_tail;
+      std::uint64_t m_cached_head;
+
+      Value& get(std::uint64_t index);
+      SpscRingBuffer(const SpscRingBuffer&) = delete;
+      SpscRingBuffer& operator =(const SpscRingBuffer&) = delete;
+  };
+
+  /**
+   * Implements a Queue with a single pushing Routine and a single popping
+   * Routine, which may be on different threads.
+   * @tparam T The data to store in the Queue.
+   */
+  template<typename T>
+  using SpscQueue = RingQueue<T, SpscRingBuffer<T>>;
+
+  template<typename T>
+  SpscRingBuffer<T>::SpscRingBuffer(std::size_t capacity)
+    : m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1),
+      m_slots(std::make_unique<Slot[]>(m_mask + 1)),
+      m_head(0),
+      m_cached_tail(0),
+      m_tail(0),
+      m_cached_head(0) {}
+
+  template<typename T>
+  SpscRingBuffer<T>::~SpscRingBuffer() {
+    auto tail = m_tail.load(std::memory_order_acquire);
+    for(auto i = m_head.load(std::memory_order_relaxed); i != tail; ++i) {
+      std::destroy_at(&get(i));
+    }
+  }
+
+  template<typename T>
+  std::size_t SpscRingBuffer<T>::get_capacity() const {
+    return static_cast<std::size_t>(m_mask + 1);
+  }
+
+  template<typename T>
+  std::size_t SpscRingBuffer<T>::get_size() const {
+    auto head = m_head.load(std::memory_order_acquire);
+    auto tail = m_tail.load(std::memory_order_acquire);
+    if(tail <= head) {
+      return 0;
+    }
+    return static_cast<std::size_t>(tail - head);
+  }
+
+  template<typename T>
+  bool SpscRingBuffer<T>::is_empty() const {
+    return m_head.load(std::memory_order_acquire) ==
+      m_tail.load(std::memory_order_acquire);
+  }
+
+  template<typename T>
+  bool SpscRingBuffer<T>::is_full() const {
+    return m_tail.load(std::memory_order_acquire) -
+      m_head.load(std::memory_order_acquire) > m_mask;
+  }
+
+  template<typename T>
+  template<typename V>
+  bool SpscRingBuffer<T>::try_push(V&& value) {
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    if(tail - m_cached_head > m_mask) {
+      m_cached_head = m_head.load(std::memory_order_acquire);
+      if(tail - m_cached_head > m_mask) {
+        return false;
+      }
+    }
+    std::construct_at(
+      reinterpret_cast<Value*>(m_slots[tail & m_mask].m_storage),
+      std::forward<V>(value));
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  template<typename T>
+  boost::optional<typename SpscRingBuffer<T>::Value>
+      SpscRingBuffer<T>::try_pop() {
+    auto head = m_head.load(std::memory_order_relaxed);
+    if(head == m_cached_tail) {
+      m_cached_tail = m_tail.load(std::memory_order_acquire);
+      if(head == m_cached_tail) {
+        return boost::none;
+      }
+    }
+    auto& slot = get(head);
+    auto value = boost::optional<Value>(std::move(slot));
+    std::destroy_at(&slot);
+    m_head.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  template<typename T>
+  typename SpscRingBuffer<T>::Value& SpscRingBuffer<T>::get(
+      std::uint64_t index) {
+    return *std::launder(
+      reinterpret_cast<Value*>(m_slots[index & m_mask].m_storage));
+  }
+}
+
+#endif
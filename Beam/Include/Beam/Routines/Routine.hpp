@@ -34,6 +34,23 @@ namespace Details {
     return m_value;
   }
 #endif
+
+  /** The number of consecutive ids each thread reserves at a time. */
+  inline constexpr auto ROUTINE_ID_BLOCK_SIZE = std::uint64_t(1024);
+
+  /**
+   * Returns a unique id, reserving ids from NextId in blocks local to the
+   * calling thread so that threads do not contend over a single counter.
+   */
+  inline std::uint64_t load_next_id() {
+    static thread_local auto next_id = std::uint64_t(0);
+    static thread_local auto last_id = std::uint64_t(0);
+    if(next_id == last_id) {
+      next_id = NextId::get().fetch_add(ROUTINE_ID_BLOCK_SIZE) + 1;
+      last_id = next_id + ROUTINE_ID_BLOCK_SIZE;
+    }
+    return next_id++;
+  }
 }
 
   /** Encapsulates a single sub-routine spawned by a Scheduler. */
@@ -99,8 +116,17 @@ namespace Details {
       /** Sets the State. */
       void set(State state);
 
+      /**
+       * Signals every wait for this Routine, including any made after this
+       * call, without waiting for this Routine to be destroyed.
+       */
+      void release_waits();
+
     private:
-      using WaitResults = std::vector<Eval<void>>;
+      struct WaitResults {
+        std::vector<Eval<void>> m_results;
+        bool m_is_released = false;
+      };
       friend class Mutex;
       friend class RecursiveMutex;
       friend void defer();
@@ -173,16 +199,11 @@ namespace Details {
   }
 
   inline Routine::Routine() noexcept
-    : m_id(++Details::NextId::get()),
+    : m_id(Details::load_next_id()),
       m_state(State::PENDING) {}
 
   inline Routine::~Routine() {
-    with(m_wait_results, [&] (auto& results) {
-      for(auto& result : results) {
-        result.set();
-      }
-      results.clear();
-    });
+    release_waits();
     assert(m_state == State::COMPLETE || m_state == State::PENDING);
   }
 
@@ -195,15 +216,32 @@ namespace Details {
   }
 
   inline void Routine::wait(Eval<void> result) {
-    with(m_wait_results, [&] (auto& results) {
-      results.push_back(std::move(result));
+    auto is_released = with(m_wait_results, [&] (auto& results) {
+      if(results.m_is_released) {
+        return true;
+      }
+      results.m_results.push_back(std::move(result));
+      return false;
     });
+    if(is_released) {
+      result.set();
+    }
   }
 
   inline void Routine::set(State state) {
     m_state = state;
   }
 
+  inline void Routine::release_waits() {
+    auto results = with(m_wait_results, [&] (auto& results) {
+      results.m_is_released = true;
+      return std::move(results.m_results);
+    });
+    for(auto& result : results) {
+      result.set();
+    }
+  }
+
   inline void Routine::defer() {}
 
   inline void Routine::pending_suspend() {}
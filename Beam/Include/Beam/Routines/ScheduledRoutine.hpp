@@ -1,5 +1,7 @@
 #ifndef BEAM_SCHEDULED_ROUTINE_HPP
 #define BEAM_SCHEDULED_ROUTINE_HPP
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <stacktrace>
 #ifdef WIN32
@@ -16,6 +18,7 @@
 #endif
 #include "Beam/Pointers/Ref.hpp"
 #include "Beam/Routines/Routine.hpp"
+#include "Beam/Routines/StackPool.hpp"
 #include "Beam/Utilities/DllExport.hpp"
 #include "Beam/Utilities/ReportException.hpp"
 
@@ -31,6 +34,12 @@ namespace Details {
       /** Returns the id of the context this Routine is running in. */
       std::size_t get_context_id() const;
 
+      /**
+       * Returns <code>true</code> iff this Routine was assigned an explicit
+       * context id and must not migrate to another context.
+       */
+      bool is_pinned() const;
+
       /**
        * Continues execution of this Routine from its last defer point or from
        * the beginning if it has not yet executed.
@@ -55,8 +64,10 @@ namespace Details {
     private:
       friend class Details::Scheduler;
       bool m_is_pending_resume;
+      bool m_is_pinned;
       std::size_t m_stack_size;
-      std::size_t m_context_id;
+      std::atomic_size_t m_context_id;
+      std::chrono::steady_clock::time_point m_ready_time;
       boost::context::continuation m_continuation;
       boost::context::continuation m_parent;
       #ifdef BEAM_ENABLE_STACK_PRINT
@@ -67,12 +78,17 @@ namespace Details {
 
       bool is_pending_resume() const;
       void set_pending_resume(bool value);
+      void set_context_id(std::size_t context_id);
       BEAM_EXPORT_DLL boost::context::continuation initialize(
         boost::context::continuation&& parent);
   };
 
   inline std::size_t ScheduledRoutine::get_context_id() const {
-    return m_context_id;
+    return m_context_id.load(std::memory_order_relaxed);
+  }
+
+  inline bool ScheduledRoutine::is_pinned() const {
+    return m_is_pinned;
   }
 
 #ifndef BEAM_USE_DLL
@@ -82,7 +98,7 @@ namespace Details {
     if(get_state() == State::PENDING) {
       set(State::RUNNING);
       m_continuation = boost::context::callcc(std::allocator_arg,
-        boost::context::fixedsize_stack(m_stack_size),
+        PooledStack(m_stack_size),
         [this] (boost::context::continuation&& parent) {
           return initialize(std::move(parent));
         });
@@ -97,13 +113,9 @@ namespace Details {
   inline ScheduledRoutine::ScheduledRoutine(
       std::size_t stack_size, std::size_t context_id) noexcept
       : m_is_pending_resume(false),
-        m_stack_size(stack_size) {
-    if(context_id == -1) {
-      m_context_id = get_id() % boost::thread::hardware_concurrency();
-    } else {
-      m_context_id = context_id;
-    }
-  }
+        m_is_pinned(context_id != -1),
+        m_stack_size(stack_size),
+        m_context_id(context_id == -1 ? 0 : context_id) {}
 
 #ifndef BEAM_USE_DLL
   BEAM_DISABLE_OPTIMIZATIONS
@@ -143,6 +155,10 @@ namespace Details {
     m_is_pending_resume = value;
   }
 
+  inline void ScheduledRoutine::set_context_id(std::size_t context_id) {
+    m_context_id.store(context_id, std::memory_order_relaxed);
+  }
+
 #ifndef BEAM_USE_DLL
   BEAM_EMIT_DLL
   inline boost::context::continuation ScheduledRoutine::initialize(
@@ -1,17 +1,26 @@
 #ifndef BEAM_SCHEDULER_HPP
 #define BEAM_SCHEDULER_HPP
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include "Beam/Routines/FunctionRoutine.hpp"
+#include "Beam/Routines/SchedulerStatistics.hpp"
+#include "Beam/Routines/WorkStealingQueue.hpp"
 #include "Beam/Threading/Sync.hpp"
+#include "Beam/Threading/WorkerConfig.hpp"
 #include "Beam/Utilities/ReportException.hpp"
 #include "Beam/Utilities/Singleton.hpp"
 
@@ -23,21 +32,85 @@
   #endif
 #endif
 
+#ifndef BEAM_SCHEDULER_DEFAULT_MODE
+  #define BEAM_SCHEDULER_DEFAULT_MODE FIXED
+#endif
+
 namespace Beam {
 namespace Details {
+  struct BEAM_EXPORT_DLL CurrentContextGlobal {
+    static std::size_t& get();
+  };
+
+#ifndef BEAM_USE_DLL
+  BEAM_EMIT_DLL inline std::size_t& CurrentContextGlobal::get() {
+    static thread_local auto value = static_cast<std::size_t>(-1);
+    return value;
+  }
+#endif
 
   /** Schedules the execution of Routines across multiple threads. */
   class BEAM_EXPORT_DLL Scheduler : public Singleton<Scheduler> {
     public:
 
+      /** Lists the policies used to assign Routines to contexts. */
+      enum class Mode {
+
+        /** Every Routine runs exclusively in the context it's assigned. */
+        FIXED,
+
+        /**
+         * Idle contexts steal Routines from busy contexts, except for Routines
+         * spawned with an explicit context id which remain pinned. Migrated
+         * Routines must not hold onto thread local state across a defer or
+         * suspend.
+         */
+        WORK_STEALING
+      };
+
       /** The default size of a Routine's stack. */
       static constexpr auto DEFAULT_STACK_SIZE =
         std::size_t(BEAM_SCHEDULER_DEFAULT_STACK_SIZE);
 
+      /** The default Mode. */
+      static constexpr auto DEFAULT_MODE = Mode::BEAM_SCHEDULER_DEFAULT_MODE;
+
+      /** Stores the configuration used to construct the Scheduler. */
+      struct Config {
+
+        /** The Mode used to assign Routines to contexts. */
+        Mode m_mode = DEFAULT_MODE;
+
+        /**
+         * The configuration of the worker threads, one per context. When
+         * workers are pinned, Routines are only stolen between contexts on the
+         * same NUMA node.
+         */
+        WorkerConfig m_workers;
+
+        /**
+         * The interval at which the ContextStatistics of every context are
+         * reported, or infinity to never report them.
+         */
+        boost::posix_time::time_duration m_statistics_interval =
+          boost::posix_time::pos_infin;
+
+        /**
+         * The callback given the ContextStatistics of each context at every
+         * statistics interval, with counts and histograms covering only that
+         * interval, or null to write them to stdout.
+         */
+        std::function<void (const ContextStatistics&)> m_statistics_handler;
+      };
+
       /**
-       * Constructs a Scheduler with a number of threads equal to the system's
-       * concurrency.
+       * Sets the Config used to construct the Scheduler, must be called before
+       * the first Routine is spawned.
+       * @param config The Config to use.
        */
+      static void set_config(const Config& config);
+
+      /** Constructs a Scheduler using the Config last set. */
       Scheduler();
 
       ~Scheduler();
@@ -45,6 +118,14 @@ namespace Details {
       /** Returns the number of threads used by the Scheduler. */
       std::size_t get_thread_count() const;
 
+      /** Returns the Mode used to assign Routines to contexts. */
+      Mode get_mode() const;
+
+      /**
+       * Returns the NUMA node of a context, or -1 if its worker is unpinned.
+       */
+      int get_numa_node(std::size_t context_id) const;
+
       /**
        * Returns <code>true</code> iff the context with the specified <i>id</i>
        * has Routines pending.
@@ -57,6 +138,14 @@ namespace Details {
       /** Returns the number of Routines that are pending or running. */
       std::size_t get_busy_count() const;
 
+      /**
+       * Returns a snapshot of the activity of a context. Counters are updated
+       * by the context's worker thread without synchronization so the
+       * snapshot is only approximately consistent.
+       * @param context_id The id of the context.
+       */
+      ContextStatistics get_statistics(std::size_t context_id) const;
+
       /**
        * Registers a callback for when no Routine is pending or running.
        * @param idle The Eval to set once no Routine is pending or running,
@@ -74,8 +163,9 @@ namespace Details {
        * Spawns a Routine from a callable object.
        * @param f The callable object to run within the Routine.
        * @param stack_size The size of the stack to allocate for the Routine.
-       * @param context_id The specific context id to run the Routine in, or
-       *        set to the number of threads to assign it an arbitrary context.
+       * @param context_id The specific context id to run the Routine in, taken
+       *        modulo the number of threads, or -1 to assign it an arbitrary
+       *        context.
        * @return A unique ID used to identify the Routine.
        */
       template<typename F>
@@ -91,41 +181,126 @@ namespace Details {
       struct Context {
         boost::mutex m_mutex;
         bool m_is_running;
+        int m_numa_node;
+        std::atomic_bool m_is_sleeping;
+        std::uint64_t m_tick;
         std::deque<ScheduledRoutine*> m_pending_routines;
+        std::deque<ScheduledRoutine*> m_shared_routines;
+        std::atomic_size_t m_queued_count;
+        WorkStealingQueue<ScheduledRoutine*> m_local_routines;
         std::unordered_set<ScheduledRoutine*> m_suspended_routines;
+        std::vector<ScheduledRoutine*> m_completed_routines;
         boost::condition_variable m_pending_routines_available_condition;
+        std::atomic_uint64_t m_context_switches;
+        LiveLatencyHistogram m_scheduling_latency;
+        LiveLatencyHistogram m_slice_duration;
+        std::atomic<std::chrono::nanoseconds::rep> m_longest_slice;
+        std::atomic<Routine::Id> m_longest_slice_routine;
+        std::atomic<std::chrono::nanoseconds::rep> m_slice_start;
+        std::atomic<Routine::Id> m_running_routine;
 
         Context();
       };
       using RoutineIds = std::unordered_map<Routine::Id, ScheduledRoutine*>;
+      struct alignas(64) RoutineIdsShard {
+        Sync<RoutineIds> m_ids;
+      };
+      struct ConfigEntry {
+        boost::mutex m_mutex;
+        Config m_config;
+        bool m_is_started = false;
+      };
+      static constexpr auto SHARED_POLL_INTERVAL = std::uint64_t(61);
+      static constexpr auto ROUTINE_IDS_SHARD_COUNT = std::size_t(64);
+      static constexpr auto COMPLETED_BATCH_SIZE = std::size_t(64);
       friend class Beam::ScheduledRoutine;
       friend void resume(ScheduledRoutine*& routine);
+      Config m_config;
+      Mode m_mode;
       std::size_t m_thread_count;
       std::unique_ptr<boost::thread[]> m_threads;
-      Sync<RoutineIds> m_routine_ids;
+      std::array<RoutineIdsShard, ROUTINE_IDS_SHARD_COUNT> m_routine_ids;
       std::unique_ptr<Context[]> m_contexts;
       std::atomic_size_t m_busy_count;
+      std::atomic_size_t m_sleeping_count;
       boost::mutex m_idle_mutex;
       std::vector<Eval<void>> m_idle_evals;
-
+      boost::mutex m_monitor_mutex;
+      bool m_is_monitoring;
+      boost::condition_variable m_monitor_condition;
+      boost::thread m_monitor;
+
+      static ConfigEntry& get_config_entry();
+      static Config load_config();
+      Sync<RoutineIds>& get_routine_ids(Routine::Id id);
       void queue(ScheduledRoutine& routine);
+      void push(Context& context, ScheduledRoutine& routine);
       void suspend(ScheduledRoutine& routine);
       void resume(ScheduledRoutine& routine);
-      void run(Context& context);
+      void run(std::size_t context_id);
+      void retire(Context& context);
+      void record_slice(Context& context, Routine::Id id,
+        std::chrono::steady_clock::time_point start);
+      void monitor();
+      bool try_pop_queued(Context& context, ScheduledRoutine*& routine);
+      bool try_pop(std::size_t context_id, ScheduledRoutine*& routine);
+      bool try_steal(std::size_t context_id, ScheduledRoutine*& routine);
+      ScheduledRoutine* pop(std::size_t context_id);
+      void wake_idle_context(std::size_t context_id);
       void decrement_busy_count();
   };
 
   inline Scheduler::Context::Context()
-    : m_is_running(true) {}
+    : m_is_running(true),
+      m_numa_node(-1),
+      m_is_sleeping(false),
+      m_tick(0),
+      m_queued_count(0),
+      m_context_switches(0),
+      m_longest_slice(0),
+      m_longest_slice_routine(0),
+      m_slice_start(0),
+      m_running_routine(0) {}
+
+  inline void Scheduler::set_config(const Config& config) {
+    auto& entry = get_config_entry();
+    auto lock = boost::lock_guard(entry.m_mutex);
+    if(entry.m_is_started) {
+      boost::throw_with_location(
+        std::logic_error("Scheduler already started."));
+    }
+    entry.m_config = config;
+  }
 
   inline Scheduler::Scheduler()
-      : m_thread_count(boost::thread::hardware_concurrency()),
+      : m_config(load_config()),
+        m_mode(m_config.m_mode),
+        m_thread_count(Beam::get_thread_count(m_config.m_workers)),
         m_threads(std::make_unique<boost::thread[]>(m_thread_count)),
         m_contexts(std::make_unique<Context[]>(m_thread_count)),
-        m_busy_count(0) {
+        m_busy_count(0),
+        m_sleeping_count(0),
+        m_is_monitoring(false) {
+    StackPool::get();
+    for(auto i = std::size_t(0); i < m_thread_count; ++i) {
+      m_contexts[i].m_numa_node =
+        Beam::get_numa_node(m_config.m_workers, i);
+    }
     for(auto i = std::size_t(0); i < m_thread_count; ++i) {
       m_threads[i] = boost::thread([=, this] {
-        run(m_contexts[i]);
+        try {
+          set_thread_affinity(get_cpu_set(m_config.m_workers, i));
+        } catch(...) {
+          std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+        }
+        run(i);
+      });
+    }
+    if(!m_config.m_statistics_interval.is_special() &&
+        m_config.m_statistics_interval > boost::posix_time::seconds(0)) {
+      m_is_monitoring = true;
+      m_monitor = boost::thread([this] {
+        monitor();
       });
     }
   }
@@ -138,10 +313,22 @@ namespace Details {
     return m_thread_count;
   }
 
+  inline Scheduler::Mode Scheduler::get_mode() const {
+    return m_mode;
+  }
+
+  inline int Scheduler::get_numa_node(std::size_t context_id) const {
+    return m_contexts[context_id].m_numa_node;
+  }
+
   inline bool Scheduler::has_pending_routines(std::size_t context_id) const {
     auto& context = m_contexts[context_id];
+    if(!context.m_local_routines.is_empty()) {
+      return true;
+    }
     auto lock = boost::lock_guard(context.m_mutex);
-    return !context.m_pending_routines.empty();
+    return !context.m_pending_routines.empty() ||
+      !context.m_shared_routines.empty();
   }
 
   inline bool Scheduler::is_idle() const {
@@ -152,6 +339,39 @@ namespace Details {
     return m_busy_count;
   }
 
+  inline ContextStatistics Scheduler::get_statistics(
+      std::size_t context_id) const {
+    auto& context = m_contexts[context_id];
+    auto statistics = ContextStatistics();
+    statistics.m_context_id = context_id;
+    {
+      auto lock = boost::lock_guard(context.m_mutex);
+      statistics.m_queue_depth = context.m_pending_routines.size() +
+        context.m_shared_routines.size();
+      statistics.m_suspended_count = context.m_suspended_routines.size();
+    }
+    statistics.m_queue_depth += context.m_local_routines.get_size();
+    statistics.m_context_switches =
+      context.m_context_switches.load(std::memory_order_relaxed);
+    statistics.m_scheduling_latency = context.m_scheduling_latency.load();
+    statistics.m_slice_duration = context.m_slice_duration.load();
+    statistics.m_longest_slice = std::chrono::nanoseconds(
+      context.m_longest_slice.load(std::memory_order_relaxed));
+    statistics.m_longest_slice_routine =
+      context.m_longest_slice_routine.load(std::memory_order_relaxed);
+    statistics.m_running_routine =
+      context.m_running_routine.load(std::memory_order_acquire);
+    if(statistics.m_running_routine != 0) {
+      auto start = std::chrono::steady_clock::time_point(
+        std::chrono::nanoseconds(
+          context.m_slice_start.load(std::memory_order_relaxed)));
+      statistics.m_running_time = std::max(std::chrono::nanoseconds(0),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start));
+    }
+    return statistics;
+  }
+
   inline void Scheduler::notify_when_idle(Eval<void> idle) {
     {
       auto lock = boost::lock_guard(m_idle_mutex);
@@ -166,7 +386,7 @@ namespace Details {
   inline void Scheduler::wait(Routine::Id id) {
     assert(get_current_routine().get_id() != id);
     auto wait_async = Async<void>();
-    auto wait = with(m_routine_ids, [&] (auto& ids) {
+    auto wait = with(get_routine_ids(id), [&] (auto& ids) {
       auto i = ids.find(id);
       if(i == ids.end()) {
         return false;
@@ -186,7 +406,12 @@ namespace Details {
     auto routine =
       new FunctionRoutine(std::forward<F>(f), stack_size, context_id);
     auto id = routine->get_id();
-    with(m_routine_ids, [&] (auto& ids) {
+    if(routine->is_pinned()) {
+      routine->set_context_id(context_id % m_thread_count);
+    } else {
+      routine->set_context_id(id % m_thread_count);
+    }
+    with(get_routine_ids(id), [&] (auto& ids) {
       ids.insert(std::pair(id, routine));
     });
     ++m_busy_count;
@@ -194,11 +419,55 @@ namespace Details {
     return id;
   }
 
+  inline Scheduler::ConfigEntry& Scheduler::get_config_entry() {
+    static auto entry = ConfigEntry();
+    return entry;
+  }
+
+  inline Scheduler::Config Scheduler::load_config() {
+    auto& entry = get_config_entry();
+    auto lock = boost::lock_guard(entry.m_mutex);
+    entry.m_is_started = true;
+    return entry.m_config;
+  }
+
+  inline Sync<Scheduler::RoutineIds>& Scheduler::get_routine_ids(
+      Routine::Id id) {
+    return m_routine_ids[((id - 1) / ROUTINE_ID_BLOCK_SIZE) %
+      ROUTINE_IDS_SHARD_COUNT].m_ids;
+  }
+
   inline void Scheduler::queue(ScheduledRoutine& routine) {
-    auto& context = m_contexts[routine.get_context_id()];
-    auto lock = boost::lock_guard(context.m_mutex);
-    context.m_pending_routines.push_back(&routine);
-    if(context.m_pending_routines.size() == 1) {
+    if(m_mode == Mode::WORK_STEALING && !routine.is_pinned()) {
+      auto current_context_id = CurrentContextGlobal::get();
+      if(current_context_id != -1) {
+        routine.set_context_id(current_context_id);
+        routine.m_ready_time = std::chrono::steady_clock::now();
+        if(m_contexts[current_context_id].m_local_routines.push(&routine)) {
+          wake_idle_context(current_context_id);
+          return;
+        }
+      }
+    }
+    auto context_id = routine.get_context_id();
+    {
+      auto& context = m_contexts[context_id];
+      auto lock = boost::lock_guard(context.m_mutex);
+      push(context, routine);
+    }
+    if(m_mode == Mode::WORK_STEALING && !routine.is_pinned()) {
+      wake_idle_context(context_id);
+    }
+  }
+
+  inline void Scheduler::push(Context& context, ScheduledRoutine& routine) {
+    routine.m_ready_time = std::chrono::steady_clock::now();
+    if(m_mode == Mode::WORK_STEALING && !routine.is_pinned()) {
+      context.m_shared_routines.push_back(&routine);
+    } else {
+      context.m_pending_routines.push_back(&routine);
+    }
+    if(++context.m_queued_count == 1) {
       context.m_pending_routines_available_condition.notify_all();
     }
   }
@@ -210,30 +479,47 @@ namespace Details {
       routine.set(Routine::State::SUSPENDED);
       if(routine.is_pending_resume()) {
         routine.set_pending_resume(false);
-        context.m_pending_routines.push_back(&routine);
-        context.m_pending_routines_available_condition.notify_all();
+        if(m_mode == Mode::FIXED || routine.is_pinned()) {
+          push(context, routine);
+          return;
+        }
+      } else {
+        context.m_suspended_routines.insert(&routine);
+        decrement_busy_count();
         return;
       }
-      context.m_suspended_routines.insert(&routine);
     }
-    decrement_busy_count();
+    queue(routine);
   }
 
   inline void Scheduler::resume(ScheduledRoutine& routine) {
     auto& context = m_contexts[routine.get_context_id()];
-    auto lock = boost::lock_guard(context.m_mutex);
-    auto i = context.m_suspended_routines.find(&routine);
-    if(i == context.m_suspended_routines.end()) {
-      routine.set_pending_resume(true);
-      return;
+    {
+      auto lock = boost::lock_guard(context.m_mutex);
+      auto i = context.m_suspended_routines.find(&routine);
+      if(i == context.m_suspended_routines.end()) {
+        routine.set_pending_resume(true);
+        return;
+      }
+      context.m_suspended_routines.erase(i);
+      ++m_busy_count;
+      if(m_mode == Mode::FIXED || routine.is_pinned()) {
+        push(context, routine);
+        return;
+      }
     }
-    context.m_suspended_routines.erase(i);
-    ++m_busy_count;
-    context.m_pending_routines.push_back(&routine);
-    context.m_pending_routines_available_condition.notify_all();
+    queue(routine);
   }
 
   inline void Scheduler::stop() {
+    {
+      auto lock = boost::lock_guard(m_monitor_mutex);
+      m_is_monitoring = false;
+      m_monitor_condition.notify_all();
+    }
+    if(m_monitor.joinable()) {
+      m_monitor.join();
+    }
     for(auto i = std::size_t(0); i != m_thread_count; ++i) {
       auto& context = m_contexts[i];
       auto lock = boost::lock_guard(context.m_mutex);
@@ -249,27 +535,29 @@ namespace Details {
     }
   }
 
-  inline void Scheduler::run(Context& context) {
-    while(true) {
-      auto routine = static_cast<ScheduledRoutine*>(nullptr);
-      {
-        auto lock = boost::unique_lock(context.m_mutex);
-        while(context.m_pending_routines.empty()) {
-          if(!context.m_is_running && context.m_pending_routines.empty() &&
-              context.m_suspended_routines.empty()) {
-            return;
-          }
-          context.m_pending_routines_available_condition.wait(lock);
-        }
-        routine = context.m_pending_routines.front();
-        context.m_pending_routines.pop_front();
-      }
+  inline void Scheduler::run(std::size_t context_id) {
+    CurrentContextGlobal::get() = context_id;
+    auto& context = m_contexts[context_id];
+    while(auto routine = pop(context_id)) {
+      auto id = routine->get_id();
+      auto start = std::chrono::steady_clock::now();
+      context.m_scheduling_latency.add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          start - routine->m_ready_time));
+      context.m_slice_start.store(std::chrono::duration_cast<
+        std::chrono::nanoseconds>(start.time_since_epoch()).count(),
+        std::memory_order_relaxed);
+      context.m_running_routine.store(id, std::memory_order_release);
       routine->advance();
+      record_slice(context, id, start);
       if(routine->get_state() == Routine::State::COMPLETE) {
-        with(m_routine_ids, [&] (auto& ids) {
-          ids.erase(routine->get_id());
-        });
-        delete routine;
+        routine->release_waits();
+        context.m_completed_routines.push_back(routine);
+        if(context.m_completed_routines.size() == COMPLETED_BATCH_SIZE ||
+            (context.m_queued_count == 0 &&
+              context.m_local_routines.is_empty())) {
+          retire(context);
+        }
         decrement_busy_count();
       } else if(routine->get_state() == Routine::State::PENDING_SUSPEND) {
         suspend(*routine);
@@ -277,6 +565,199 @@ namespace Details {
         queue(*routine);
       }
     }
+    retire(context);
+    CurrentContextGlobal::get() = -1;
+  }
+
+  inline void Scheduler::retire(Context& context) {
+    auto& routines = context.m_completed_routines;
+    std::ranges::sort(routines, {}, [&] (auto routine) {
+      return &get_routine_ids(routine->get_id());
+    });
+    for(auto i = routines.begin(); i != routines.end();) {
+      auto& ids = get_routine_ids((*i)->get_id());
+      auto end = std::find_if(i, routines.end(), [&] (auto routine) {
+        return &get_routine_ids(routine->get_id()) != &ids;
+      });
+      with(ids, [&] (auto& ids) {
+        for(auto j = i; j != end; ++j) {
+          ids.erase((*j)->get_id());
+        }
+      });
+      i = end;
+    }
+    for(auto routine : routines) {
+      delete routine;
+    }
+    routines.clear();
+  }
+
+  inline void Scheduler::record_slice(Context& context, Routine::Id id,
+      std::chrono::steady_clock::time_point start) {
+    auto slice = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+    context.m_running_routine.store(0, std::memory_order_relaxed);
+    context.m_context_switches.store(
+      context.m_context_switches.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+    context.m_slice_duration.add(slice);
+    if(slice.count() >
+        context.m_longest_slice.load(std::memory_order_relaxed)) {
+      context.m_longest_slice_routine.store(id, std::memory_order_relaxed);
+      context.m_longest_slice.store(slice.count(), std::memory_order_relaxed);
+    }
+  }
+
+  inline void Scheduler::monitor() {
+    auto previous = std::vector<ContextStatistics>(m_thread_count);
+    auto last = std::chrono::steady_clock::now();
+    auto lock = boost::unique_lock(m_monitor_mutex);
+    while(true) {
+      if(m_monitor_condition.timed_wait(lock, m_config.m_statistics_interval,
+          [&] { return !m_is_monitoring; })) {
+        return;
+      }
+      auto now = std::chrono::steady_clock::now();
+      auto seconds = std::chrono::duration<double>(now - last).count();
+      last = now;
+      for(auto i = std::size_t(0); i != m_thread_count; ++i) {
+        auto statistics = get_statistics(i);
+        auto delta = statistics;
+        delta.m_context_switches -= previous[i].m_context_switches;
+        delta.m_scheduling_latency -= previous[i].m_scheduling_latency;
+        delta.m_slice_duration -= previous[i].m_slice_duration;
+        previous[i] = statistics;
+        if(m_config.m_statistics_handler) {
+          m_config.m_statistics_handler(delta);
+        } else {
+          std::cout << delta << ", switches/s: " <<
+            static_cast<std::uint64_t>(delta.m_context_switches / seconds) <<
+            '\n';
+        }
+      }
+      if(!m_config.m_statistics_handler) {
+        std::cout << std::flush;
+      }
+    }
+  }
+
+  inline bool Scheduler::try_pop_queued(
+      Context& context, ScheduledRoutine*& routine) {
+    if(!context.m_pending_routines.empty()) {
+      routine = context.m_pending_routines.front();
+      context.m_pending_routines.pop_front();
+    } else if(!context.m_shared_routines.empty()) {
+      routine = context.m_shared_routines.front();
+      context.m_shared_routines.pop_front();
+    } else {
+      return false;
+    }
+    --context.m_queued_count;
+    return true;
+  }
+
+  inline bool Scheduler::try_pop(
+      std::size_t context_id, ScheduledRoutine*& routine) {
+    auto& context = m_contexts[context_id];
+    ++context.m_tick;
+    if(context.m_tick % SHARED_POLL_INTERVAL != 0 &&
+        context.m_local_routines.try_pop(routine)) {
+      return true;
+    }
+    if(context.m_queued_count != 0) {
+      auto lock = boost::lock_guard(context.m_mutex);
+      if(try_pop_queued(context, routine)) {
+        return true;
+      }
+    }
+    return context.m_local_routines.try_pop(routine);
+  }
+
+  inline bool Scheduler::try_steal(
+      std::size_t context_id, ScheduledRoutine*& routine) {
+    auto numa_node = m_contexts[context_id].m_numa_node;
+    for(auto i = std::size_t(1); i < m_thread_count; ++i) {
+      auto& victim = m_contexts[(context_id + i) % m_thread_count];
+      if(victim.m_numa_node != numa_node) {
+        continue;
+      }
+      if(victim.m_local_routines.try_pop(routine)) {
+        routine->set_context_id(context_id);
+        return true;
+      }
+      if(victim.m_queued_count == 0) {
+        continue;
+      }
+      auto lock = boost::unique_lock(victim.m_mutex, boost::try_to_lock);
+      if(lock.owns_lock() && !victim.m_shared_routines.empty()) {
+        routine = victim.m_shared_routines.front();
+        victim.m_shared_routines.pop_front();
+        --victim.m_queued_count;
+        routine->set_context_id(context_id);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  inline ScheduledRoutine* Scheduler::pop(std::size_t context_id) {
+    auto& context = m_contexts[context_id];
+    auto routine = static_cast<ScheduledRoutine*>(nullptr);
+    if(m_mode == Mode::FIXED) {
+      auto lock = boost::unique_lock(context.m_mutex);
+      while(!try_pop_queued(context, routine)) {
+        if(!context.m_is_running && context.m_suspended_routines.empty()) {
+          return nullptr;
+        }
+        context.m_pending_routines_available_condition.wait(lock);
+      }
+      return routine;
+    }
+    if(try_pop(context_id, routine)) {
+      if(!context.m_local_routines.is_empty() ||
+          context.m_queued_count != 0) {
+        wake_idle_context(context_id);
+      }
+      return routine;
+    }
+    auto lock = boost::unique_lock(context.m_mutex);
+    while(true) {
+      if(try_pop_queued(context, routine) ||
+          context.m_local_routines.try_pop(routine)) {
+        return routine;
+      }
+      if(!context.m_is_running && context.m_suspended_routines.empty()) {
+        return nullptr;
+      }
+      context.m_is_sleeping = true;
+      ++m_sleeping_count;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      auto is_stolen = try_steal(context_id, routine);
+      if(!is_stolen) {
+        context.m_pending_routines_available_condition.wait(lock);
+      }
+      context.m_is_sleeping = false;
+      --m_sleeping_count;
+      if(is_stolen) {
+        return routine;
+      }
+    }
+  }
+
+  inline void Scheduler::wake_idle_context(std::size_t context_id) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(m_sleeping_count == 0) {
+      return;
+    }
+    auto numa_node = m_contexts[context_id].m_numa_node;
+    for(auto i = std::size_t(1); i < m_thread_count; ++i) {
+      auto& context = m_contexts[(context_id + i) % m_thread_count];
+      if(context.m_numa_node == numa_node && context.m_is_sleeping) {
+        auto lock = boost::lock_guard(context.m_mutex);
+        context.m_pending_routines_available_condition.notify_one();
+        return;
+      }
+    }
   }
 
   inline void Scheduler::decrement_busy_count() {
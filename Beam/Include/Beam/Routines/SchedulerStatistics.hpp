@@ -0,0 +1,255 @@
+#ifndef BEAM_SCHEDULER_STATISTICS_HPP
+#define BEAM_SCHEDULER_STATISTICS_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace Beam {
+namespace Details {
+  inline std::ostream& write_duration(
+      std::ostream& out, std::chrono::nanoseconds duration) {
+    auto count = duration.count();
+    if(count < 10000) {
+      return out << count << "ns";
+    } else if(count < 10000000) {
+      return out << count / 1000 << "us";
+    } else if(count < 10000000000) {
+      return out << count / 1000000 << "ms";
+    }
+    return out << count / 1000000000 << "s";
+  }
+}
+
+  /**
+   * Counts durations into buckets whose bounds grow in powers of two
+   * nanoseconds.
+   */
+  class LatencyHistogram {
+    public:
+
+      /** The number of buckets, the last bucket counts all longer durations. */
+      static constexpr auto BUCKET_COUNT = std::size_t(40);
+
+      /** Returns the bucket a duration is counted in. */
+      static std::size_t get_bucket(std::chrono::nanoseconds duration);
+
+      /** Returns the exclusive upper bound of a bucket. */
+      static std::chrono::nanoseconds get_upper_bound(std::size_t bucket);
+
+      /** Constructs an empty LatencyHistogram. */
+      LatencyHistogram();
+
+      /** Returns the total number of durations counted. */
+      std::uint64_t get_count() const;
+
+      /** Returns the number of durations counted in a bucket. */
+      std::uint64_t get_count(std::size_t bucket) const;
+
+      /**
+       * Returns the upper bound of the bucket containing a percentile, or
+       * zero if the histogram is empty.
+       * @param percentile The percentile to find within the range [0, 1].
+       */
+      std::chrono::nanoseconds get_percentile(double percentile) const;
+
+      /**
+       * Counts a duration.
+       * @param duration The duration to count.
+       */
+      void add(std::chrono::nanoseconds duration);
+
+      /**
+       * Adds the counts of each bucket of another histogram.
+       * @param histogram The histogram to add.
+       */
+      LatencyHistogram& operator +=(const LatencyHistogram& histogram);
+
+      /**
+       * Subtracts the counts of each bucket of an earlier snapshot of this
+       * histogram.
+       * @param histogram The histogram to subtract.
+       */
+      LatencyHistogram& operator -=(const LatencyHistogram& histogram);
+
+    private:
+      friend class LiveLatencyHistogram;
+      std::array<std::uint64_t, BUCKET_COUNT> m_counts;
+  };
+
+  /**
+   * A LatencyHistogram written by a single thread and read by any thread.
+   */
+  class LiveLatencyHistogram {
+    public:
+
+      /** Constructs an empty LiveLatencyHistogram. */
+      LiveLatencyHistogram();
+
+      /** Returns a snapshot of the counts. */
+      LatencyHistogram load() const;
+
+      /**
+       * Counts a duration, must only be called by the writing thread.
+       * @param duration The duration to count.
+       */
+      void add(std::chrono::nanoseconds duration);
+
+    private:
+      std::array<std::atomic_uint64_t, LatencyHistogram::BUCKET_COUNT>
+        m_counts;
+
+      LiveLatencyHistogram(const LiveLatencyHistogram&) = delete;
+      LiveLatencyHistogram& operator =(const LiveLatencyHistogram&) = delete;
+  };
+
+  /** Stores a snapshot of the activity of a single Scheduler context. */
+  struct ContextStatistics {
+
+    /** The id of the context. */
+    std::size_t m_context_id = 0;
+
+    /** The number of Routines waiting to run. */
+    std::size_t m_queue_depth = 0;
+
+    /** The number of Routines suspended in the context. */
+    std::size_t m_suspended_count = 0;
+
+    /** The number of times a Routine was advanced by the context. */
+    std::uint64_t m_context_switches = 0;
+
+    /** The time between a Routine becoming ready and being advanced. */
+    LatencyHistogram m_scheduling_latency;
+
+    /** The time taken by each advance of a Routine. */
+    LatencyHistogram m_slice_duration;
+
+    /** The longest time taken by a single advance. */
+    std::chrono::nanoseconds m_longest_slice = {};
+
+    /** The id of the Routine that ran the longest slice, or 0. */
+    std::uint64_t m_longest_slice_routine = 0;
+
+    /** The id of the Routine currently running, or 0 if none is. */
+    std::uint64_t m_running_routine = 0;
+
+    /** How long the currently running Routine has been running. */
+    std::chrono::nanoseconds m_running_time = {};
+  };
+
+  inline std::ostream& operator <<(
+      std::ostream& out, const LatencyHistogram& histogram) {
+    out << "(count: " << histogram.get_count() << ", p50: ";
+    Details::write_duration(out, histogram.get_percentile(0.5)) << ", p99: ";
+    Details::write_duration(out, histogram.get_percentile(0.99)) << ", max: ";
+    return Details::write_duration(out, histogram.get_percentile(1)) << ')';
+  }
+
+  inline std::ostream& operator <<(
+      std::ostream& out, const ContextStatistics& statistics) {
+    out << "context: " << statistics.m_context_id << ", queued: " <<
+      statistics.m_queue_depth << ", suspended: " <<
+      statistics.m_suspended_count << ", switches: " <<
+      statistics.m_context_switches << ", latency: " <<
+      statistics.m_scheduling_latency << ", slices: " <<
+      statistics.m_slice_duration << ", longest slice: ";
+    Details::write_duration(out, statistics.m_longest_slice) <<
+      " (routine " << statistics.m_longest_slice_routine << ')';
+    if(statistics.m_running_routine != 0) {
+      out << ", running: routine " << statistics.m_running_routine <<
+        " for ";
+      Details::write_duration(out, statistics.m_running_time);
+    }
+    return out;
+  }
+
+  inline std::size_t LatencyHistogram::get_bucket(
+      std::chrono::nanoseconds duration) {
+    if(duration.count() <= 0) {
+      return 0;
+    }
+    return std::min<std::size_t>(
+      std::bit_width(static_cast<std::uint64_t>(duration.count())),
+      BUCKET_COUNT - 1);
+  }
+
+  inline std::chrono::nanoseconds LatencyHistogram::get_upper_bound(
+      std::size_t bucket) {
+    return std::chrono::nanoseconds(std::int64_t(1) << bucket);
+  }
+
+  inline LatencyHistogram::LatencyHistogram()
+    : m_counts() {}
+
+  inline std::uint64_t LatencyHistogram::get_count() const {
+    auto count = std::uint64_t(0);
+    for(auto bucket_count : m_counts) {
+      count += bucket_count;
+    }
+    return count;
+  }
+
+  inline std::uint64_t LatencyHistogram::get_count(std::size_t bucket) const {
+    return m_counts[bucket];
+  }
+
+  inline std::chrono::nanoseconds LatencyHistogram::get_percentile(
+      double percentile) const {
+    auto count = get_count();
+    if(count == 0) {
+      return std::chrono::nanoseconds(0);
+    }
+    auto rank = std::max<std::uint64_t>(
+      static_cast<std::uint64_t>(percentile * count + 0.5), 1);
+    auto total = std::uint64_t(0);
+    for(auto i = std::size_t(0); i != BUCKET_COUNT; ++i) {
+      total += m_counts[i];
+      if(total >= rank) {
+        return get_upper_bound(i);
+      }
+    }
+    return get_upper_bound(BUCKET_COUNT - 1);
+  }
+
+  inline void LatencyHistogram::add(std::chrono::nanoseconds duration) {
+    ++m_counts[get_bucket(duration)];
+  }
+
+  inline LatencyHistogram& LatencyHistogram::operator +=(
+      const LatencyHistogram& histogram) {
+    for(auto i = std::size_t(0); i != BUCKET_COUNT; ++i) {
+      m_counts[i] += histogram.m_counts[i];
+    }
+    return *this;
+  }
+
+  inline LatencyHistogram& LatencyHistogram::operator -=(
+      const LatencyHistogram& histogram) {
+    for(auto i = std::size_t(0); i != BUCKET_COUNT; ++i) {
+      m_counts[i] -= std::min(m_counts[i], histogram.m_counts[i]);
+    }
+    return *this;
+  }
+
+  inline LiveLatencyHistogram::LiveLatencyHistogram()
+    : m_counts() {}
+
+  inline LatencyHistogram LiveLatencyHistogram::load() const {
+    auto histogram = LatencyHistogram();
+    for(auto i = std::size_t(0); i != LatencyHistogram::BUCKET_COUNT; ++i) {
+      histogram.m_counts[i] = m_counts[i].load(std::memory_order_relaxed);
+    }
+    return histogram;
+  }
+
+  inline void LiveLatencyHistogram::add(std::chrono::nanoseconds duration) {
+    auto& count = m_counts[LatencyHistogram::get_bucket(duration)];
+    count.store(count.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+  }
+}
+
+#endif
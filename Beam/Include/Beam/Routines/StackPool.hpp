@@ -0,0 +1,283 @@
+#ifndef BEAM_STACK_POOL_HPP
+#define BEAM_STACK_POOL_HPP
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include <boost/context/protected_fixedsize_stack.hpp>
+#include <boost/context/stack_context.hpp>
+#include <boost/context/stack_traits.hpp>
+#include "Beam/Threading/Sync.hpp"
+#include "Beam/Utilities/DllExport.hpp"
+#include "Beam/Utilities/Singleton.hpp"
+
+#ifndef BEAM_STACK_POOL_MAX_RETAINED_SIZE
+  #define BEAM_STACK_POOL_MAX_RETAINED_SIZE 33554432
+#endif
+
+namespace Beam {
+
+  /**
+   * Recycles the stacks used by Routines. Stacks are rounded up to a power of
+   * two size class, protected by a guard page, and returned to a free list
+   * local to the thread releasing them.
+   */
+  class BEAM_EXPORT_DLL StackPool : public Singleton<StackPool> {
+    public:
+
+      /** Stores statistics about the use of the StackPool. */
+      struct Statistics {
+
+        /** The number of allocations served from a free list. */
+        std::uint64_t m_hits;
+
+        /** The number of allocations that required a new stack. */
+        std::uint64_t m_misses;
+
+        /** The number of stacks released back to the system. */
+        std::uint64_t m_releases;
+
+        /** The number of bytes retained across all free lists. */
+        std::uint64_t m_retained_size;
+      };
+
+      /** The default number of bytes each thread may retain. */
+      static constexpr auto DEFAULT_MAX_RETAINED_SIZE =
+        std::size_t(BEAM_STACK_POOL_MAX_RETAINED_SIZE);
+
+      /** Constructs a StackPool. */
+      StackPool();
+
+      /** Returns the number of bytes each thread may retain. */
+      std::size_t get_max_retained_size() const;
+
+      /**
+       * Sets the number of bytes each thread may retain, stacks released
+       * beyond this limit are returned to the system.
+       */
+      void set_max_retained_size(std::size_t size);
+
+      /** Returns the Statistics accumulated across all threads. */
+      Statistics get_statistics() const;
+
+      /**
+       * Allocates a stack.
+       * @param size The minimum usable size of the stack.
+       * @return The allocated stack.
+       */
+      boost::context::stack_context allocate(std::size_t size);
+
+      /**
+       * Releases a stack previously returned by <i>allocate</i>.
+       * @param stack The stack to release.
+       */
+      void deallocate(boost::context::stack_context& stack) noexcept;
+
+    private:
+      struct FreeList {
+        StackPool* m_pool;
+        std::vector<std::vector<boost::context::stack_context>> m_stacks;
+        std::size_t m_retained_size;
+        std::atomic_uint64_t m_hits;
+        std::atomic_uint64_t m_misses;
+        std::atomic_uint64_t m_releases;
+        std::atomic_uint64_t m_shared_retained_size;
+
+        explicit FreeList(StackPool& pool);
+        ~FreeList();
+      };
+      struct BEAM_EXPORT_DLL FreeListGlobal {
+        static FreeList*& get();
+      };
+      std::atomic_size_t m_max_retained_size;
+      Sync<std::vector<FreeList*>> m_free_lists;
+      Sync<Statistics> m_retired_statistics;
+
+      static std::size_t get_size_class(std::size_t size);
+      static std::size_t get_usable_size(
+        const boost::context::stack_context& stack);
+      static void release(boost::context::stack_context& stack) noexcept;
+      FreeList* load_free_list();
+  };
+
+  /**
+   * Implements a boost::context StackAllocator that draws from the StackPool.
+   */
+  class PooledStack {
+    public:
+
+      /**
+       * Constructs a PooledStack.
+       * @param size The minimum usable size of the stack.
+       */
+      explicit PooledStack(std::size_t size) noexcept;
+
+      /** Allocates a stack. */
+      boost::context::stack_context allocate();
+
+      /** Returns a stack to the StackPool. */
+      void deallocate(boost::context::stack_context& stack) noexcept;
+
+    private:
+      std::size_t m_size;
+  };
+
+#ifndef BEAM_USE_DLL
+  BEAM_EMIT_DLL inline StackPool::FreeList*& StackPool::FreeListGlobal::get() {
+    static thread_local auto value = static_cast<FreeList*>(nullptr);
+    return value;
+  }
+#endif
+
+  inline StackPool::FreeList::FreeList(StackPool& pool)
+    : m_pool(&pool),
+      m_retained_size(0),
+      m_hits(0),
+      m_misses(0),
+      m_releases(0),
+      m_shared_retained_size(0) {}
+
+  inline StackPool::FreeList::~FreeList() {
+    FreeListGlobal::get() = nullptr;
+    for(auto& stacks : m_stacks) {
+      for(auto& stack : stacks) {
+        release(stack);
+        ++m_releases;
+      }
+    }
+    with(m_pool->m_free_lists, [&] (auto& free_lists) {
+      std::erase(free_lists, this);
+      with(m_pool->m_retired_statistics, [&] (auto& statistics) {
+        statistics.m_hits += m_hits;
+        statistics.m_misses += m_misses;
+        statistics.m_releases += m_releases;
+      });
+    });
+  }
+
+  inline StackPool::StackPool()
+    : m_max_retained_size(DEFAULT_MAX_RETAINED_SIZE) {}
+
+  inline std::size_t StackPool::get_max_retained_size() const {
+    return m_max_retained_size.load(std::memory_order_relaxed);
+  }
+
+  inline void StackPool::set_max_retained_size(std::size_t size) {
+    m_max_retained_size.store(size, std::memory_order_relaxed);
+  }
+
+  inline StackPool::Statistics StackPool::get_statistics() const {
+    return with(m_free_lists, [&] (const auto& free_lists) {
+      auto statistics = with(m_retired_statistics, [] (const auto& retired) {
+        return retired;
+      });
+      for(auto free_list : free_lists) {
+        statistics.m_hits += free_list->m_hits.load(std::memory_order_relaxed);
+        statistics.m_misses +=
+          free_list->m_misses.load(std::memory_order_relaxed);
+        statistics.m_releases +=
+          free_list->m_releases.load(std::memory_order_relaxed);
+        statistics.m_retained_size +=
+          free_list->m_shared_retained_size.load(std::memory_order_relaxed);
+      }
+      return statistics;
+    });
+  }
+
+  inline boost::context::stack_context StackPool::allocate(std::size_t size) {
+    auto size_class = get_size_class(size);
+    auto free_list = load_free_list();
+    if(free_list) {
+      auto index = static_cast<std::size_t>(std::countr_zero(size_class));
+      if(index < free_list->m_stacks.size() &&
+          !free_list->m_stacks[index].empty()) {
+        auto stack = free_list->m_stacks[index].back();
+        free_list->m_stacks[index].pop_back();
+        free_list->m_retained_size -= size_class;
+        free_list->m_shared_retained_size.store(
+          free_list->m_retained_size, std::memory_order_relaxed);
+        free_list->m_hits.fetch_add(1, std::memory_order_relaxed);
+        return stack;
+      }
+      free_list->m_misses.fetch_add(1, std::memory_order_relaxed);
+    }
+    return boost::context::protected_fixedsize_stack(size_class).allocate();
+  }
+
+  inline void StackPool::deallocate(
+      boost::context::stack_context& stack) noexcept {
+    auto free_list = load_free_list();
+    auto size_class = get_usable_size(stack);
+    if(!free_list || !std::has_single_bit(size_class) ||
+        free_list->m_retained_size + size_class > get_max_retained_size()) {
+      release(stack);
+      if(free_list) {
+        free_list->m_releases.fetch_add(1, std::memory_order_relaxed);
+      }
+      return;
+    }
+    auto index = static_cast<std::size_t>(std::countr_zero(size_class));
+    try {
+      if(index >= free_list->m_stacks.size()) {
+        free_list->m_stacks.resize(index + 1);
+      }
+      free_list->m_stacks[index].push_back(stack);
+    } catch(const std::bad_alloc&) {
+      release(stack);
+      free_list->m_releases.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    free_list->m_retained_size += size_class;
+    free_list->m_shared_retained_size.store(
+      free_list->m_retained_size, std::memory_order_relaxed);
+  }
+
+  inline std::size_t StackPool::get_size_class(std::size_t size) {
+    return std::bit_ceil(std::max({size,
+      boost::context::stack_traits::page_size(),
+      boost::context::stack_traits::minimum_size()}));
+  }
+
+  inline std::size_t StackPool::get_usable_size(
+      const boost::context::stack_context& stack) {
+    return stack.size - boost::context::stack_traits::page_size();
+  }
+
+  inline void StackPool::release(
+      boost::context::stack_context& stack) noexcept {
+    boost::context::protected_fixedsize_stack(get_usable_size(stack)).
+      deallocate(stack);
+  }
+
+  inline StackPool::FreeList* StackPool::load_free_list() {
+    auto& free_list = FreeListGlobal::get();
+    if(!free_list) {
+      static thread_local auto is_initialized = false;
+      if(is_initialized) {
+        return nullptr;
+      }
+      is_initialized = true;
+      static thread_local auto thread_free_list = FreeList(*this);
+      free_list = &thread_free_list;
+      with(m_free_lists, [&] (auto& free_lists) {
+        free_lists.push_back(free_list);
+      });
+    }
+    return free_list;
+  }
+
+  inline PooledStack::PooledStack(std::size_t size) noexcept
+    : m_size(size) {}
+
+  inline boost::context::stack_context PooledStack::allocate() {
+    return StackPool::get().allocate(m_size);
+  }
+
+  inline void PooledStack::deallocate(
+      boost::context::stack_context& stack) noexcept {
+    StackPool::get().deallocate(stack);
+  }
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef BEAM_THREADING_CONFIG_HPP
+#define BEAM_THREADING_CONFIG_HPP
+#include <string>
+#include <boost/algorithm/string/case_conv.hpp>
+#include "Beam/Routines/Scheduler.hpp"
+#include "Beam/Threading/ServiceThreadPool.hpp"
+#include "Beam/Utilities/YamlConfig.hpp"
+
+namespace Beam {
+  template<>
+  struct YamlValueExtractor<Details::Scheduler::Mode> {
+    Details::Scheduler::Mode operator ()(const YAML::Node& node) const {
+      auto value = boost::to_lower_copy(extract<std::string>(node));
+      if(value == "fixed") {
+        return Details::Scheduler::Mode::FIXED;
+      } else if(value == "work_stealing") {
+        return Details::Scheduler::Mode::WORK_STEALING;
+      }
+      BEAM_ASSERT_MESSAGE(false, "Config error at line " <<
+        (node.Mark().line + 1) << ", column " << (node.Mark().column + 1) <<
+        ":\n\tInvalid scheduler mode: " << value << std::endl);
+      return Details::Scheduler::DEFAULT_MODE;
+    }
+  };
+
+  template<>
+  struct YamlValueExtractor<Details::Scheduler::Config> {
+    Details::Scheduler::Config operator ()(const YAML::Node& node) const {
+      auto config = Details::Scheduler::Config();
+      config.m_mode = extract<Details::Scheduler::Mode>(node, "mode",
+        Details::Scheduler::DEFAULT_MODE);
+      config.m_workers = extract<WorkerConfig>(node);
+      config.m_statistics_interval =
+        extract<boost::posix_time::time_duration>(node, "statistics_interval",
+          boost::posix_time::pos_infin);
+      return config;
+    }
+  };
+
+  /**
+   * Configures the Scheduler and the ServiceThreadPool from the optional
+   * <i>scheduler</i> and <i>service_thread_pool</i> children of a YAML node,
+   * must be called before any Routine is spawned or socket is opened.
+   * @param node The YAML node to parse, for example:
+   *        <pre>
+   *        scheduler:
+   *          mode: work_stealing
+   *          threads: 8
+   *          cpus: ["0-3", "4-7"]
+   *          statistics_interval: 10s
+   *        service_thread_pool:
+   *          threads: 2
+   *          cpus: [0, 4]
+   *        </pre>
+   */
+  inline void configure_threads(const YAML::Node& node) {
+    if(auto scheduler = node["scheduler"]) {
+      Details::Scheduler::set_config(
+        extract<Details::Scheduler::Config>(scheduler));
+    }
+    if(auto service_thread_pool = node["service_thread_pool"]) {
+      ServiceThreadPool::set_config(extract<WorkerConfig>(service_thread_pool));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef BEAM_WORK_STEALING_QUEUE_HPP
+#define BEAM_WORK_STEALING_QUEUE_HPP
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace Beam {
+
+  /**
+   * Implements a bounded lock-free queue owned by a single thread that pushes
+   * values, and from which any thread, including the owner, can take values in
+   * FIFO order.
+   * @tparam T The type of value to store, must be trivially copyable.
+   */
+  template<typename T>
+  class WorkStealingQueue {
+    public:
+      static_assert(std::is_trivially_copyable_v<T>);
+
+      /** The type of value to store. */
+      using Value = T;
+
+      /** The default capacity. */
+      static constexpr auto DEFAULT_CAPACITY = std::size_t(256);
+
+      /** Constructs a WorkStealingQueue with the default capacity. */
+      WorkStealingQueue();
+
+      /**
+       * Constructs a WorkStealingQueue.
+       * @param capacity The maximum number of values that can be stored,
+       *        rounded up to a power of two.
+       */
+      explicit WorkStealingQueue(std::size_t capacity);
+
+      /** Returns the maximum number of values that can be stored. */
+      std::size_t get_capacity() const;
+
+      /** Returns an approximation of the number of values stored. */
+      std::size_t get_size() const;
+
+      /** Returns <code>true</code> iff the queue appears empty. */
+      bool is_empty() const;
+
+      /**
+       * Pushes a value onto the back of the queue, must only be called by the
+       * owning thread.
+       * @param value The value to push.
+       * @return <code>false</code> iff the queue is full.
+       */
+      bool push(const Value& value);
+
+      /**
+       * Takes the value at the front of the queue, may be called from any
+       * thread.
+       * @param value Stores the value taken.
+       * @return <code>true</code> iff a value was taken.
+       */
+      bool try_pop(Value& value);
+
+    private:
+      std::size_t m_mask;
+      std::unique_ptr<std::atomic<Value>[]> m_values;
+      alignas(64) std::atomic_uint64_t m_head;
+      alignas(64) std::atomic_uint64_t m_tail;
+
+      WorkStealingQueue(const WorkStealingQueue&) = delete;
+      WorkStealingQueue& operator =(const WorkStealingQueue&) = delete;
+  };
+
+  template<typename T>
+  WorkStealingQueue<T>::WorkStealingQueue()
+    : WorkStealingQueue(DEFAULT_CAPACITY) {}
+
+  template<typename T>
+  WorkStealingQueue<T>::WorkStealingQueue(std::size_t capacity)
+    : m_mask(std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1),
+      m_values(std::make_unique<std::atomic<Value>[]>(m_mask + 1)),
+      m_head(0),
+      m_tail(0) {}
+
+  template<typename T>
+  std::size_t WorkStealingQueue<T>::get_capacity() const {
+    return m_mask + 1;
+  }
+
+  template<typename T>
+  std::size_t WorkStealingQueue<T>::get_size() const {
+    auto head = m_head.load(std::memory_order_acquire);
+    auto tail = m_tail.load(std::memory_order_acquire);
+    if(tail <= head) {
+      return 0;
+    }
+    return static_cast<std::size_t>(tail - head);
+  }
+
+  template<typename T>
+  bool WorkStealingQueue<T>::is_empty() const {
+    return get_size() == 0;
+  }
+
+  template<typename T>
+  bool WorkStealingQueue<T>::push(const Value& value) {
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    auto head = m_head.load(std::memory_order_acquire);
+    if(tail - head > m_mask) {
+      return false;
+    }
+    m_values[tail & m_mask].store(value, std::memory_order_relaxed);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  template<typename T>
+  bool WorkStealingQueue<T>::try_pop(Value& value) {
+    auto head = m_head.load(std::memory_order_acquire);
+    while(true) {
+      auto tail = m_tail.load(std::memory_order_acquire);
+      if(head >= tail) {
+        return false;
+      }
+      auto candidate = m_values[head & m_mask].load(std::memory_order_relaxed);
+      if(m_head.compare_exchange_weak(head, head + 1,
+          std::memory_order_acq_rel, std::memory_order_acquire)) {
+        value = candidate;
+        return true;
+      }
+    }
+  }
+}
+
+#endif
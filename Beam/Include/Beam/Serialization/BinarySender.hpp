@@ -48,6 +48,7 @@ namespace Beam {
   void BinarySender<S>::set(Ref<Sink> sink) {
     m_sink = sink.get();
     m_size = m_sink->get_size();
+    this->start_buffer();
   }
 
   template<IsBuffer S>
@@ -120,6 +121,9 @@ namespace Beam {
   struct inverse<BinarySender<S>> {
     using type = BinaryReceiver<S>;
   };
+
+  template<typename S>
+  struct type_id_support<BinarySender<S>> : std::true_type {};
 }
 
 #endif
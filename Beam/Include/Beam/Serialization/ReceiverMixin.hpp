@@ -1,8 +1,12 @@
 #ifndef BEAM_RECEIVER_MIXIN_HPP
 #define BEAM_RECEIVER_MIXIN_HPP
+#include <algorithm>
 #include <cstdint>
 #include <typeindex>
 #include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/throw_exception.hpp>
 #include "Beam/Pointers/Ref.hpp"
 #include "Beam/Serialization/Receiver.hpp"
 #include "Beam/Serialization/SerializedValue.hpp"
@@ -55,9 +59,13 @@ namespace Beam {
       void receive(const char* name, T*& value) requires std::is_class_v<T>;
 
     private:
+      using ReceivedTypeId = std::pair<std::uint32_t, const void*>;
       const TypeRegistry<inverse_t<R>>* m_registry;
+      std::vector<ReceivedTypeId> m_received_type_ids;
 
       Receiver& self();
+      template<typename E>
+      const E* receive_type_id();
   };
 
   template<typename R>
@@ -147,14 +155,19 @@ namespace Beam {
     self().start_structure(name);
     auto type_name = std::string();
     self().receive("__type", type_name);
-    if(type_name == "__null") {
-      value = nullptr;
-    } else {
+    auto entry = static_cast<const TypeEntry<inverse_t<R>>*>(nullptr);
+    if(type_id_support_v<inverse_t<R>> && type_name.empty()) {
+      entry = receive_type_id<TypeEntry<inverse_t<R>>>();
+    } else if(type_name != "__null") {
+      entry = &m_registry->get_entry(type_name);
+    }
+    if(entry) {
       auto version = unsigned();
       self().receive("__version", version);
-      auto& entry = m_registry->get_entry(type_name);
-      value = static_cast<T*>(entry.make());
-      entry.receive(self(), value, version);
+      value = static_cast<T*>(entry->make());
+      entry->receive(self(), value, version);
+    } else {
+      value = nullptr;
     }
     self().end_structure();
   }
@@ -163,6 +176,35 @@ namespace Beam {
   typename ReceiverMixin<R>::Receiver& ReceiverMixin<R>::self() {
     return static_cast<Receiver&>(*this);
   }
+
+  template<typename R>
+  template<typename E>
+  const E* ReceiverMixin<R>::receive_type_id() {
+    auto type_id = std::uint32_t();
+    self().receive("__id", type_id);
+    if(type_id == NULL_TYPE_ID) {
+      return nullptr;
+    } else if(type_id == NAMED_TYPE_ID) {
+      auto type_name = std::string();
+      self().receive("__name", type_name);
+      auto& entry = m_registry->get_entry(type_name);
+      auto i = std::ranges::find(
+        m_received_type_ids, entry.get_id(), &ReceivedTypeId::first);
+      if(i == m_received_type_ids.end()) {
+        m_received_type_ids.emplace_back(entry.get_id(), &entry);
+      } else if(i->second != &entry) {
+        i->second = nullptr;
+      }
+      return &entry;
+    }
+    auto i = std::ranges::find(
+      m_received_type_ids, type_id, &ReceivedTypeId::first);
+    if(i == m_received_type_ids.end() || !i->second) {
+      boost::throw_with_location(
+        TypeNotFoundException(std::to_string(type_id)));
+    }
+    return static_cast<const E*>(i->second);
+  }
 }
 
 #endif
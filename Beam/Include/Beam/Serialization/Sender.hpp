@@ -1,5 +1,6 @@
 #ifndef BEAM_SENDER_HPP
 #define BEAM_SENDER_HPP
+#include <type_traits>
 #include "Beam/Pointers/Ref.hpp"
 #include "Beam/Serialization/DataShuttle.hpp"
 
@@ -72,6 +73,16 @@ namespace Beam {
     void operator ()(S& sender, const char* name, const T& value) const;
   };
 
+  /**
+   * Specifies whether a Sender identifies polymorphic types by their id
+   * rather than by their name.
+   */
+  template<typename T>
+  struct type_id_support : std::false_type {};
+
+  template<typename T>
+  constexpr auto type_id_support_v = type_id_support<T>::value;
+
   template<typename T, typename Enabled>
   template<IsSender S>
   void Send<T, Enabled>::operator ()(
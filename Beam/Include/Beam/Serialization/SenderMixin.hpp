@@ -1,8 +1,11 @@
 #ifndef BEAM_SENDER_MIXIN_HPP
 #define BEAM_SENDER_MIXIN_HPP
+#include <algorithm>
 #include <cstdint>
 #include <typeindex>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include "Beam/Pointers/Ref.hpp"
 #include "Beam/Serialization/Sender.hpp"
 #include "Beam/Serialization/TypeEntry.hpp"
@@ -30,6 +33,18 @@ namespace Beam {
        */
       explicit SenderMixin(Ref<const TypeRegistry<Sender>> registry) noexcept;
 
+      /** Returns how the types of polymorphic values are identified. */
+      TypeIdFormat get_type_id_format() const;
+
+      /**
+       * Sets how the types of polymorphic values are identified, forgetting
+       * the types named so far. Senders without type_id_support always send
+       * names.
+       * @param format The TypeIdFormat to use, TypeIdFormat::BUFFER by
+       *        default.
+       */
+      void set_type_id_format(TypeIdFormat format);
+
       template<typename T>
       void shuttle(const char* name, const T& value);
       template<typename T>
@@ -66,19 +81,45 @@ namespace Beam {
       template<typename T>
       void send(const char* name, const SerializedValue<T>& value);
 
+    protected:
+
+      /**
+       * Called when a new sink is set, forgetting the types named in the
+       * previous buffer unless the format is TypeIdFormat::STREAM.
+       */
+      void start_buffer();
+
     private:
+      using NamedType = std::pair<std::uint32_t, const void*>;
       const TypeRegistry<Sender>* m_registry;
+      TypeIdFormat m_type_id_format;
+      std::vector<NamedType> m_named_types;
 
       Sender& self();
+      template<typename E>
+      void send_type_id(const E* entry);
   };
 
   template<typename S>
   SenderMixin<S>::SenderMixin() noexcept
-    : m_registry(nullptr) {}
+    : m_registry(nullptr),
+      m_type_id_format(TypeIdFormat::BUFFER) {}
 
   template<typename S>
   SenderMixin<S>::SenderMixin(Ref<const TypeRegistry<Sender>> registry) noexcept
-    : m_registry(registry.get()) {}
+    : m_registry(registry.get()),
+      m_type_id_format(TypeIdFormat::BUFFER) {}
+
+  template<typename S>
+  TypeIdFormat SenderMixin<S>::get_type_id_format() const {
+    return m_type_id_format;
+  }
+
+  template<typename S>
+  void SenderMixin<S>::set_type_id_format(TypeIdFormat format) {
+    m_type_id_format = format;
+    m_named_types.clear();
+  }
 
   template<typename S>
   template<typename T>
@@ -178,15 +219,20 @@ namespace Beam {
         requires std::is_class_v<T> {
     assert(m_registry != nullptr);
     self().start_structure(name);
-    if(value) {
-      auto& entry = m_registry->get_entry(*value);
-      self().send("__type", entry.get_name());
-      self().send("__version", version);
-      entry.send(self(), value, version);
+    auto entry = value ? &m_registry->get_entry(*value) : nullptr;
+    if(type_id_support_v<Sender> &&
+        m_type_id_format != TypeIdFormat::NAME) {
+      send_type_id(entry);
+    } else if(entry) {
+      self().send("__type", entry->get_name());
     } else {
       static const auto NULL_TYPE_NAME = std::string("__null");
       self().send("__type", NULL_TYPE_NAME);
     }
+    if(entry) {
+      self().send("__version", version);
+      entry->send(self(), value, version);
+    }
     self().end_structure();
   }
 
@@ -196,10 +242,41 @@ namespace Beam {
     send(*value);
   }
 
+  template<typename S>
+  void SenderMixin<S>::start_buffer() {
+    if(m_type_id_format != TypeIdFormat::STREAM) {
+      m_named_types.clear();
+    }
+  }
+
   template<typename S>
   typename SenderMixin<S>::Sender& SenderMixin<S>::self() {
     return *static_cast<Sender*>(this);
   }
+
+  template<typename S>
+  template<typename E>
+  void SenderMixin<S>::send_type_id(const E* entry) {
+    static const auto TYPE_ID_MARKER = std::string();
+    self().send("__type", TYPE_ID_MARKER);
+    if(!entry) {
+      self().send("__id", NULL_TYPE_ID);
+      return;
+    }
+    auto i = std::ranges::find(
+      m_named_types, entry->get_id(), &NamedType::first);
+    if(i != m_named_types.end() && i->second == entry) {
+      self().send("__id", entry->get_id());
+      return;
+    }
+    self().send("__id", NAMED_TYPE_ID);
+    self().send("__name", entry->get_name());
+    if(i == m_named_types.end()) {
+      m_named_types.emplace_back(entry->get_id(), entry);
+    } else {
+      i->second = nullptr;
+    }
+  }
 }
 
 #endif
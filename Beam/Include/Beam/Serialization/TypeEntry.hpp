@@ -1,7 +1,9 @@
 #ifndef BEAM_TYPEENTRY_HPP
 #define BEAM_TYPEENTRY_HPP
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <string_view>
 #include <typeindex>
 #include <unordered_map>
 
@@ -9,6 +11,53 @@ namespace Beam {
   template<typename S>
   class TypeRegistry;
 
+  /** Specifies how a Sender identifies the types of polymorphic values. */
+  enum class TypeIdFormat {
+
+    /** Types are sent by name, readable by receivers predating type ids. */
+    NAME,
+
+    /**
+     * Each buffer names the types it contains, later values of those types
+     * in the same buffer are sent by id.
+     */
+    BUFFER,
+
+    /**
+     * Types are named once for the life of the Sender and sent by id from
+     * then on, for Senders writing every buffer to the same ordered stream.
+     */
+    STREAM
+  };
+
+  /**
+   * The type id sent in place of a type's id when the type's name follows.
+   */
+  inline constexpr auto NAMED_TYPE_ID = std::uint32_t(0);
+
+  /** The type id sent in place of a null pointer. */
+  inline constexpr auto NULL_TYPE_ID = std::uint32_t(1);
+
+  /**
+   * Returns the id used to identify a type on the wire. Ids are derived from
+   * the type's name, and a type is only sent by id after its name was sent,
+   * so that the receiver can check which type an id stands for. Once two
+   * names with the same id were sent, both types are only sent by name.
+   * @param name The name of the type.
+   * @return The id of the type named <i>name</i>.
+   */
+  inline std::uint32_t get_type_id(std::string_view name) {
+    auto id = std::uint32_t(2166136261);
+    for(auto c : name) {
+      id ^= static_cast<unsigned char>(c);
+      id *= std::uint32_t(16777619);
+    }
+    if(id <= NULL_TYPE_ID) {
+      id += NULL_TYPE_ID + 1;
+    }
+    return id;
+  }
+
   /**
    * Stores serialization meta-data for a polymorphic type.
    * @tparam S The type of Sender.
@@ -29,6 +78,9 @@ namespace Beam {
       /** Returns the type's name. */
       const std::string& get_name() const;
 
+      /** Returns the id sent to identify the type. */
+      std::uint32_t get_id() const;
+
       /**
        * Allocates and constructs an instance of this type.
        * @return A newly constructed instance of <i>T</i>.
@@ -60,6 +112,7 @@ namespace Beam {
       using Factory = std::function<void* ()>;
       std::type_index m_type;
       std::string m_name;
+      std::uint32_t m_id;
       Factory m_builder;
       SendFunction m_sender;
       ReceiveFunction m_receiver;
@@ -79,6 +132,11 @@ namespace Beam {
     return m_name;
   }
 
+  template<IsSender S>
+  std::uint32_t TypeEntry<S>::get_id() const {
+    return m_id;
+  }
+
   template<IsSender S>
   void* TypeEntry<S>::make() const {
     return m_builder();
@@ -102,6 +160,7 @@ namespace Beam {
     std::type_index type, NF&& name, BF&& builder, SF&& sender, RF&& receiver)
     : m_type(type),
       m_name(std::forward<NF>(name)),
+      m_id(get_type_id(m_name)),
       m_builder(std::forward<BF>(builder)),
       m_sender(std::forward<SF>(sender)),
       m_receiver(std::forward<RF>(receiver)) {}
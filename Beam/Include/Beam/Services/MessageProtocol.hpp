@@ -1,7 +1,11 @@
 #ifndef BEAM_MESSAGE_PROTOCOL_HPP
 #define BEAM_MESSAGE_PROTOCOL_HPP
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <memory>
 #include <utility>
+#include <vector>
 #include <boost/endian.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/throw_exception.hpp>
@@ -14,17 +18,23 @@
 #include "Beam/IO/OpenState.hpp"
 #include "Beam/IO/SharedBuffer.hpp"
 #include "Beam/IO/SuffixBuffer.hpp"
-#include "Beam/IO/ValueSpan.hpp"
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
 #include "Beam/Pointers/Out.hpp"
 #include "Beam/Serialization/Receiver.hpp"
 #include "Beam/Serialization/Sender.hpp"
 #include "Beam/Serialization/ShuttleClone.hpp"
+#include "Beam/Serialization/TypeEntry.hpp"
 #include "Beam/Services/Message.hpp"
 
 namespace Beam {
 
+  /**
+   * The number of bytes a MessageProtocol reads ahead from its Channel, so
+   * that a single read can receive many small messages.
+   */
+  inline constexpr auto RECEIVE_CHUNK_SIZE = std::size_t(64 * 1024);
+
   /**
    * Implements a protocol used to send/receive discrete messages over a
    * Channel.
@@ -78,7 +88,9 @@ namespace Beam {
       std::unique_ptr<T> clone(const T& value);
 
       /**
-       * Encodes a message into a Buffer using this protocol.
+       * Encodes a message into a Buffer using this protocol, framed so that
+       * the Buffer can be passed to send by any protocol sharing this
+       * protocol's Sender and Encoder.
        * @param message The message to encode.
        * @param buffer The Buffer to encode the <i>message</i> into.
        */
@@ -115,10 +127,16 @@ namespace Beam {
       Encoder m_encoder;
       Decoder m_decoder;
       SharedBuffer m_receive_buffer;
+      std::size_t m_receive_position;
+      SharedBuffer m_frame;
       SharedBuffer m_decoder_buffer;
+      std::vector<std::unique_ptr<Sender>> m_senders;
 
       MessageProtocol(const MessageProtocol&) = delete;
       MessageProtocol& operator =(const MessageProtocol&) = delete;
+      std::unique_ptr<Sender> acquire_sender();
+      void release_sender(std::unique_ptr<Sender> sender);
+      void fill(std::size_t size);
   };
 
   template<typename C, typename S, typename R, typename E, typename D>
@@ -133,11 +151,12 @@ namespace Beam {
   MessageProtocol<C, S, E>::MessageProtocol(CF&& channel, SF&& sender,
     RF&& receiver, EF&& encoder, DF&& decoder)
     : m_channel(std::forward<CF>(channel)),
-      m_writer(&m_channel->get_writer()),
+      m_writer(&m_channel->get_writer(), DEFAULT_WRITE_BATCH_SIZE),
       m_sender(std::forward<SF>(sender)),
       m_receiver(std::forward<RF>(receiver)),
       m_encoder(std::forward<EF>(encoder)),
-      m_decoder(std::forward<DF>(decoder)) {}
+      m_decoder(std::forward<DF>(decoder)),
+      m_receive_position(0) {}
 
   template<typename C, IsSender S, IsEncoder E> requires
     IsChannel<dereference_t<C>>
@@ -158,16 +177,25 @@ namespace Beam {
   template<typename T, IsBuffer B>
   void MessageProtocol<C, S, E>::encode(
       const Message<T>& message, Out<B> buffer) {
-    append(*buffer, std::uint32_t(0));
-    auto serialization_buffer = B();
-    {
+    auto sender = [&] {
       auto lock = boost::lock_guard(m_mutex);
-      m_sender.set(Ref(serialization_buffer));
-      m_sender.send(&message);
+      return m_sender;
+    }();
+    append(*buffer, std::uint32_t(0));
+    if(in_place_support_v<Encoder>) {
+      sender.set(Ref(*buffer));
+      sender.send(&message);
+      auto encoder_buffer = SuffixBuffer(Ref(*buffer), sizeof(std::uint32_t));
+      auto size = m_encoder.encode(encoder_buffer, out(encoder_buffer));
+      write(*buffer, 0, boost::endian::native_to_little<std::uint32_t>(size));
+    } else {
+      auto serialization_buffer = B();
+      sender.set(Ref(serialization_buffer));
+      sender.send(&message);
+      auto encoder_buffer = SuffixBuffer(Ref(*buffer), sizeof(std::uint32_t));
+      auto size = m_encoder.encode(serialization_buffer, out(encoder_buffer));
+      write(*buffer, 0, boost::endian::native_to_little<std::uint32_t>(size));
     }
-    auto encoder_buffer = SuffixBuffer(Ref(*buffer), sizeof(std::uint32_t));
-    auto size = m_encoder.encode(serialization_buffer, out(encoder_buffer));
-    write(*buffer, 0, boost::endian::native_to_little<std::uint32_t>(size));
   }
 
   template<typename C, IsSender S, IsEncoder E> requires
@@ -182,11 +210,9 @@ namespace Beam {
     } else {
       append(encoder_buffer, std::uint32_t(0));
     }
-    {
-      auto lock = boost::lock_guard(m_mutex);
-      m_sender.set(Ref(sender_buffer));
-      m_sender.send(message);
-    }
+    auto sender = acquire_sender();
+    sender->set(Ref(sender_buffer));
+    sender->send(message);
     if(in_place_support_v<Encoder>) {
       auto sender_view_buffer =
         SuffixBuffer(Ref(sender_buffer), sizeof(std::uint32_t));
@@ -202,6 +228,7 @@ namespace Beam {
         boost::endian::native_to_little<std::uint32_t>(size));
       m_writer.write(encoder_buffer);
     }
+    release_sender(std::move(sender));
   }
 
   template<typename C, IsSender S, IsEncoder E> requires
@@ -217,33 +244,31 @@ namespace Beam {
   template<typename Message>
   Message MessageProtocol<C, S, E>::receive() {
     try {
+      fill(sizeof(std::uint32_t));
       auto size = std::uint32_t(0);
-      auto span = ValueSpan(Ref(size));
-      reset(span);
-      while(span.get_size() != sizeof(size)) {
-        m_channel->get_reader().read(out(span), sizeof(size) - span.get_size());
-      }
+      std::memcpy(&size, m_receive_buffer.get_data() + m_receive_position,
+        sizeof(size));
       size = boost::endian::little_to_native<std::uint32_t>(size);
-      while(size > m_receive_buffer.get_size()) {
-        m_channel->get_reader().read(out(m_receive_buffer),
-          size - m_receive_buffer.get_size());
-      }
+      fill(sizeof(size) + size);
+      m_frame = SharedBuffer(
+        m_receive_buffer, m_receive_position + sizeof(size), size);
+      m_receive_position += sizeof(size) + size;
       if(in_place_support_v<Decoder>) {
-        m_decoder.decode(m_receive_buffer, out(m_receive_buffer));
-        m_receiver.set(Ref(m_receive_buffer));
+        m_decoder.decode(m_frame, out(m_frame));
+        m_receiver.set(Ref(m_frame));
       } else {
-        m_decoder.decode(m_receive_buffer, out(m_decoder_buffer));
+        m_decoder.decode(m_frame, out(m_decoder_buffer));
         m_receiver.set(Ref(m_decoder_buffer));
       }
       auto message = Message();
       m_receiver.shuttle(message);
-      reset(m_receive_buffer);
+      m_frame = SharedBuffer();
       if(!in_place_support_v<Decoder>) {
         reset(m_decoder_buffer);
       }
       return message;
     } catch(const std::exception&) {
-      reset(m_receive_buffer);
+      m_frame = SharedBuffer();
       reset(m_decoder_buffer);
       throw;
     }
@@ -258,6 +283,52 @@ namespace Beam {
     m_channel->get_connection().close();
     m_open_state.close();
   }
+
+  template<typename C, IsSender S, IsEncoder E> requires
+    IsChannel<dereference_t<C>>
+  std::unique_ptr<typename MessageProtocol<C, S, E>::Sender>
+      MessageProtocol<C, S, E>::acquire_sender() {
+    auto lock = boost::lock_guard(m_mutex);
+    if(!m_senders.empty()) {
+      auto sender = std::move(m_senders.back());
+      m_senders.pop_back();
+      return sender;
+    }
+    auto sender = std::make_unique<Sender>(m_sender);
+    if(sender->get_type_id_format() == TypeIdFormat::BUFFER) {
+      sender->set_type_id_format(TypeIdFormat::STREAM);
+    }
+    return sender;
+  }
+
+  template<typename C, IsSender S, IsEncoder E> requires
+    IsChannel<dereference_t<C>>
+  void MessageProtocol<C, S, E>::release_sender(
+      std::unique_ptr<Sender> sender) {
+    auto lock = boost::lock_guard(m_mutex);
+    m_senders.push_back(std::move(sender));
+  }
+
+  template<typename C, IsSender S, IsEncoder E> requires
+    IsChannel<dereference_t<C>>
+  void MessageProtocol<C, S, E>::fill(std::size_t size) {
+    if(m_receive_position == m_receive_buffer.get_size()) {
+      reset(m_receive_buffer);
+      m_receive_position = 0;
+    }
+    while(m_receive_buffer.get_size() - m_receive_position < size) {
+      if(m_receive_position != 0) {
+        auto remaining_size = m_receive_buffer.get_size() - m_receive_position;
+        auto data = m_receive_buffer.get_mutable_data();
+        std::memmove(data, data + m_receive_position, remaining_size);
+        m_receive_buffer.shrink(m_receive_position);
+        m_receive_position = 0;
+      }
+      auto required_size = size - m_receive_buffer.get_size();
+      m_channel->get_reader().read(out(m_receive_buffer),
+        std::max(required_size, RECEIVE_CHUNK_SIZE));
+    }
+  }
 }
 
 #endif
@@ -1,6 +1,8 @@
 #ifndef BEAM_RECORD_MESSAGE_HPP
 #define BEAM_RECORD_MESSAGE_HPP
+#include <concepts>
 #include <utility>
+#include <vector>
 #include <boost/preprocessor/cat.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/preprocessor/tuple/elem.hpp>
@@ -106,32 +108,61 @@ namespace Beam {
   }
 
   /**
-   * Sends a message to a list of ServiceProtocolClients.
+   * Sends a message to a list of ServiceProtocolClients, encoding it once for
+   * every client that shares an encoding and individually for the rest.
    * @param clients The list of ServiceProtocolClients to send the message to.
+   * @param is_shared Returns <code>true</code> iff a client can be sent the
+   *        shared encoding of the message, <code>false</code> iff its encoding
+   *        differs, such as when it uses a different Encoder or its Session
+   *        affects serialization.
    * @param args The data to send to the <i>clients</i>.
    */
-  template<typename R, typename ServiceProtocolClient, typename... Args>
+  template<typename R, typename ServiceProtocolClient, typename F,
+    typename... Args> requires std::predicate<F, const ServiceProtocolClient&>
   void broadcast_record_message(
-      const std::vector<ServiceProtocolClient*>& clients, Args&&... args) {
+      const std::vector<ServiceProtocolClient*>& clients, F&& is_shared,
+      Args&&... args) {
     if(clients.empty()) {
       return;
-    } else if(clients.size() == 1) {
-      send_record_message<R>(*clients.front(), std::forward<Args>(args)...);
-    } else {
-      auto message =
-        RecordMessage<R, ServiceProtocolClient>(std::forward<Args>(args)...);
-      auto buffer = SharedBuffer();
-      clients.front()->encode(message, out(buffer));
-      for(auto& client : clients) {
-        try {
+    }
+    auto message =
+      RecordMessage<R, ServiceProtocolClient>(std::forward<Args>(args)...);
+    auto buffer = SharedBuffer();
+    auto is_encoded = false;
+    for(auto& client : clients) {
+      try {
+        if(!is_shared(*client)) {
+          client->send(message);
+        } else if(is_encoded) {
+          client->send(buffer);
+        } else if(client == clients.back()) {
+          client->send(message);
+        } else {
+          client->encode(message, out(buffer));
+          is_encoded = true;
           client->send(buffer);
-        } catch(const std::exception&) {
-          continue;
         }
+      } catch(const std::exception&) {
+        continue;
       }
     }
   }
 
+  /**
+   * Sends a message to a list of ServiceProtocolClients. The message is
+   * serialized and encoded once, and the same Buffer is written to every
+   * client.
+   * @param clients The list of ServiceProtocolClients to send the message to.
+   * @param args The data to send to the <i>clients</i>.
+   */
+  template<typename R, typename ServiceProtocolClient, typename... Args>
+  void broadcast_record_message(
+      const std::vector<ServiceProtocolClient*>& clients, Args&&... args) {
+    broadcast_record_message<R>(clients, [] (const ServiceProtocolClient&) {
+      return true;
+    }, std::forward<Args>(args)...);
+  }
+
   template<typename R, typename C>
   template<typename... Args>
   RecordMessage<R, C>::RecordMessage(Args&&... args)
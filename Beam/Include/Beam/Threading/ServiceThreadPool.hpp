@@ -1,9 +1,16 @@
 #ifndef BEAM_SERVICE_THREAD_POOL_HPP
 #define BEAM_SERVICE_THREAD_POOL_HPP
+#include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 #include <boost/asio/io_context.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/Threading/WorkerConfig.hpp"
 #include "Beam/Utilities/DllExport.hpp"
+#include "Beam/Utilities/ReportException.hpp"
 #include "Beam/Utilities/Singleton.hpp"
 
 namespace Beam {
@@ -13,13 +20,40 @@ namespace Beam {
   class TcpSocketChannel;
   class UdpSocket;
 
-  /** Wraps a list of ASIO worker threads. */
+  /**
+   * Wraps a list of ASIO worker threads. When the worker threads are pinned,
+   * each NUMA node gets its own io_context so that sockets opened by a thread
+   * pinned to a node have their handlers run on that same node.
+   */
   class BEAM_EXPORT_DLL ServiceThreadPool :
       public Singleton<ServiceThreadPool> {
     public:
       ~ServiceThreadPool();
 
+      /**
+       * Sets the WorkerConfig used to construct the ServiceThreadPool, must be
+       * called before the ServiceThreadPool is first used.
+       * @param config The WorkerConfig to use.
+       */
+      static void set_config(const WorkerConfig& config);
+
+      /** Returns the number of threads used by the ServiceThreadPool. */
+      std::size_t get_thread_count() const;
+
     private:
+      struct Service {
+        int m_numa_node;
+        boost::asio::io_context m_context;
+        boost::asio::executor_work_guard<
+          boost::asio::io_context::executor_type> m_work;
+
+        explicit Service(int numa_node);
+      };
+      struct ConfigEntry {
+        boost::mutex m_mutex;
+        WorkerConfig m_config;
+        bool m_is_started = false;
+      };
       friend class Beam::MulticastSocket;
       friend class Beam::SecureSocketChannel;
       friend class Beam::TcpServerSocket;
@@ -27,38 +61,101 @@ namespace Beam {
       friend class Beam::UdpSocket;
       friend class LiveTimer;
       friend class Singleton<ServiceThreadPool>;
-      boost::asio::io_context m_service;
-      boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
-        m_work;
+      WorkerConfig m_config;
+      std::vector<std::unique_ptr<Service>> m_services;
       std::size_t m_thread_count;
       std::unique_ptr<boost::thread[]> m_threads;
 
+      static ConfigEntry& get_config_entry();
+      static WorkerConfig load_config();
       ServiceThreadPool();
       ServiceThreadPool(const ServiceThreadPool&) = delete;
       ServiceThreadPool& operator =(const ServiceThreadPool&) = delete;
+      Service& get_service(int numa_node);
       boost::asio::io_context& get_context();
   };
 
+  inline ServiceThreadPool::Service::Service(int numa_node)
+    : m_numa_node(numa_node),
+      m_work(boost::asio::make_work_guard(m_context)) {}
+
   inline ServiceThreadPool::~ServiceThreadPool() {
-    m_service.stop();
+    for(auto& service : m_services) {
+      service->m_context.stop();
+    }
     for(auto i = std::size_t(0); i < m_thread_count; ++i) {
       m_threads[i].join();
     }
   }
 
+  inline void ServiceThreadPool::set_config(const WorkerConfig& config) {
+    auto& entry = get_config_entry();
+    auto lock = boost::lock_guard(entry.m_mutex);
+    if(entry.m_is_started) {
+      boost::throw_with_location(
+        std::logic_error("ServiceThreadPool already started."));
+    }
+    entry.m_config = config;
+  }
+
+  inline std::size_t ServiceThreadPool::get_thread_count() const {
+    return m_thread_count;
+  }
+
+  inline ServiceThreadPool::ConfigEntry&
+      ServiceThreadPool::get_config_entry() {
+    static auto entry = ConfigEntry();
+    return entry;
+  }
+
+  inline WorkerConfig ServiceThreadPool::load_config() {
+    auto& entry = get_config_entry();
+    auto lock = boost::lock_guard(entry.m_mutex);
+    entry.m_is_started = true;
+    return entry.m_config;
+  }
+
   inline ServiceThreadPool::ServiceThreadPool()
-      : m_work(boost::asio::make_work_guard(m_service)),
-        m_thread_count(boost::thread::hardware_concurrency()),
+      : m_config(load_config()),
+        m_thread_count(Beam::get_thread_count(m_config)),
         m_threads(std::make_unique<boost::thread[]>(m_thread_count)) {
+    auto services = std::vector<Service*>();
+    for(auto i = std::size_t(0); i < m_thread_count; ++i) {
+      services.push_back(&get_service(get_numa_node(m_config, i)));
+    }
     for(auto i = std::size_t(0); i < m_thread_count; ++i) {
-      m_threads[i] = boost::thread([this] {
-        m_service.run();
+      m_threads[i] = boost::thread([=, this] {
+        try {
+          set_thread_affinity(get_cpu_set(m_config, i));
+        } catch(...) {
+          std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+        }
+        services[i]->m_context.run();
       });
     }
   }
 
+  inline ServiceThreadPool::Service&
+      ServiceThreadPool::get_service(int numa_node) {
+    for(auto& service : m_services) {
+      if(service->m_numa_node == numa_node) {
+        return *service;
+      }
+    }
+    m_services.push_back(std::make_unique<Service>(numa_node));
+    return *m_services.back();
+  }
+
   inline boost::asio::io_context& ServiceThreadPool::get_context() {
-    return m_service;
+    auto numa_node = get_current_numa_node();
+    if(numa_node != -1 && m_services.size() > 1) {
+      for(auto& service : m_services) {
+        if(service->m_numa_node == numa_node) {
+          return service->m_context;
+        }
+      }
+    }
+    return m_services.front()->m_context;
   }
 }
 
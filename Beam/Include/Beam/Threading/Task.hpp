@@ -0,0 +1,182 @@
+#ifndef BEAM_TASK_HPP
+#define BEAM_TASK_HPP
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <boost/throw_exception.hpp>
+
+namespace Beam {
+namespace Details {
+  struct TaskOperations {
+    void (*m_invoke)(void*);
+    void (*m_move)(void*, void*) noexcept;
+    void (*m_destroy)(void*) noexcept;
+    bool m_is_inline;
+  };
+
+  template<typename F>
+  struct InlineTaskOperations {
+    static void invoke(void* storage) {
+      (*std::launder(static_cast<F*>(storage)))();
+    }
+
+    static void move(void* source, void* destination) noexcept {
+      auto& callable = *std::launder(static_cast<F*>(source));
+      ::new(destination) F(std::move(callable));
+      callable.~F();
+    }
+
+    static void destroy(void* storage) noexcept {
+      std::launder(static_cast<F*>(storage))->~F();
+    }
+
+    static constexpr auto VALUE =
+      TaskOperations(&invoke, &move, &destroy, true);
+  };
+
+  template<typename F>
+  struct HeapTaskOperations {
+    static void invoke(void* storage) {
+      (**static_cast<F**>(storage))();
+    }
+
+    static void move(void* source, void* destination) noexcept {
+      *static_cast<F**>(destination) = *static_cast<F**>(source);
+    }
+
+    static void destroy(void* storage) noexcept {
+      delete *static_cast<F**>(storage);
+    }
+
+    static constexpr auto VALUE =
+      TaskOperations(&invoke, &move, &destroy, false);
+  };
+}
+
+  /**
+   * Stores a move-only callable object taking no parameters. Callables that
+   * fit within INLINE_SIZE bytes and can be moved without throwing are stored
+   * inline, avoiding the heap allocation that a std::function performs for
+   * any capturing lambda.
+   */
+  class Task {
+    public:
+
+      /**
+       * The largest callable stored inline, chosen so that a Task fits in a
+       * single cache line.
+       */
+      static constexpr auto INLINE_SIZE =
+        std::size_t(64) - sizeof(const Details::TaskOperations*);
+
+      /** Constructs an empty Task. */
+      Task() noexcept;
+
+      /**
+       * Constructs a Task.
+       * @param callable The callable object to store.
+       */
+      template<typename F> requires
+        (!std::same_as<std::remove_cvref_t<F>, Task>) &&
+          std::invocable<std::remove_cvref_t<F>&> &&
+            std::constructible_from<std::remove_cvref_t<F>, F&&>
+      Task(F&& callable);
+
+      Task(Task&& task) noexcept;
+
+      ~Task();
+
+      /** Returns <code>true</code> iff the callable is stored inline. */
+      bool is_inline() const noexcept;
+
+      /** Returns <code>true</code> iff this Task stores a callable. */
+      explicit operator bool() const noexcept;
+
+      /** Invokes the stored callable. */
+      void operator ()();
+
+      Task& operator =(Task&& task) noexcept;
+
+    private:
+      alignas(std::max_align_t) std::byte m_storage[INLINE_SIZE];
+      const Details::TaskOperations* m_operations;
+
+      Task(const Task&) = delete;
+      Task& operator =(const Task&) = delete;
+      void reset() noexcept;
+  };
+
+  inline Task::Task() noexcept
+    : m_operations(nullptr) {}
+
+  template<typename F> requires
+    (!std::same_as<std::remove_cvref_t<F>, Task>) &&
+      std::invocable<std::remove_cvref_t<F>&> &&
+        std::constructible_from<std::remove_cvref_t<F>, F&&>
+  Task::Task(F&& callable) {
+    using Callable = std::remove_cvref_t<F>;
+    if constexpr(sizeof(Callable) <= INLINE_SIZE &&
+        alignof(Callable) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<Callable>) {
+      ::new(static_cast<void*>(m_storage)) Callable(
+        std::forward<F>(callable));
+      m_operations = &Details::InlineTaskOperations<Callable>::VALUE;
+    } else {
+      ::new(static_cast<void*>(m_storage)) Callable*(
+        new Callable(std::forward<F>(callable)));
+      m_operations = &Details::HeapTaskOperations<Callable>::VALUE;
+    }
+  }
+
+  inline Task::Task(Task&& task) noexcept
+      : m_operations(task.m_operations) {
+    if(m_operations) {
+      m_operations->m_move(task.m_storage, m_storage);
+      task.m_operations = nullptr;
+    }
+  }
+
+  inline Task::~Task() {
+    reset();
+  }
+
+  inline bool Task::is_inline() const noexcept {
+    return m_operations && m_operations->m_is_inline;
+  }
+
+  inline Task::operator bool() const noexcept {
+    return m_operations != nullptr;
+  }
+
+  inline void Task::operator ()() {
+    if(!m_operations) {
+      boost::throw_with_location(std::bad_function_call());
+    }
+    m_operations->m_invoke(m_storage);
+  }
+
+  inline Task& Task::operator =(Task&& task) noexcept {
+    if(this == &task) {
+      return *this;
+    }
+    reset();
+    if(task.m_operations) {
+      task.m_operations->m_move(task.m_storage, m_storage);
+      m_operations = task.m_operations;
+      task.m_operations = nullptr;
+    }
+    return *this;
+  }
+
+  inline void Task::reset() noexcept {
+    if(m_operations) {
+      m_operations->m_destroy(m_storage);
+      m_operations = nullptr;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef BEAM_WORKER_CONFIG_HPP
+#define BEAM_WORKER_CONFIG_HPP
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <boost/thread/thread.hpp>
+#include <boost/throw_exception.hpp>
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #include <windows.h>
+#elif defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+#include "Beam/Utilities/DllExport.hpp"
+
+namespace Beam {
+
+  /** Stores a set of CPU indices that a thread may run on. */
+  using CpuSet = std::vector<int>;
+
+  /** Stores the configuration of a group of worker threads. */
+  struct WorkerConfig {
+
+    /** The number of threads, or 0 to use the system's concurrency. */
+    std::size_t m_thread_count = 0;
+
+    /**
+     * The CPU sets that threads are pinned to, assigned in round-robin order.
+     * Threads are left unpinned if empty.
+     */
+    std::vector<CpuSet> m_cpu_sets;
+  };
+
+namespace Details {
+  struct BEAM_EXPORT_DLL CurrentNumaNodeGlobal {
+    static int& get();
+  };
+
+#ifndef BEAM_USE_DLL
+  BEAM_EMIT_DLL inline int& CurrentNumaNodeGlobal::get() {
+    static thread_local auto value = -1;
+    return value;
+  }
+#endif
+}
+
+  /**
+   * Returns the number of threads specified by a WorkerConfig.
+   * @param config The WorkerConfig to query.
+   */
+  inline std::size_t get_thread_count(const WorkerConfig& config) {
+    if(config.m_thread_count != 0) {
+      return config.m_thread_count;
+    }
+    return std::max<std::size_t>(boost::thread::hardware_concurrency(), 1);
+  }
+
+  /**
+   * Returns the NUMA node a CPU belongs to, or 0 if it can not be determined.
+   * @param cpu The index of the CPU.
+   */
+  inline int get_numa_node(int cpu) {
+#ifdef _WIN32
+    auto node = USHORT();
+    auto processor = PROCESSOR_NUMBER();
+    processor.Group = static_cast<WORD>(cpu / 64);
+    processor.Number = static_cast<BYTE>(cpu % 64);
+    if(GetNumaProcessorNodeEx(&processor, &node) && node != 0xFFFF) {
+      return static_cast<int>(node);
+    }
+#elif defined(__linux__)
+    auto path = std::filesystem::path("/sys/devices/system/cpu") /
+      ("cpu" + std::to_string(cpu));
+    auto error = std::error_code();
+    for(auto& entry : std::filesystem::directory_iterator(path, error)) {
+      auto name = entry.path().filename().string();
+      if(name.starts_with("node") && name.size() > 4 &&
+          name.find_first_not_of("0123456789", 4) == std::string::npos) {
+        return std::stoi(name.substr(4));
+      }
+    }
+#endif
+    return 0;
+  }
+
+  /**
+   * Returns the NUMA node the calling thread was pinned to, or -1 if the
+   * thread is unpinned.
+   */
+  inline int get_current_numa_node() {
+    return Details::CurrentNumaNodeGlobal::get();
+  }
+
+  /**
+   * Returns the CPU set a worker is pinned to.
+   * @param config The WorkerConfig specifying the CPU sets.
+   * @param index The index of the worker.
+   * @return The CPU set assigned to the worker, or an empty set if the worker
+   *         is unpinned.
+   */
+  inline const CpuSet& get_cpu_set(
+      const WorkerConfig& config, std::size_t index) {
+    static const auto NONE = CpuSet();
+    if(config.m_cpu_sets.empty()) {
+      return NONE;
+    }
+    return config.m_cpu_sets[index % config.m_cpu_sets.size()];
+  }
+
+  /**
+   * Returns the NUMA node a worker belongs to.
+   * @param config The WorkerConfig specifying the CPU sets.
+   * @param index The index of the worker.
+   * @return The NUMA node of the first CPU the worker is pinned to, or -1 if
+   *         the worker is unpinned.
+   */
+  inline int get_numa_node(const WorkerConfig& config, std::size_t index) {
+    auto& cpus = get_cpu_set(config, index);
+    if(cpus.empty()) {
+      return -1;
+    }
+    return get_numa_node(cpus.front());
+  }
+
+  /**
+   * Pins the calling thread to a set of CPUs.
+   * @param cpus The CPUs the calling thread may run on, an empty set leaves
+   *        the thread unpinned.
+   */
+  inline void set_thread_affinity(const CpuSet& cpus) {
+    if(cpus.empty()) {
+      return;
+    }
+#ifdef _WIN32
+    auto mask = DWORD_PTR(0);
+    for(auto cpu : cpus) {
+      if(cpu >= 0 && cpu < static_cast<int>(8 * sizeof(DWORD_PTR))) {
+        mask |= DWORD_PTR(1) << cpu;
+      }
+    }
+    if(SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+      boost::throw_with_location(
+        std::runtime_error("Unable to set thread affinity."));
+    }
+#elif defined(__linux__)
+    auto set = cpu_set_t();
+    CPU_ZERO(&set);
+    for(auto cpu : cpus) {
+      if(cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    if(pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+      boost::throw_with_location(
+        std::runtime_error("Unable to set thread affinity."));
+    }
+#endif
+    Details::CurrentNumaNodeGlobal::get() = get_numa_node(cpus.front());
+  }
+}
+
+#endif
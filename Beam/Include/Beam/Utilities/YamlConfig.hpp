@@ -23,6 +23,7 @@
 #include "Beam/Pointers/Out.hpp"
 #include "Beam/Serialization/DataShuttle.hpp"
 #include "Beam/Serialization/SerializedValue.hpp"
+#include "Beam/Threading/WorkerConfig.hpp"
 #include "Beam/Utilities/AssertionException.hpp"
 #include "Beam/Utilities/Expect.hpp"
 
@@ -297,6 +298,56 @@ namespace Beam {
       return IpAddress(host, port);
     }
   };
+
+  template<>
+  struct YamlValueExtractor<WorkerConfig> {
+    WorkerConfig operator ()(const YAML::Node& node) const {
+      auto config = WorkerConfig();
+      config.m_thread_count =
+        extract<std::size_t>(node, "threads", std::size_t(0));
+      if(auto cpus = node["cpus"]) {
+        for(const auto& cpu_set : cpus) {
+          config.m_cpu_sets.push_back(parse_cpu_set(cpu_set));
+        }
+      }
+      return config;
+    }
+
+    static CpuSet parse_cpu_set(const YAML::Node& node) {
+      auto cpus = CpuSet();
+      if(node.IsSequence()) {
+        for(const auto& cpu : node) {
+          auto range = parse_cpu_set(cpu);
+          cpus.insert(cpus.end(), range.begin(), range.end());
+        }
+        return cpus;
+      }
+      auto raw_value = node.as<std::string>();
+      boost::trim(raw_value);
+      try {
+        auto dash_position = raw_value.find('-');
+        if(dash_position == std::string::npos) {
+          cpus.push_back(boost::lexical_cast<int>(raw_value));
+        } else {
+          auto first = boost::lexical_cast<int>(
+            boost::trim_copy(raw_value.substr(0, dash_position)));
+          auto last = boost::lexical_cast<int>(
+            boost::trim_copy(raw_value.substr(dash_position + 1)));
+          for(auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+          }
+        }
+      } catch(const std::exception&) {
+        BEAM_ASSERT_MESSAGE(false, "Config error at line " <<
+          (node.Mark().line + 1) << ", column " << (node.Mark().column + 1) <<
+          ":\n\tInvalid CPU set: " << raw_value << std::endl);
+      }
+      BEAM_ASSERT_MESSAGE(!cpus.empty(), "Config error at line " <<
+        (node.Mark().line + 1) << ", column " << (node.Mark().column + 1) <<
+        ":\n\tEmpty CPU set: " << raw_value << std::endl);
+      return cpus;
+    }
+  };
 }
 
 #endif
@@ -4,6 +4,23 @@
 #include "Beam/IO/SharedBuffer.hpp"
 
 using namespace Beam;
+using namespace boost::posix_time;
+
+namespace {
+  struct CountingWriter {
+    BufferWriter<SharedBuffer> m_writer;
+    int* m_count;
+
+    CountingWriter(Ref<SharedBuffer> buffer, int& count)
+      : m_writer(std::move(buffer)),
+        m_count(&count) {}
+
+    void write(const IsConstBuffer auto& data) {
+      ++*m_count;
+      m_writer.write(data);
+    }
+  };
+}
 
 TEST_SUITE("AsyncWriter") {
   TEST_CASE("write_raw_appends") {
@@ -58,4 +75,33 @@ TEST_SUITE("AsyncWriter") {
     }
     REQUIRE(buffer.get_size() == 0);
   }
+
+  TEST_CASE("coalesce_writes") {
+    auto buffer = SharedBuffer();
+    auto count = 0;
+    {
+      auto writer = AsyncWriter(std::make_unique<CountingWriter>(
+        Ref(buffer), count), 1024, milliseconds(100));
+      writer.write(from<SharedBuffer>("ab"));
+      writer.write(from<SharedBuffer>("cd"));
+      writer.write(from<SharedBuffer>("ef"));
+    }
+    REQUIRE(buffer == "abcdef");
+    REQUIRE(count == 1);
+  }
+
+  TEST_CASE("coalesce_max_batch_size") {
+    auto buffer = SharedBuffer();
+    auto count = 0;
+    {
+      auto writer = AsyncWriter(std::make_unique<CountingWriter>(
+        Ref(buffer), count), 4, milliseconds(100));
+      writer.write(from<SharedBuffer>("ab"));
+      writer.write(from<SharedBuffer>("cd"));
+      writer.write(from<SharedBuffer>("efghij"));
+      writer.write(from<SharedBuffer>("k"));
+    }
+    REQUIRE(buffer == "abcdefghijk");
+    REQUIRE(count == 3);
+  }
 }
@@ -0,0 +1,107 @@
+#include <optional>
+#include <string>
+#include <thread>
+#include <doctest/doctest.h>
+#include "Beam/IO/BufferPool.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+
+using namespace Beam;
+
+namespace {
+  auto make_message(const std::string& payload) {
+    auto buffer = SharedBuffer();
+    append(buffer, std::uint32_t(0));
+    append(buffer, payload.data(), payload.size());
+    return buffer;
+  }
+}
+
+TEST_SUITE("BufferPool") {
+  TEST_CASE("reuse") {
+    auto& pool = BufferPool::get();
+    { auto buffer = SharedBuffer(100); }
+    auto statistics = pool.get_statistics();
+    { auto buffer = SharedBuffer(100); }
+    REQUIRE(pool.get_statistics().m_allocations == statistics.m_allocations);
+    REQUIRE(pool.get_statistics().m_reuses > statistics.m_reuses);
+  }
+
+  TEST_CASE("size_class") {
+    auto& pool = BufferPool::get();
+    { auto buffer = SharedBuffer(1024); }
+    auto statistics = pool.get_statistics();
+    { auto buffer = SharedBuffer(600); }
+    REQUIRE(pool.get_statistics().m_allocations == statistics.m_allocations);
+  }
+
+  TEST_CASE("max_block_reuse") {
+    auto& pool = BufferPool::get();
+    auto statistics = pool.get_statistics();
+    { auto buffer = SharedBuffer(BufferPool::MAX_BLOCK_SIZE); }
+    auto warm_statistics = pool.get_statistics();
+    REQUIRE(warm_statistics.m_allocations + warm_statistics.m_reuses >
+      statistics.m_allocations + statistics.m_reuses);
+    for(auto i = 0; i != 10; ++i) {
+      auto buffer = SharedBuffer(BufferPool::MAX_BLOCK_SIZE);
+      REQUIRE(buffer.get_size() == BufferPool::MAX_BLOCK_SIZE);
+    }
+    REQUIRE(pool.get_statistics().m_allocations ==
+      warm_statistics.m_allocations);
+    REQUIRE(pool.get_statistics().m_reuses >= warm_statistics.m_reuses + 10);
+  }
+
+  TEST_CASE("large_blocks") {
+    auto& pool = BufferPool::get();
+    auto statistics = pool.get_statistics();
+    { auto buffer = SharedBuffer(2 * BufferPool::MAX_BLOCK_SIZE); }
+    { auto buffer = SharedBuffer(2 * BufferPool::MAX_BLOCK_SIZE); }
+    REQUIRE(pool.get_statistics().m_allocations ==
+      statistics.m_allocations + 2);
+  }
+
+  TEST_CASE("copy_on_write") {
+    auto a = SharedBuffer("abc", 3);
+    auto b = a;
+    append(b, "d", 1);
+    REQUIRE(a == "abc");
+    REQUIRE(b == "abcd");
+  }
+
+  TEST_CASE("allocations_per_message") {
+    const auto MESSAGE_COUNT = 1000;
+    auto& pool = BufferPool::get();
+    auto payload = std::string(200, 'x');
+    make_message(payload);
+    auto statistics = pool.get_statistics();
+    for(auto i = 0; i != MESSAGE_COUNT; ++i) {
+      auto message = make_message(payload);
+      REQUIRE(message.get_size() == sizeof(std::uint32_t) + payload.size());
+    }
+    auto allocations =
+      pool.get_statistics().m_allocations - statistics.m_allocations;
+    auto reuses = pool.get_statistics().m_reuses - statistics.m_reuses;
+    REQUIRE(allocations == 0);
+    REQUIRE(reuses >= MESSAGE_COUNT);
+  }
+
+  TEST_CASE("thread_exit") {
+    auto is_reallocated = false;
+    auto thread = std::thread([&] {
+      struct Holder {
+        bool* m_is_reallocated;
+        std::optional<SharedBuffer> m_buffer;
+
+        ~Holder() {
+          m_buffer.reset();
+          auto buffer = SharedBuffer(100);
+          *m_is_reallocated = buffer.get_size() == 100;
+        }
+      };
+      thread_local auto holder = Holder(&is_reallocated);
+      holder.m_buffer.emplace(100);
+      { auto buffer = SharedBuffer(100); }
+    });
+    thread.join();
+    REQUIRE(is_reallocated);
+  }
+}
@@ -73,4 +73,16 @@ TEST_SUITE("SharedBuffer") {
     buffer.grow(3);
     REQUIRE(buffer.get_size() == before + 3);
   }
+
+  TEST_CASE("view") {
+    auto buffer = SharedBuffer("abcdef", 6);
+    auto view = SharedBuffer(buffer, 2, 3);
+    REQUIRE(view == "cde");
+    REQUIRE(view.get_data() == buffer.get_data() + 2);
+    view.get_mutable_data()[0] = 'X';
+    REQUIRE(view == "Xde");
+    REQUIRE(buffer == "abcdef");
+    append(view, "f", 1);
+    REQUIRE(view == "Xdef");
+  }
 }
@@ -1,5 +1,8 @@
 #include <algorithm>
 #include <atomic>
+#include <filesystem>
+#include <memory>
+#include <random>
 #include <stdexcept>
 #include <vector>
 #include <doctest/doctest.h>
@@ -7,10 +10,13 @@
 #include "Beam/Queries/BasicQuery.hpp"
 #include "Beam/Queries/EvaluatorTranslator.hpp"
 #include "Beam/Queries/LocalDataStore.hpp"
+#include "Beam/Queries/WriteAheadLog.hpp"
+#include "Beam/Queues/PipeBrokenException.hpp"
 #include "Beam/QueriesTests/TestDataStore.hpp"
 #include "Beam/QueriesTests/TestEntry.hpp"
 #include "Beam/Routines/RoutineHandler.hpp"
 #include "Beam/Routines/Scheduler.hpp"
+#include "Beam/TimeService/LiveTimer.hpp"
 
 using namespace Beam;
 using namespace Beam::Tests;
@@ -24,6 +30,20 @@ namespace {
   using DataStoreDispatcher = TestDataStore<BasicQuery<std::string>, TestEntry>;
   using IntrusiveDataStore = AsyncDataStore<
     std::shared_ptr<DataStoreDispatcher>, EvaluatorTranslator<QueryTypes>>;
+
+  struct CountingDataStore : TestLocalDataStore {
+    std::size_t m_count = 0;
+
+    void store(const TestLocalDataStore::IndexedValue& value) {
+      ++m_count;
+      TestLocalDataStore::store(value);
+    }
+
+    void store(const std::vector<TestLocalDataStore::IndexedValue>& values) {
+      m_count += values.size();
+      TestLocalDataStore::store(values);
+    }
+  };
 }
 
 TEST_SUITE("AsyncDataStore") {
@@ -115,6 +135,35 @@ TEST_SUITE("AsyncDataStore") {
       {entry_a, entry_b, entry_c, entry_d});
   }
 
+  TEST_CASE("batch_load") {
+    auto local_data_store = TestLocalDataStore();
+    auto data_store = AsyncDataStore(&local_data_store);
+    auto sequence = Beam::Sequence(5);
+    auto entry_a = store(local_data_store, "hello", 100,
+      time_from_string("2016-07-30 04:12:55:44"), sequence);
+    sequence = increment(sequence);
+    auto entry_b = store(data_store, "world", 101,
+      time_from_string("2016-07-30 04:12:55:48"), sequence);
+    sequence = increment(sequence);
+    auto entry_c = store(data_store, "hello", 102,
+      time_from_string("2016-07-30 04:12:55:50"), sequence);
+    auto queries = std::vector<BasicQuery<std::string>>();
+    for(auto index : {"hello", "world", "goodbye", "hello"}) {
+      auto& query = queries.emplace_back();
+      query.set_index(index);
+      query.set_range(Beam::Range::TOTAL);
+      query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    }
+    queries.back().set_snapshot_limit(SnapshotLimit::from_tail(1));
+    auto results = data_store.load(queries);
+    REQUIRE(results.size() == 4);
+    REQUIRE(results[0] ==
+      std::vector<SequencedTestEntry>{entry_a, entry_c});
+    REQUIRE(results[1] == std::vector<SequencedTestEntry>{entry_b});
+    REQUIRE(results[2].empty());
+    REQUIRE(results[3] == std::vector<SequencedTestEntry>{entry_c});
+  }
+
   TEST_CASE("buffered_load") {
     auto dispatcher = std::make_shared<DataStoreDispatcher>();
     auto data_store = IntrusiveDataStore(dispatcher);
@@ -324,6 +373,95 @@ TEST_SUITE("AsyncDataStore") {
     REQUIRE(has_entry_a);
   }
 
+  TEST_CASE("high_water_mark") {
+    auto dispatcher = std::make_shared<DataStoreDispatcher>();
+    auto data_store = IntrusiveDataStore(dispatcher, 2);
+    auto operations = std::make_shared<
+      Queue<std::shared_ptr<DataStoreDispatcher::Operation>>>();
+    dispatcher->get_operation_publisher().monitor(operations);
+    auto sequence = Beam::Sequence(5);
+    store(data_store, "hello", 100,
+      time_from_string("2016-07-30 04:12:55:12"), sequence);
+    sequence = increment(sequence);
+    store(data_store, "hello", 200,
+      time_from_string("2016-07-30 04:12:55:15"), sequence);
+    sequence = increment(sequence);
+    REQUIRE(data_store.get_statistics().m_depth == 2);
+    auto is_stored = std::atomic_bool(false);
+    auto writer = RoutineHandler(spawn([&] {
+      store(data_store, "hello", 300,
+        time_from_string("2016-07-30 04:12:55:18"), sequence);
+      is_stored = true;
+    }));
+    auto operation = operations->pop();
+    std::get<DataStoreDispatcher::StoreOperation>(
+      *operation).m_result.set_exception(std::runtime_error("store failed"));
+    REQUIRE(!is_stored);
+    auto committed = std::size_t(0);
+    while(committed != 3) {
+      auto operation = operations->pop();
+      auto& store_operation =
+        std::get<DataStoreDispatcher::StoreOperation>(*operation);
+      committed += store_operation.m_values.size();
+      store_operation.m_result.set();
+    }
+    writer.wait();
+    REQUIRE(is_stored);
+    REQUIRE(data_store.get_statistics().m_failures == 1);
+  }
+
+  TEST_CASE("write_ahead_log_recovery") {
+    auto directory = std::filesystem::temp_directory_path() /
+      ("beam_wal_" + std::to_string(std::random_device()()));
+    auto sequence = Beam::Sequence(5);
+    auto entry = SequencedValue(IndexedValue(
+      TestEntry(100, time_from_string("2016-07-30 04:12:55:12")),
+      std::string("hello")), sequence);
+    {
+      auto log = WriteAheadLog<SequencedIndexedTestEntry>(directory);
+      log.sync(log.write(std::span(&entry, 1)));
+    }
+    auto local_data_store = TestLocalDataStore();
+    {
+      using LoggedDataStore = AsyncDataStore<TestLocalDataStore*>;
+      auto data_store = LoggedDataStore(&local_data_store, UNLIMITED_BUFFER,
+        std::make_unique<WriteAheadLog<SequencedIndexedTestEntry>>(directory),
+        LoggedDataStore::ExceptionHandler());
+    }
+    test_query(local_data_store, "hello", Beam::Range::TOTAL,
+      SnapshotLimit::UNLIMITED, {entry});
+    auto log = WriteAheadLog<SequencedIndexedTestEntry>(directory);
+    REQUIRE(log.recover().empty());
+    std::filesystem::remove_all(directory);
+  }
+
+  TEST_CASE("write_ahead_log_committed_recovery") {
+    auto directory = std::filesystem::temp_directory_path() /
+      ("beam_wal_" + std::to_string(std::random_device()()));
+    auto timestamp = time_from_string("2016-07-30 04:12:55:12");
+    auto entries = std::vector{
+      SequencedValue(IndexedValue(TestEntry(100, timestamp),
+        std::string("hello")), Beam::Sequence(5)),
+      SequencedValue(IndexedValue(TestEntry(101, timestamp),
+        std::string("hello")), Beam::Sequence(6))};
+    {
+      auto log = WriteAheadLog<SequencedIndexedTestEntry>(directory);
+      log.sync(log.write(entries));
+    }
+    auto local_data_store = CountingDataStore();
+    local_data_store.store(entries.front());
+    {
+      using LoggedDataStore = AsyncDataStore<CountingDataStore*>;
+      auto data_store = LoggedDataStore(&local_data_store, UNLIMITED_BUFFER,
+        std::make_unique<WriteAheadLog<SequencedIndexedTestEntry>>(directory),
+        LoggedDataStore::ExceptionHandler());
+    }
+    REQUIRE(local_data_store.m_count == 2);
+    test_query(local_data_store, "hello", Beam::Range::TOTAL,
+      SnapshotLimit::UNLIMITED, {entries[0], entries[1]});
+    std::filesystem::remove_all(directory);
+  }
+
   TEST_CASE("exception_handler") {
     auto dispatcher = std::make_shared<DataStoreDispatcher>();
     auto handler_called = std::atomic<bool>(false);
@@ -355,4 +493,35 @@ TEST_SUITE("AsyncDataStore") {
     data_store.close();
     REQUIRE(handler_called);
   }
+
+  TEST_CASE("retry_back_off") {
+    auto dispatcher = std::make_shared<DataStoreDispatcher>();
+    auto data_store = IntrusiveDataStore(dispatcher, 1,
+      IntrusiveDataStore::ExceptionHandler([] (const std::exception_ptr&) {}));
+    auto operations = std::make_shared<
+      Queue<std::shared_ptr<DataStoreDispatcher::Operation>>>();
+    dispatcher->get_operation_publisher().monitor(operations);
+    auto failures = std::atomic_int(0);
+    auto failer = RoutineHandler(spawn([&] {
+      try {
+        while(true) {
+          auto operation = operations->pop();
+          std::get<DataStoreDispatcher::StoreOperation>(
+            *operation).m_result.set_exception(
+              std::runtime_error("store failed"));
+          ++failures;
+        }
+      } catch(const PipeBrokenException&) {}
+    }));
+    store(data_store, "hello", 100,
+      time_from_string("2016-07-30 04:12:55:12"), Beam::Sequence(5));
+    auto timer = LiveTimer(milliseconds(100));
+    timer.start();
+    timer.wait();
+    auto count = failures.load();
+    REQUIRE(count >= 1);
+    REQUIRE(count <= 5);
+    data_store.close();
+    operations->close();
+  }
 }
@@ -1,4 +1,6 @@
 #include <atomic>
+#include <filesystem>
+#include <random>
 #include <stdexcept>
 #include <vector>
 #include <doctest/doctest.h>
@@ -6,11 +8,13 @@
 #include "Beam/Queries/BufferedDataStore.hpp"
 #include "Beam/Queries/EvaluatorTranslator.hpp"
 #include "Beam/Queries/LocalDataStore.hpp"
+#include "Beam/Queries/WriteAheadLog.hpp"
 #include "Beam/Queues/PipeBrokenException.hpp"
 #include "Beam/QueriesTests/TestDataStore.hpp"
 #include "Beam/QueriesTests/TestEntry.hpp"
 #include "Beam/Routines/RoutineHandler.hpp"
 #include "Beam/Routines/Scheduler.hpp"
+#include "Beam/TimeService/LiveTimer.hpp"
 
 using namespace Beam;
 using namespace Beam::Tests;
@@ -24,6 +28,20 @@ namespace {
   using DataStoreDispatcher = TestDataStore<BasicQuery<std::string>, TestEntry>;
   using IntrusiveDataStore = BufferedDataStore<
     std::shared_ptr<DataStoreDispatcher>, EvaluatorTranslator<QueryTypes>>;
+
+  struct CountingDataStore : TestLocalDataStore {
+    std::size_t m_count = 0;
+
+    void store(const TestLocalDataStore::IndexedValue& value) {
+      ++m_count;
+      TestLocalDataStore::store(value);
+    }
+
+    void store(const std::vector<TestLocalDataStore::IndexedValue>& values) {
+      m_count += values.size();
+      TestLocalDataStore::store(values);
+    }
+  };
 }
 
 TEST_SUITE("BufferedDataStore") {
@@ -224,6 +242,83 @@ TEST_SUITE("BufferedDataStore") {
     operations->close();
   }
 
+  TEST_CASE("high_water_mark") {
+    auto dispatcher = std::make_shared<DataStoreDispatcher>();
+    auto data_store = IntrusiveDataStore(dispatcher, 10, 2);
+    auto operations = std::make_shared<
+      Queue<std::shared_ptr<DataStoreDispatcher::Operation>>>();
+    dispatcher->get_operation_publisher().monitor(operations);
+    auto sequence = Beam::Sequence(5);
+    store(data_store, "hello", 100,
+      time_from_string("2016-07-30 04:12:55:12"), sequence);
+    sequence = increment(sequence);
+    store(data_store, "hello", 200,
+      time_from_string("2016-07-30 04:12:55:15"), sequence);
+    sequence = increment(sequence);
+    auto is_stored = std::atomic_bool(false);
+    auto writer = RoutineHandler(spawn([&] {
+      store(data_store, "hello", 300,
+        time_from_string("2016-07-30 04:12:55:18"), sequence);
+      is_stored = true;
+    }));
+    {
+      auto operation = operations->pop();
+      auto& store_operation =
+        std::get<DataStoreDispatcher::StoreOperation>(*operation);
+      REQUIRE(store_operation.m_values.size() == 2);
+      store_operation.m_result.set_exception(
+        std::runtime_error("store failed"));
+    }
+    REQUIRE(!is_stored);
+    {
+      auto operation = operations->pop();
+      auto& store_operation =
+        std::get<DataStoreDispatcher::StoreOperation>(*operation);
+      REQUIRE(store_operation.m_values.size() == 2);
+      store_operation.m_result.set();
+    }
+    writer.wait();
+    REQUIRE(is_stored);
+    auto statistics = data_store.get_statistics();
+    REQUIRE(statistics.m_depth == 1);
+    REQUIRE(statistics.m_flushes == 1);
+    REQUIRE(statistics.m_failures == 1);
+    auto handler = RoutineHandler(spawn([&] {
+      auto operation = operations->pop();
+      std::get<DataStoreDispatcher::StoreOperation>(
+        *operation).m_result.set();
+    }));
+    data_store.close();
+  }
+
+  TEST_CASE("write_ahead_log_committed_recovery") {
+    auto directory = std::filesystem::temp_directory_path() /
+      ("beam_wal_" + std::to_string(std::random_device()()));
+    auto timestamp = time_from_string("2016-07-30 04:12:55:12");
+    auto entries = std::vector{
+      SequencedValue(IndexedValue(TestEntry(100, timestamp),
+        std::string("hello")), Beam::Sequence(5)),
+      SequencedValue(IndexedValue(TestEntry(101, timestamp),
+        std::string("hello")), Beam::Sequence(6))};
+    {
+      auto log = WriteAheadLog<SequencedIndexedTestEntry>(directory);
+      log.sync(log.write(entries));
+    }
+    auto local_data_store = CountingDataStore();
+    local_data_store.store(entries.front());
+    {
+      using LoggedDataStore = BufferedDataStore<CountingDataStore*>;
+      auto data_store = LoggedDataStore(&local_data_store, 10,
+        UNLIMITED_BUFFER,
+        std::make_unique<WriteAheadLog<SequencedIndexedTestEntry>>(directory),
+        LoggedDataStore::ExceptionHandler());
+    }
+    REQUIRE(local_data_store.m_count == 2);
+    test_query(local_data_store, "hello", Beam::Range::TOTAL,
+      SnapshotLimit::UNLIMITED, {entries[0], entries[1]});
+    std::filesystem::remove_all(directory);
+  }
+
   TEST_CASE("exception_handler") {
     auto dispatcher = std::make_shared<DataStoreDispatcher>();
     auto handler_called = std::atomic<bool>(false);
@@ -272,4 +367,35 @@ TEST_SUITE("BufferedDataStore") {
     operations->close();
     REQUIRE(handler_called);
   }
+
+  TEST_CASE("retry_back_off") {
+    auto dispatcher = std::make_shared<DataStoreDispatcher>();
+    auto data_store = IntrusiveDataStore(dispatcher, 1, 1,
+      IntrusiveDataStore::ExceptionHandler([] (const std::exception_ptr&) {}));
+    auto operations = std::make_shared<
+      Queue<std::shared_ptr<DataStoreDispatcher::Operation>>>();
+    dispatcher->get_operation_publisher().monitor(operations);
+    auto failures = std::atomic_int(0);
+    auto failer = RoutineHandler(spawn([&] {
+      try {
+        while(true) {
+          auto operation = operations->pop();
+          std::get<DataStoreDispatcher::StoreOperation>(
+            *operation).m_result.set_exception(
+              std::runtime_error("store failed"));
+          ++failures;
+        }
+      } catch(const PipeBrokenException&) {}
+    }));
+    store(data_store, "hello", 100,
+      time_from_string("2016-07-30 04:12:55:12"), Beam::Sequence(5));
+    auto timer = LiveTimer(milliseconds(100));
+    timer.start();
+    timer.wait();
+    auto count = failures.load();
+    REQUIRE(count >= 1);
+    REQUIRE(count <= 5);
+    data_store.close();
+    operations->close();
+  }
 }
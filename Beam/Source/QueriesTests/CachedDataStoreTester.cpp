@@ -2,6 +2,7 @@
 #include <doctest/doctest.h>
 #include "Beam/Queries/BasicQuery.hpp"
 #include "Beam/Queries/CachedDataStore.hpp"
+#include "Beam/Queries/CachedDataStoreEntry.hpp"
 #include "Beam/Queries/EvaluatorTranslator.hpp"
 #include "Beam/Queries/LocalDataStore.hpp"
 #include "Beam/QueriesTests/TestEntry.hpp"
@@ -16,6 +17,18 @@ namespace {
     BasicQuery<std::string>, TestEntry, EvaluatorTranslator<QueryTypes>>;
   using DataStore =
     CachedDataStore<BaseDataStore*, EvaluatorTranslator<QueryTypes>>;
+
+  void load_blocks(DataStore& data_store, const std::string& index,
+      std::uint64_t last) {
+    for(auto ordinal = std::uint64_t(0); ordinal <= last; ordinal += 10) {
+      auto query = BasicQuery<std::string>();
+      query.set_index(index);
+      query.set_range(
+        Beam::Sequence(ordinal), Beam::Sequence(ordinal + 9));
+      query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+      data_store.load(query);
+    }
+  }
 }
 
 TEST_SUITE("CachedDataStore") {
@@ -175,4 +188,151 @@ TEST_SUITE("CachedDataStore") {
       REQUIRE(result.back().get_sequence().get_ordinal() == 105);
     }
   }
+
+  TEST_CASE("batch_load") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, 10);
+    auto sequence = Beam::Sequence(5);
+    auto entry_a = store(data_store, "hello", 100,
+      time_from_string("2016-07-30 04:12:55:15"), sequence);
+    sequence = increment(sequence);
+    auto entry_b = store(data_store, "world", 200,
+      time_from_string("2016-07-30 04:12:55:16"), sequence);
+    auto queries = std::vector<BasicQuery<std::string>>();
+    for(auto index : {"world", "goodbye", "hello"}) {
+      auto& query = queries.emplace_back();
+      query.set_index(index);
+      query.set_range(Beam::Range::TOTAL);
+      query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    }
+    auto results = data_store.load(queries);
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0] == std::vector<SequencedTestEntry>{entry_b});
+    REQUIRE(results[1].empty());
+    REQUIRE(results[2] == std::vector<SequencedTestEntry>{entry_a});
+  }
+
+  TEST_CASE("memory_budget") {
+    auto base_data_store = BaseDataStore();
+    auto capacity = std::size_t(4096);
+    auto data_store = DataStore(&base_data_store, 10, capacity);
+    auto timestamp = time_from_string("2016-07-30 04:12:55:00");
+    auto entries = std::vector<SequencedTestEntry>();
+    for(auto i = 0; i != 100; ++i) {
+      auto index = i % 2 == 0 ? std::string("hello") : std::string("goodbye");
+      auto entry = store(data_store, index, i, timestamp + seconds(i),
+        Beam::Sequence(i + 1));
+      if(index == "hello") {
+        entries.push_back(entry);
+      }
+    }
+    load_blocks(data_store, "hello", 100);
+    load_blocks(data_store, "goodbye", 100);
+    auto statistics = data_store.get_statistics();
+    REQUIRE(statistics.m_capacity == capacity);
+    REQUIRE(statistics.m_size <= capacity);
+    REQUIRE(statistics.m_evictions > 0);
+    test_query(data_store, "hello", Beam::Range::TOTAL,
+      SnapshotLimit::UNLIMITED, entries);
+    test_query(data_store, "hello", Beam::Range::TOTAL,
+      SnapshotLimit::from_tail(3), {entries[47], entries[48], entries[49]});
+    test_query(data_store, "hello", Beam::Range::TOTAL,
+      SnapshotLimit::from_tail(3), {entries[47], entries[48], entries[49]});
+    statistics = data_store.get_statistics();
+    REQUIRE(statistics.m_size <= capacity);
+    REQUIRE(statistics.m_hits > 0);
+    REQUIRE(statistics.m_misses > 0);
+  }
+
+  TEST_CASE("unlimited_budget") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, 10);
+    auto timestamp = time_from_string("2016-07-30 04:12:55:00");
+    for(auto i = 0; i != 100; ++i) {
+      store(data_store, "hello", i, timestamp + seconds(i),
+        Beam::Sequence(i + 1));
+    }
+    auto statistics = data_store.get_statistics();
+    REQUIRE(statistics.m_capacity == CacheBudget::UNLIMITED);
+    REQUIRE(statistics.m_block_count == 0);
+    load_blocks(data_store, "hello", 100);
+    statistics = data_store.get_statistics();
+    REQUIRE(statistics.m_evictions == 0);
+    REQUIRE(statistics.m_block_count == 11);
+  }
+
+  TEST_CASE("store_into_cached_block") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, 10, CacheBudget::UNLIMITED);
+    auto timestamp = time_from_string("2016-07-30 04:12:55:00");
+    auto entry_a =
+      store(data_store, "hello", 1, timestamp, Beam::Sequence(1));
+    load_blocks(data_store, "hello", 0);
+    auto size = data_store.get_statistics().m_size;
+    auto entry_b = store(
+      data_store, "hello", 2, timestamp + seconds(1), Beam::Sequence(2));
+    auto statistics = data_store.get_statistics();
+    REQUIRE(statistics.m_block_count == 1);
+    REQUIRE(statistics.m_size > size);
+    auto misses = statistics.m_misses;
+    test_query(data_store, "hello",
+      Beam::Range(Beam::Sequence(0), Beam::Sequence(9)),
+      SnapshotLimit::UNLIMITED, {entry_a, entry_b});
+    REQUIRE(data_store.get_statistics().m_misses == misses);
+  }
+
+  TEST_CASE("heap_size_estimator") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, 10, CacheBudget::UNLIMITED,
+      [] (const TestEntry&) {
+        return std::size_t(1000);
+      });
+    auto timestamp = time_from_string("2016-07-30 04:12:55:00");
+    for(auto i = 0; i != 10; ++i) {
+      store(data_store, "hello", i, timestamp + seconds(i),
+        Beam::Sequence(i + 1));
+    }
+    load_blocks(data_store, "hello", 10);
+    REQUIRE(data_store.get_statistics().m_size >= 10 * 1000);
+  }
+
+  TEST_CASE("heap_size_of_replaced_value") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, 10, CacheBudget::UNLIMITED,
+      [] (const TestEntry&) {
+        return std::size_t(1000);
+      });
+    auto timestamp = time_from_string("2016-07-30 04:12:55:00");
+    store(data_store, "hello", 0, timestamp, Beam::Sequence(1));
+    load_blocks(data_store, "hello", 0);
+    auto size = data_store.get_statistics().m_size;
+    for(auto i = 1; i != 100; ++i) {
+      store(data_store, "hello", i, timestamp + seconds(i), Beam::Sequence(1));
+    }
+    REQUIRE(data_store.get_statistics().m_size == size);
+  }
+
+  TEST_CASE("entry_outlived_by_budget") {
+    auto base_data_store = BaseDataStore();
+    auto budget = CacheBudget(CacheBudget::UNLIMITED);
+    auto timestamp = time_from_string("2016-07-30 04:12:55:00");
+    for(auto i = 0; i != 20; ++i) {
+      base_data_store.store(SequencedValue(IndexedValue(
+        TestEntry(i, timestamp + seconds(i)), std::string("hello")),
+        Beam::Sequence(i + 1)));
+    }
+    {
+      auto entry = CachedDataStoreEntry<BaseDataStore*>(
+        &base_data_store, "hello", 10, Ref(budget));
+      auto query = BasicQuery<std::string>();
+      query.set_index("hello");
+      query.set_range(Beam::Sequence(0), Beam::Sequence(9));
+      query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+      entry.load(query);
+      REQUIRE(budget.get_statistics().m_block_count == 1);
+    }
+    auto statistics = budget.get_statistics();
+    REQUIRE(statistics.m_block_count == 0);
+    REQUIRE(statistics.m_size == 0);
+  }
 }
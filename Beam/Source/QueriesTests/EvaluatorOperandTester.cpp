@@ -0,0 +1,62 @@
+#include <doctest/doctest.h>
+#include "Beam/Queries/EvaluatorOperand.hpp"
+#include "Beam/Queries/FunctionEvaluatorNode.hpp"
+
+using namespace Beam;
+
+namespace {
+  struct Increment {
+    int operator ()(int value) const {
+      return value + 1;
+    }
+  };
+}
+
+TEST_SUITE("EvaluatorOperand") {
+  TEST_CASE("constant") {
+    auto operand = EvaluatorOperand<int>(
+      std::make_unique<ConstantEvaluatorNode<int>>(123));
+    REQUIRE(operand.is_constant());
+    REQUIRE(operand.get_address());
+    REQUIRE(*operand.get_address() == 123);
+    REQUIRE(operand.eval() == 123);
+  }
+
+  TEST_CASE("parameter") {
+    auto parameter = std::make_unique<ParameterEvaluatorNode<int>>(0);
+    auto value = 123;
+    auto value_pointer = static_cast<const void*>(&value);
+    parameter->set_parameter(&value_pointer);
+    auto operand = EvaluatorOperand<int>(std::move(parameter));
+    REQUIRE(!operand.is_constant());
+    REQUIRE(operand.get_address() == &value);
+    REQUIRE(operand.eval() == 123);
+    auto next_value = 321;
+    value_pointer = &next_value;
+    REQUIRE(operand.get_address() == &next_value);
+    REQUIRE(operand.eval() == 321);
+  }
+
+  TEST_CASE("node") {
+    auto operand = EvaluatorOperand<int>(make_function_evaluator_node(
+      Increment(), std::make_unique<ConstantEvaluatorNode<int>>(1)));
+    REQUIRE(!operand.is_constant());
+    REQUIRE(!operand.get_address());
+    REQUIRE(operand.eval() == 2);
+  }
+
+  TEST_CASE("fold_constant") {
+    auto constant = fold_constant(make_function_evaluator_node(
+      Increment(), std::make_unique<ConstantEvaluatorNode<int>>(1)));
+    REQUIRE(dynamic_cast<ConstantEvaluatorNode<int>*>(constant.get()));
+    REQUIRE(constant->eval() == 2);
+    auto parameter = std::make_unique<ParameterEvaluatorNode<int>>(0);
+    auto value = 5;
+    auto value_pointer = static_cast<const void*>(&value);
+    parameter->set_parameter(&value_pointer);
+    auto function = fold_constant(
+      make_function_evaluator_node(Increment(), std::move(parameter)));
+    REQUIRE(!dynamic_cast<ConstantEvaluatorNode<int>*>(function.get()));
+    REQUIRE(function->eval() == 6);
+  }
+}
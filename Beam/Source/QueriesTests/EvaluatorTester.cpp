@@ -1,3 +1,7 @@
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
 #include <doctest/doctest.h>
 #include "Beam/Queries/Evaluator.hpp"
 
@@ -174,6 +178,87 @@ TEST_SUITE("Evaluator") {
     REQUIRE(evaluator->eval<bool>(true, true));
   }
 
+  TEST_CASE("constant_folding") {
+    auto expression = ParameterExpression(0, typeid(int)) * 2 >
+      ConstantExpression(10) + ConstantExpression(5) &&
+        !(ConstantExpression(1) == ConstantExpression(2));
+    auto evaluator = translate(expression);
+    REQUIRE(!evaluator->eval<bool>(7));
+    REQUIRE(evaluator->eval<bool>(8));
+    auto constant = translate(!(ConstantExpression(3) <
+      max(ConstantExpression(1), ConstantExpression(2))));
+    REQUIRE(constant->eval<bool>());
+  }
+
+  TEST_CASE("constant_operand_folding") {
+    auto parameter = ParameterExpression(0, typeid(bool));
+    auto and_true = translate(parameter && ConstantExpression(true));
+    REQUIRE(and_true->eval<bool>(true));
+    REQUIRE(!and_true->eval<bool>(false));
+    auto or_false = translate(ConstantExpression(false) || parameter);
+    REQUIRE(or_false->eval<bool>(true));
+    REQUIRE(!or_false->eval<bool>(false));
+    auto and_false = translate(parameter && ConstantExpression(false));
+    REQUIRE(!and_false->eval<bool>(true));
+    REQUIRE_THROWS_AS(
+      and_false->eval<bool>(std::string("a")), TypeCompatibilityException);
+    auto or_true = translate(parameter || ConstantExpression(true));
+    REQUIRE(or_true->eval<bool>(false));
+    auto constant = translate(ConstantExpression(true) &&
+      (ConstantExpression(1) < ConstantExpression(2) || parameter == true));
+    REQUIRE(constant->eval<bool>(false));
+    auto variable = translate(GlobalVariableDeclarationExpression("x",
+      ConstantExpression(true),
+      VariableExpression("x", typeid(bool)) || ConstantExpression(true)));
+    REQUIRE(variable->eval<bool>());
+  }
+
+  TEST_CASE("select") {
+    auto evaluator = translate(ParameterExpression(0, typeid(int)) * 2 >
+      ConstantExpression(10) || ParameterExpression(0, typeid(int)) == 1);
+    auto values = std::vector<int>();
+    for(auto i = 0; i != 1000; ++i) {
+      values.push_back(i % 9);
+    }
+    auto selection = std::array<bool, 1000>();
+    evaluator->select(values, selection);
+    for(auto i = std::size_t(0); i != values.size(); ++i) {
+      REQUIRE(selection[i] == evaluator->eval<bool>(values[i]));
+    }
+  }
+
+  TEST_CASE("select_short_circuit") {
+    auto parameter = ParameterExpression(0, typeid(int));
+    auto evaluator = translate(parameter != 0 &&
+      ConstantExpression(10) / parameter > ConstantExpression(1));
+    auto values = std::vector<int>{0, 1, 20, 0, 5, 10, 0};
+    auto selection = std::array<bool, 7>();
+    evaluator->select(values, selection);
+    REQUIRE(selection ==
+      std::array<bool, 7>{false, true, false, false, true, false, false});
+  }
+
+  TEST_CASE("select_projection") {
+    auto evaluator = translate(
+      ParameterExpression(0, typeid(std::string)) == std::string("b"));
+    auto values = std::vector<std::pair<int, std::string>>{
+      {1, "a"}, {2, "b"}, {3, "c"}, {4, "b"}};
+    auto selection = std::array<bool, 4>();
+    evaluator->select(values, selection, &std::pair<int, std::string>::second);
+    REQUIRE(selection == std::array<bool, 4>{false, true, false, true});
+  }
+
+  TEST_CASE("select_unbatchable") {
+    auto sum =
+      ParameterExpression(0, typeid(int)) + ParameterExpression(1, typeid(int));
+    auto evaluator = translate(ReduceExpression(
+      sum, ParameterExpression(0, typeid(int)), Value(0)) > 3);
+    auto values = std::vector<int>{1, 1, 1, 1, 1};
+    auto selection = std::array<bool, 5>();
+    evaluator->select(values, selection);
+    REQUIRE(selection == std::array<bool, 5>{false, false, false, true, true});
+  }
+
   TEST_CASE("reduce_expression") {
     auto sum =
       ParameterExpression(0, typeid(int)) + ParameterExpression(1, typeid(int));
@@ -0,0 +1,35 @@
+#include <doctest/doctest.h>
+#include "Beam/Queries/ExpressionSignature.hpp"
+#include "Beam/Queries/StandardFunctionExpressions.hpp"
+
+using namespace Beam;
+
+namespace {
+  auto parameter() {
+    return ParameterExpression(0, typeid(int));
+  }
+}
+
+TEST_SUITE("ExpressionSignature") {
+  TEST_CASE("equal_structure") {
+    auto a = ExpressionSignature(parameter() > 5 && parameter() < 10);
+    auto b = ExpressionSignature(parameter() > 5 && parameter() < 10);
+    REQUIRE(a.is_comparable());
+    REQUIRE(a == b);
+    REQUIRE(a.get_hash() == b.get_hash());
+  }
+
+  TEST_CASE("different_structure") {
+    auto signature = ExpressionSignature(parameter() > 5);
+    REQUIRE(signature != ExpressionSignature(parameter() > 6));
+    REQUIRE(signature != ExpressionSignature(parameter() >= 5));
+    REQUIRE(signature != ExpressionSignature(
+      ParameterExpression(1, typeid(int)) > 5));
+    REQUIRE(signature != ExpressionSignature(
+      parameter() > ConstantExpression(5.0)));
+    REQUIRE(signature !=
+      ExpressionSignature(parameter() > 5 || ConstantExpression(true)));
+    REQUIRE(ExpressionSignature(ConstantExpression(1.0000001)) !=
+      ExpressionSignature(ConstantExpression(1.0000002)));
+  }
+}
@@ -136,4 +136,49 @@ TEST_SUITE("LocalDataStore") {
     REQUIRE(special_entries[1]->m_value == 5);
     REQUIRE(special_entries[2]->m_value == 9);
   }
+
+  TEST_CASE("ranged_load") {
+    auto data_store = DataStore();
+    auto timestamp = time_from_string("2024-05-06 13:21:53:00");
+    auto entries = std::vector<SequencedIndexedTestEntry>();
+    for(auto i = 1; i <= 10; ++i) {
+      entries.push_back(store(data_store, "hello", i, timestamp + seconds(i),
+        Beam::Sequence(2 * i)));
+    }
+    test_query(data_store, "hello", Range(Beam::Sequence(5), Beam::Sequence(9)),
+      SnapshotLimit::UNLIMITED, {entries[2], entries[3]});
+    test_query(data_store, "hello",
+      Range(timestamp + seconds(3), timestamp + seconds(6)),
+      SnapshotLimit::from_tail(2), {entries[4], entries[5]});
+    test_query(data_store, "hello",
+      Range(timestamp + seconds(3), Beam::Sequence(12)),
+      SnapshotLimit::from_head(2), {entries[2], entries[3]});
+    test_query(data_store, "hello",
+      Range(Beam::Sequence(21), Beam::Sequence::LAST),
+      SnapshotLimit::UNLIMITED, {});
+  }
+
+  TEST_CASE("ranged_load_unordered_timestamps") {
+    auto data_store = DataStore();
+    auto timestamp = time_from_string("2024-05-06 13:21:53:00");
+    auto entry_a = store(data_store, "hello", 1, timestamp + seconds(1),
+      Beam::Sequence(1));
+    auto entry_b = store(data_store, "hello", 2, timestamp + seconds(5),
+      Beam::Sequence(2));
+    auto entry_c = store(data_store, "hello", 3, timestamp + seconds(2),
+      Beam::Sequence(3));
+    auto entry_d = store(data_store, "hello", 4, timestamp + seconds(6),
+      Beam::Sequence(4));
+    auto range = Range(timestamp + seconds(1), timestamp + seconds(3));
+    test_query(
+      data_store, "hello", range, SnapshotLimit::UNLIMITED, {entry_a, entry_c});
+    test_query(
+      data_store, "hello", range, SnapshotLimit::from_tail(1), {entry_c});
+    entry_c = store(data_store, "hello", 3, timestamp + seconds(5),
+      Beam::Sequence(3));
+    test_query(data_store, "hello",
+      Range(timestamp + seconds(4), timestamp + seconds(6)),
+      SnapshotLimit::UNLIMITED, {entry_b, entry_c, entry_d});
+    test_query(data_store, "hello", range, SnapshotLimit::UNLIMITED, {entry_a});
+  }
 }
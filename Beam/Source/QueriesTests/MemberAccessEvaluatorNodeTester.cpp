@@ -1,6 +1,8 @@
+#include <array>
 #include <doctest/doctest.h>
 #include "Beam/Queries/ConstantEvaluatorNode.hpp"
 #include "Beam/Queries/MemberAccessEvaluatorNode.hpp"
+#include "Beam/Queries/ParameterEvaluatorNode.hpp"
 
 using namespace Beam;
 
@@ -9,6 +11,21 @@ namespace {
     int x;
     double y;
   };
+
+  struct CopyCounter {
+    int m_value;
+    int* m_copies;
+
+    CopyCounter(int value, int* copies)
+      : m_value(value),
+        m_copies(copies) {}
+
+    CopyCounter(const CopyCounter& counter)
+        : m_value(counter.m_value),
+          m_copies(counter.m_copies) {
+      ++*m_copies;
+    }
+  };
 }
 
 TEST_SUITE("MemberAccessEvaluatorNode") {
@@ -24,4 +41,37 @@ TEST_SUITE("MemberAccessEvaluatorNode") {
       std::move(point_y_evaluator), &Point::y);
     REQUIRE(access_point_y.eval() == 3.14);
   }
+
+  TEST_CASE("parameter_access_without_copy") {
+    auto copies = 0;
+    auto counter = CopyCounter(123, &copies);
+    auto counter_pointer = static_cast<const void*>(&counter);
+    auto parameter = std::make_unique<ParameterEvaluatorNode<CopyCounter>>(0);
+    parameter->set_parameter(&counter_pointer);
+    auto access = MemberAccessEvaluatorNode<CopyCounter, int>(
+      std::move(parameter), &CopyCounter::m_value);
+    REQUIRE(!access.is_constant());
+    REQUIRE(access.eval() == 123);
+    counter.m_value = 321;
+    REQUIRE(access.eval() == 321);
+    REQUIRE(copies == 0);
+  }
+
+  TEST_CASE("eval_batch") {
+    auto copies = 0;
+    auto counters = std::array{CopyCounter(1, &copies),
+      CopyCounter(2, &copies), CopyCounter(3, &copies)};
+    auto parameters = std::array<const void*, 3>();
+    for(auto i = std::size_t(0); i != counters.size(); ++i) {
+      parameters[i] = &counters[i];
+    }
+    auto access = MemberAccessEvaluatorNode<CopyCounter, int>(
+      std::make_unique<ParameterEvaluatorNode<CopyCounter>>(0),
+      &CopyCounter::m_value);
+    auto results = std::array<int, 3>();
+    REQUIRE(access.eval_batch(
+      EvaluatorBatch(parameters.data(), parameters.size(), 1), results));
+    REQUIRE(results == std::array{1, 2, 3});
+    REQUIRE(copies == 0);
+  }
 }
@@ -0,0 +1,110 @@
+#include <doctest/doctest.h>
+#include "Beam/Queries/PredicateIndex.hpp"
+#include "Beam/QueriesTests/TestEntry.hpp"
+
+using namespace Beam;
+using namespace Beam::Tests;
+using namespace boost::posix_time;
+
+namespace {
+  using TestPredicateIndex = PredicateIndex<TestEntry, TestQueryTypes>;
+
+  auto make_index() {
+    return std::make_unique<TestPredicateIndex>([] (const auto& expression) {
+      return translate<TestTranslator>(expression);
+    });
+  }
+
+  auto value() {
+    return MemberAccessExpression(
+      "value", typeid(int), ParameterExpression(0, typeid(TestEntry)));
+  }
+
+  auto entry(int value) {
+    return TestEntry(value, time_from_string("2024-05-06 13:21:53:06"));
+  }
+}
+
+TEST_SUITE("PredicateIndex") {
+  TEST_CASE("constant") {
+    auto index = make_index();
+    auto always = index->add(ConstantExpression(true));
+    auto never = index->add(ConstantExpression(false));
+    REQUIRE(index->add(ConstantExpression(true)) == always);
+    REQUIRE(!index->is_match(always));
+    index->test(entry(1));
+    REQUIRE(index->is_match(always));
+    REQUIRE(!index->is_match(never));
+  }
+
+  TEST_CASE("equality") {
+    auto index = make_index();
+    auto five = index->add(value() == 5);
+    REQUIRE(index->add(value() == 5) == five);
+    REQUIRE(index->add(ConstantExpression(5) == value()) == five);
+    auto six = index->add(value() == 6);
+    REQUIRE(six != five);
+    index->test(entry(5));
+    REQUIRE(index->is_match(five));
+    REQUIRE(!index->is_match(six));
+    index->test(entry(6));
+    REQUIRE(!index->is_match(five));
+    REQUIRE(index->is_match(six));
+    index->test(entry(7));
+    REQUIRE(!index->is_match(five));
+    REQUIRE(!index->is_match(six));
+  }
+
+  TEST_CASE("range") {
+    auto index = make_index();
+    auto greater = index->add(value() > 3);
+    REQUIRE(index->add(ConstantExpression(3) < value()) == greater);
+    auto greater_equals = index->add(value() >= 3);
+    auto less_equals = index->add(value() <= 3);
+    auto between = index->add(value() >= 2 && value() < 5);
+    REQUIRE(index->add(value() < 5 && value() >= 2) == between);
+    auto expected = [&] (int value, bool is_greater, bool is_greater_equals,
+        bool is_less_equals, bool is_between) {
+      index->test(entry(value));
+      REQUIRE(index->is_match(greater) == is_greater);
+      REQUIRE(index->is_match(greater_equals) == is_greater_equals);
+      REQUIRE(index->is_match(less_equals) == is_less_equals);
+      REQUIRE(index->is_match(between) == is_between);
+    };
+    expected(1, false, false, true, false);
+    expected(2, false, false, true, true);
+    expected(3, false, true, true, true);
+    expected(4, true, true, false, true);
+    expected(5, true, true, false, false);
+  }
+
+  TEST_CASE("general_filter") {
+    auto index = make_index();
+    auto not_equals = index->add(value() != 3);
+    REQUIRE(index->add(value() != 3) != not_equals);
+    auto computed = index->add(value() + 1 == 4);
+    index->test(entry(3));
+    REQUIRE(!index->is_match(not_equals));
+    REQUIRE(index->is_match(computed));
+    index->test(entry(4));
+    REQUIRE(index->is_match(not_equals));
+    REQUIRE(!index->is_match(computed));
+  }
+
+  TEST_CASE("remove") {
+    auto index = make_index();
+    auto five = index->add(value() == 5);
+    REQUIRE(index->add(value() == 5) == five);
+    auto greater = index->add(value() > 3);
+    index->remove(five);
+    index->test(entry(5));
+    REQUIRE(index->is_match(five));
+    index->remove(five);
+    index->remove(greater);
+    auto six = index->add(value() == 6);
+    index->test(entry(6));
+    REQUIRE(index->is_match(six));
+    index->test(entry(5));
+    REQUIRE(!index->is_match(six));
+  }
+}
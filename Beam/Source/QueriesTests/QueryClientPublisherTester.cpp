@@ -54,6 +54,9 @@ namespace {
     TestQueryClientPublisher m_publisher;
 
     Fixture()
+      : Fixture(std::numeric_limits<int>::max()) {}
+
+    explicit Fixture(int page_size)
       : m_channel_id(1),
         m_accept_routine(spawn([&] {
           m_server_client.emplace(m_server.accept(), init());
@@ -71,7 +74,7 @@ namespace {
           [] {
             return std::make_unique<TriggerTimer>();
           })),
-        m_publisher(Ref(m_client_handler)) {
+        m_publisher(Ref(m_client_handler), page_size) {
       register_query_types(
         out(m_client_handler.get_slots().get_registry()));
       register_test_query_services(out(m_client_handler.get_slots()));
@@ -79,6 +82,26 @@ namespace {
       m_accept_routine.wait();
     }
   };
+
+  auto make_paged_query_slot(std::vector<TestQuery>& queries) {
+    return [&] (auto& protocol_client, const TestQuery& query) {
+      queries.push_back(query);
+      auto result = QueryResult<SequencedTestEntry>();
+      if(query.get_range().get_end() == Beam::Sequence::LAST) {
+        result.m_id = 1;
+      }
+      auto start = boost::get<Beam::Sequence>(query.get_range().get_start());
+      for(auto i = 1; i <= 5; ++i) {
+        auto sequence = Beam::Sequence(i);
+        if(sequence >= start && static_cast<int>(result.m_snapshot.size()) <
+            query.get_snapshot_limit().get_size()) {
+          result.m_snapshot.push_back(SequencedValue(TestEntry(
+            100 * i, time_from_string("2024-01-15 10:30:00")), sequence));
+        }
+      }
+      return result;
+    };
+  }
 }
 
 TEST_SUITE("QueryClientPublisher") {
@@ -134,6 +157,108 @@ TEST_SUITE("QueryClientPublisher") {
     REQUIRE_THROWS_AS(queue->pop(), PipeBrokenException);
   }
 
+  TEST_CASE("submit_paged_realtime_query") {
+    auto fixture = Fixture(2);
+    auto queries = std::vector<TestQuery>();
+    auto& client = *fixture.m_server_client;
+    QueryService::add_slot(
+      out(client.get_slots()), make_paged_query_slot(queries));
+    client.spawn_message_handler();
+    auto query = TestQuery();
+    query.set_index("IndexA");
+    query.set_range(Range::TOTAL);
+    query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    auto queue = std::make_shared<Queue<SequencedTestEntry>>();
+    fixture.m_publisher.submit(query, queue);
+    for(auto i = 1; i <= 5; ++i) {
+      auto value = queue->pop();
+      REQUIRE(value.get_value().m_value == 100 * i);
+      REQUIRE(value.get_sequence() == Beam::Sequence(i));
+    }
+    fixture.m_publisher.publish(SequencedValue(IndexedValue(
+      TestEntry(600, time_from_string("2024-01-15 10:30:01")),
+      std::string("IndexA")), Beam::Sequence(6)));
+    REQUIRE(queue->pop().get_value().m_value == 600);
+    REQUIRE(queries.size() == 4);
+    for(auto i = 0; i != 3; ++i) {
+      REQUIRE(queries[i].get_range().get_end() == Beam::Sequence::PRESENT);
+      REQUIRE(queries[i].get_snapshot_limit() == SnapshotLimit::from_head(2));
+    }
+    REQUIRE(queries[3].get_range() ==
+      Range(Beam::Sequence(6), Beam::Sequence::LAST));
+    REQUIRE(queries[3].get_snapshot_limit() == SnapshotLimit::UNLIMITED);
+  }
+
+  TEST_CASE("submit_paged_limited_realtime_query") {
+    auto fixture = Fixture(2);
+    auto queries = std::vector<TestQuery>();
+    auto count = 5;
+    auto& client = *fixture.m_server_client;
+    QueryService::add_slot(out(client.get_slots()),
+      [&] (auto& protocol_client, const TestQuery& query) {
+        queries.push_back(query);
+        auto result = QueryResult<SequencedTestEntry>();
+        if(query.get_range().get_end() == Beam::Sequence::LAST) {
+          result.m_id = 1;
+        }
+        auto start = boost::get<Beam::Sequence>(query.get_range().get_start());
+        for(auto i = 1; i <= count; ++i) {
+          auto sequence = Beam::Sequence(i);
+          if(sequence >= start && static_cast<int>(result.m_snapshot.size()) <
+              query.get_snapshot_limit().get_size()) {
+            result.m_snapshot.push_back(SequencedValue(TestEntry(
+              100 * i, time_from_string("2024-01-15 10:30:00")), sequence));
+          }
+        }
+        if(static_cast<int>(result.m_snapshot.size()) <
+            query.get_snapshot_limit().get_size()) {
+          count = 20;
+        }
+        return result;
+      });
+    client.spawn_message_handler();
+    auto query = TestQuery();
+    query.set_index("IndexA");
+    query.set_range(Range::TOTAL);
+    query.set_snapshot_limit(SnapshotLimit::from_head(10));
+    auto queue = std::make_shared<Queue<SequencedTestEntry>>();
+    fixture.m_publisher.submit(query, queue);
+    for(auto i = 1; i <= 10; ++i) {
+      REQUIRE(queue->pop().get_sequence() == Beam::Sequence(i));
+    }
+    fixture.m_publisher.publish(SequencedValue(IndexedValue(
+      TestEntry(2100, time_from_string("2024-01-15 10:30:01")),
+      std::string("IndexA")), Beam::Sequence(21)));
+    REQUIRE(queue->pop().get_sequence() == Beam::Sequence(21));
+    REQUIRE(queries.size() == 4);
+    REQUIRE(queries[3].get_range() ==
+      Range(Beam::Sequence(6), Beam::Sequence::LAST));
+    REQUIRE(queries[3].get_snapshot_limit() == SnapshotLimit::from_head(5));
+  }
+
+  TEST_CASE("submit_paged_historical_query") {
+    auto fixture = Fixture(2);
+    auto queries = std::vector<TestQuery>();
+    auto& client = *fixture.m_server_client;
+    QueryService::add_slot(
+      out(client.get_slots()), make_paged_query_slot(queries));
+    client.spawn_message_handler();
+    auto query = TestQuery();
+    query.set_index("IndexA");
+    query.set_range(Range(Beam::Sequence(1), Beam::Sequence(10)));
+    query.set_snapshot_limit(SnapshotLimit::from_head(3));
+    auto queue = std::make_shared<Queue<SequencedTestEntry>>();
+    fixture.m_publisher.submit(query, queue);
+    for(auto i = 1; i <= 3; ++i) {
+      REQUIRE(queue->pop().get_sequence() == Beam::Sequence(i));
+    }
+    REQUIRE_THROWS_AS(queue->pop(), PipeBrokenException);
+    REQUIRE(queries.size() == 2);
+    REQUIRE(queries[1].get_range() ==
+      Range(Beam::Sequence(3), Beam::Sequence(10)));
+    REQUIRE(queries[1].get_snapshot_limit() == SnapshotLimit::from_head(1));
+  }
+
   TEST_CASE("submit_with_value_queue") {
     auto fixture = Fixture();
     auto& client = *fixture.m_server_client;
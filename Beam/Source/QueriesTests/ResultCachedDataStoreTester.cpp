@@ -0,0 +1,200 @@
+#include <memory>
+#include <doctest/doctest.h>
+#include "Beam/Queries/BasicQuery.hpp"
+#include "Beam/Queries/LocalDataStore.hpp"
+#include "Beam/Queries/ResultCachedDataStore.hpp"
+#include "Beam/Queues/PipeBrokenException.hpp"
+#include "Beam/Queues/Queue.hpp"
+#include "Beam/QueriesTests/TestDataStore.hpp"
+#include "Beam/QueriesTests/TestEntry.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+
+using namespace Beam;
+using namespace Beam::Tests;
+using namespace boost;
+using namespace boost::posix_time;
+
+namespace {
+  using BaseDataStore =
+    LocalDataStore<BasicQuery<std::string>, TestEntry, TestTranslator>;
+  using DataStore = ResultCachedDataStore<BaseDataStore*, TestTranslator>;
+  using DataStoreDispatcher = TestDataStore<BasicQuery<std::string>, TestEntry>;
+  using IntrusiveDataStore = ResultCachedDataStore<
+    std::shared_ptr<DataStoreDispatcher>, TestTranslator>;
+
+  auto value() {
+    return MemberAccessExpression(
+      "value", typeid(int), ParameterExpression(0, typeid(TestEntry)));
+  }
+
+  auto make_query(const SnapshotLimit& limit, const Expression& filter) {
+    auto query = BasicQuery<std::string>();
+    query.set_index("hello");
+    query.set_range(Beam::Range::TOTAL);
+    query.set_snapshot_limit(limit);
+    query.set_filter(filter);
+    return query;
+  }
+
+  auto timestamp(int offset) {
+    return time_from_string("2016-07-30 04:12:55:15") + seconds(offset);
+  }
+}
+
+TEST_SUITE("ResultCachedDataStore") {
+  TEST_CASE("hit") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, CacheBudget::UNLIMITED);
+    auto entry_a = store(
+      base_data_store, "hello", 100, timestamp(0), Beam::Sequence(1));
+    auto entry_b = store(
+      base_data_store, "hello", 200, timestamp(1), Beam::Sequence(2));
+    auto query = make_query(SnapshotLimit::UNLIMITED, value() > 150);
+    auto expected = std::vector<SequencedTestEntry>{entry_b};
+    REQUIRE(data_store.load(query) == expected);
+    REQUIRE(data_store.get_statistics().m_misses == 1);
+    REQUIRE(data_store.load(
+      make_query(SnapshotLimit::UNLIMITED, value() > 150)) == expected);
+    REQUIRE(data_store.get_statistics().m_hits == 1);
+    REQUIRE(data_store.load(
+      make_query(SnapshotLimit::UNLIMITED, value() > 50)).size() == 2);
+    REQUIRE(data_store.get_statistics().m_misses == 2);
+  }
+
+  TEST_CASE("store_patches_results") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, CacheBudget::UNLIMITED);
+    auto entry_a =
+      store(data_store, "hello", 100, timestamp(0), Beam::Sequence(1));
+    auto entry_b =
+      store(data_store, "hello", 200, timestamp(1), Beam::Sequence(2));
+    auto head = make_query(
+      SnapshotLimit::from_head(3), ConstantExpression(true));
+    auto tail = make_query(
+      SnapshotLimit::from_tail(2), ConstantExpression(true));
+    auto filtered = make_query(SnapshotLimit::UNLIMITED, value() > 250);
+    REQUIRE(data_store.load(head).size() == 2);
+    REQUIRE(data_store.load(tail).size() == 2);
+    REQUIRE(data_store.load(filtered).empty());
+    auto entry_c =
+      store(data_store, "hello", 300, timestamp(2), Beam::Sequence(3));
+    auto entry_d =
+      store(data_store, "hello", 400, timestamp(3), Beam::Sequence(4));
+    REQUIRE(data_store.load(head) ==
+      std::vector<SequencedTestEntry>{entry_a, entry_b, entry_c});
+    REQUIRE(data_store.load(tail) ==
+      std::vector<SequencedTestEntry>{entry_c, entry_d});
+    REQUIRE(data_store.load(filtered) ==
+      std::vector<SequencedTestEntry>{entry_c, entry_d});
+    REQUIRE(data_store.get_statistics().m_hits == 3);
+    REQUIRE(data_store.get_statistics().m_misses == 3);
+  }
+
+  TEST_CASE("store_discards_results") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, CacheBudget::UNLIMITED);
+    store(data_store, "hello", 100, timestamp(0), Beam::Sequence(1));
+    store(data_store, "hello", 200, timestamp(1), Beam::Sequence(2));
+    auto query = make_query(SnapshotLimit::UNLIMITED, ConstantExpression(true));
+    REQUIRE(data_store.load(query).size() == 2);
+    auto entry =
+      store(data_store, "hello", 150, timestamp(1), Beam::Sequence(2));
+    auto result = data_store.load(query);
+    REQUIRE(result.size() == 2);
+    REQUIRE(result.back() == SequencedTestEntry(entry));
+    REQUIRE(data_store.get_statistics().m_hits == 0);
+    REQUIRE(data_store.get_statistics().m_misses == 2);
+  }
+
+  TEST_CASE("capacity") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, 1024);
+    for(auto i = 0; i != 20; ++i) {
+      store(data_store, "hello", i, timestamp(i), Beam::Sequence(i + 1));
+    }
+    for(auto i = 0; i != 20; ++i) {
+      REQUIRE(data_store.load(make_query(
+        SnapshotLimit::UNLIMITED, value() >= i)).size() == 20 - i);
+    }
+    auto statistics = data_store.get_statistics();
+    REQUIRE(statistics.m_evictions > 0);
+    REQUIRE(statistics.m_size <= statistics.m_capacity);
+  }
+
+  TEST_CASE("heap_size_estimator") {
+    auto base_data_store = BaseDataStore();
+    auto data_store = DataStore(&base_data_store, CacheBudget::UNLIMITED,
+      [] (const TestEntry&) {
+        return std::size_t(1000);
+      });
+    for(auto i = 0; i != 10; ++i) {
+      store(data_store, "hello", i, timestamp(i), Beam::Sequence(i + 1));
+    }
+    data_store.load(make_query(SnapshotLimit::from_tail(5), value() >= 0));
+    auto size = data_store.get_statistics().m_size;
+    REQUIRE(size >= 5 * 1000);
+    store(data_store, "hello", 10, timestamp(10), Beam::Sequence(11));
+    REQUIRE(data_store.get_statistics().m_size == size);
+  }
+
+  TEST_CASE("concurrent_misses") {
+    auto entry = SequencedTestEntry(
+      TestEntry(100, timestamp(0)), Beam::Sequence(1));
+    auto resolve = [&] (auto& operation) {
+      std::get<DataStoreDispatcher::LoadOperation>(*operation).m_result.set(
+        std::vector<SequencedTestEntry>{entry});
+    };
+    auto load_values = [&] (auto& operations) {
+      auto operation = operations.pop();
+      resolve(operation);
+    };
+    auto capacity = [&] {
+      auto dispatcher = std::make_shared<DataStoreDispatcher>();
+      auto operations = std::make_shared<
+        Queue<std::shared_ptr<DataStoreDispatcher::Operation>>>();
+      dispatcher->get_operation_publisher().monitor(operations);
+      auto data_store =
+        IntrusiveDataStore(dispatcher, CacheBudget::UNLIMITED);
+      auto handler = RoutineHandler(spawn([&] {
+        load_values(*operations);
+      }));
+      data_store.load(make_query(SnapshotLimit::UNLIMITED, value() > 0));
+      return data_store.get_statistics().m_size;
+    }();
+    auto dispatcher = std::make_shared<DataStoreDispatcher>();
+    auto operations = std::make_shared<
+      Queue<std::shared_ptr<DataStoreDispatcher::Operation>>>();
+    dispatcher->get_operation_publisher().monitor(operations);
+    auto data_store = IntrusiveDataStore(dispatcher, capacity);
+    auto query = make_query(SnapshotLimit::UNLIMITED, value() > 0);
+    {
+      auto first_load = RoutineHandler(spawn([&] {
+        data_store.load(query);
+      }));
+      auto second_load = RoutineHandler(spawn([&] {
+        data_store.load(query);
+      }));
+      auto first_operation = operations->pop();
+      auto second_operation = operations->pop();
+      resolve(first_operation);
+      resolve(second_operation);
+    }
+    REQUIRE(data_store.get_statistics().m_misses == 2);
+    REQUIRE(data_store.get_statistics().m_size == capacity);
+    {
+      auto handler = RoutineHandler(spawn([&] {
+        load_values(*operations);
+      }));
+      data_store.load(make_query(SnapshotLimit::UNLIMITED, value() > 1));
+    }
+    REQUIRE(data_store.get_statistics().m_evictions == 1);
+    auto handler = RoutineHandler(spawn([&] {
+      try {
+        load_values(*operations);
+      } catch(const PipeBrokenException&) {}
+    }));
+    data_store.load(query);
+    operations->close();
+    REQUIRE(data_store.get_statistics().m_misses == 4);
+  }
+}
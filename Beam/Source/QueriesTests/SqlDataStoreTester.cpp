@@ -1,9 +1,15 @@
+#include <exception>
+#include <memory>
+#include <string>
 #include <vector>
 #include <doctest/doctest.h>
 #include <Viper/Sqlite3/Sqlite3.hpp>
 #include "Beam/Queries/BasicQuery.hpp"
+#include "Beam/Queries/BufferedDataStore.hpp"
+#include "Beam/Queries/EvaluatorTranslator.hpp"
 #include "Beam/Queries/SqlDataStore.hpp"
 #include "Beam/QueriesTests/TestEntry.hpp"
+#include "Beam/Queues/Queue.hpp"
 
 using namespace Beam;
 using namespace Beam::Tests;
@@ -70,4 +76,153 @@ TEST_SUITE("SqlDataStore") {
     auto data_store = EmbeddedDataStore("test", make_value_row(),
       make_embedded_index_row(), Ref(reader_pool), Ref(writer_pool));
   }
+
+  TEST_CASE("bulk_store") {
+    auto reader_pool = DatabaseConnectionPool<Sqlite3::Connection>(1,
+      [] {
+        auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+        connection->open();
+        return connection;
+      });
+    auto writer_pool = DatabaseConnectionPool<Sqlite3::Connection>(1,
+      [] {
+        auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+        connection->open();
+        return connection;
+      });
+    auto data_store = DataStore("bulk", make_value_row(), make_index_row(),
+      Ref(reader_pool), Ref(writer_pool));
+    auto values = std::vector<DataStore::IndexedValue>();
+    auto sequence = Beam::Sequence(5);
+    auto timestamp = time_from_string("2022-04-06 04:15:22:01");
+    for(auto i = 0; i != 2500; ++i) {
+      values.push_back(SequencedValue(IndexedValue(
+        TestEntry(i, timestamp), std::string("hello")), sequence));
+      sequence = increment(sequence);
+    }
+    data_store.store(values);
+    auto statistics = data_store.get_write_statistics();
+    REQUIRE(statistics.m_rows == 2500);
+    REQUIRE(statistics.m_statements == 3);
+    auto query = BasicQuery<std::string>();
+    query.set_index("hello");
+    query.set_range(Range::TOTAL);
+    query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    REQUIRE(data_store.load(query).size() == 2500);
+  }
+
+  TEST_CASE("max_rows_per_insert") {
+    auto reader_pool = DatabaseConnectionPool<Sqlite3::Connection>(1,
+      [] {
+        auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+        connection->open();
+        return connection;
+      });
+    auto writer_pool = DatabaseConnectionPool<Sqlite3::Connection>(1,
+      [] {
+        auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+        connection->open();
+        return connection;
+      });
+    auto data_store = DataStore("narrow", make_value_row(), make_index_row(),
+      Ref(reader_pool), Ref(writer_pool), SqlConnectionOption::CREATE, 100);
+    auto values = std::vector<DataStore::IndexedValue>();
+    auto sequence = Beam::Sequence(5);
+    auto timestamp = time_from_string("2022-04-06 04:15:22:01");
+    for(auto i = 0; i != 250; ++i) {
+      values.push_back(SequencedValue(IndexedValue(
+        TestEntry(i, timestamp), std::string("hello")), sequence));
+      sequence = increment(sequence);
+    }
+    data_store.store(values);
+    auto statistics = data_store.get_write_statistics();
+    REQUIRE(statistics.m_rows == 250);
+    REQUIRE(statistics.m_statements == 3);
+  }
+
+  TEST_CASE("multiple_indexes") {
+    auto reader_pool = DatabaseConnectionPool<Sqlite3::Connection>(1,
+      [] {
+        auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+        connection->open();
+        return connection;
+      });
+    auto writer_pool = DatabaseConnectionPool<Sqlite3::Connection>(1,
+      [] {
+        auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+        connection->open();
+        return connection;
+      });
+    auto data_store = DataStore("indexes", make_value_row(),
+      make_index_row(), Ref(reader_pool), Ref(writer_pool),
+      SqlConnectionOption::CREATE, 100);
+    auto names = std::vector<std::string>{"a", "b", "c"};
+    auto values = std::vector<DataStore::IndexedValue>();
+    auto sequence = Beam::Sequence(5);
+    auto timestamp = time_from_string("2022-04-06 04:15:22:01");
+    for(auto i = 0; i != 450; ++i) {
+      values.push_back(SequencedValue(IndexedValue(
+        TestEntry(i, timestamp), names[i % names.size()]), sequence));
+      sequence = increment(sequence);
+    }
+    data_store.store(values);
+    auto statistics = data_store.get_write_statistics();
+    REQUIRE(statistics.m_rows == 450);
+    REQUIRE(statistics.m_statements == 5);
+    for(auto& name : names) {
+      auto query = BasicQuery<std::string>();
+      query.set_index(name);
+      query.set_range(Range::TOTAL);
+      query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+      REQUIRE(data_store.load(query).size() == 150);
+    }
+  }
+
+  TEST_CASE("failed_batch_retry") {
+    auto reader_pool = DatabaseConnectionPool<Sqlite3::Connection>(1,
+      [] {
+        auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+        connection->open();
+        return connection;
+      });
+    auto writer_pool = DatabaseConnectionPool<Sqlite3::Connection>(1,
+      [] {
+        auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+        connection->open();
+        return connection;
+      });
+    auto data_store = DataStore("retry", make_value_row(), make_index_row(),
+      Ref(reader_pool), Ref(writer_pool), SqlConnectionOption::CREATE, 2);
+    auto connection = Sqlite3::Connection(PATH);
+    connection.open();
+    connection.execute("CREATE TRIGGER reject_b BEFORE INSERT ON retry "
+      "WHEN NEW.name = 'b' BEGIN SELECT RAISE(ABORT, 'rejected'); END");
+    using RetryDataStore =
+      BufferedDataStore<DataStore*, EvaluatorTranslator<QueryTypes>>;
+    auto failures = std::make_shared<Queue<std::exception_ptr>>();
+    auto buffered_data_store = RetryDataStore(&data_store, 6,
+      RetryDataStore::ExceptionHandler([&] (const std::exception_ptr& e) {
+        failures->push(e);
+      }));
+    auto names = std::vector<std::string>{"a", "b"};
+    auto values = std::vector<DataStore::IndexedValue>();
+    auto sequence = Beam::Sequence(5);
+    auto timestamp = time_from_string("2022-04-06 04:15:22:01");
+    for(auto i = 0; i != 6; ++i) {
+      values.push_back(SequencedValue(IndexedValue(
+        TestEntry(i, timestamp), names[i % names.size()]), sequence));
+      sequence = increment(sequence);
+    }
+    buffered_data_store.store(values);
+    failures->pop();
+    connection.execute("DROP TRIGGER reject_b");
+    buffered_data_store.close();
+    for(auto& name : names) {
+      auto query = BasicQuery<std::string>();
+      query.set_index(name);
+      query.set_range(Range::TOTAL);
+      query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+      REQUIRE(data_store.load(query).size() == 3);
+    }
+  }
 }
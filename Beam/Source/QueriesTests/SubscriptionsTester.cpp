@@ -237,6 +237,81 @@ TEST_SUITE("Subscriptions") {
     REQUIRE(received);
   }
 
+  TEST_CASE("indexed_filter") {
+    auto fixture = SingleClientFixture();
+    auto& client = fixture.m_client;
+    auto subscriptions = TestSubscriptions([] (const auto& expression) {
+      return translate<TestTranslator>(expression);
+    });
+    auto value_expression = MemberAccessExpression(
+      "value", typeid(int), ParameterExpression(0, typeid(TestEntry)));
+    auto equals_id =
+      subscriptions.add(client, Range::TOTAL, value_expression == 150);
+    auto range_id = subscriptions.add(
+      client, Range::TOTAL, value_expression >= ConstantExpression(100));
+    auto publish = [&] (int value, int sequence) {
+      auto received = 0;
+      subscriptions.publish(
+        SequencedValue(TestEntry(value, time_from_string(
+          "2024-01-15 10:30:00")), Beam::Sequence(sequence)),
+        [&] (auto& receiving_clients) {
+          REQUIRE(receiving_clients.size() == 1);
+          REQUIRE(receiving_clients.front() == &client);
+          ++received;
+        });
+      return received;
+    };
+    REQUIRE(publish(50, 1) == 0);
+    REQUIRE(publish(120, 2) == 1);
+    REQUIRE(publish(150, 3) == 1);
+    subscriptions.end(client, range_id);
+    REQUIRE(publish(120, 4) == 0);
+    REQUIRE(publish(150, 5) == 1);
+    subscriptions.end(client, equals_id);
+    REQUIRE(publish(150, 6) == 0);
+  }
+
+  TEST_CASE("indexed_filter_excluded_client") {
+    auto fixture = SingleClientFixture();
+    auto& client1 = fixture.m_client;
+    auto server = LocalServerConnection();
+    auto server_channel = std::unique_ptr<LocalServerChannel>();
+    auto accept_routine = RoutineHandler(spawn([&] {
+      server_channel = server.accept();
+    }));
+    auto client2 = TestServiceProtocolClient(init("test2", server), init());
+    accept_routine.wait();
+    auto subscriptions = TestSubscriptions([] (const auto& expression) {
+      return translate<TestTranslator>(expression);
+    });
+    auto value_expression = MemberAccessExpression(
+      "value", typeid(int), ParameterExpression(0, typeid(TestEntry)));
+    subscriptions.add(
+      client1, Range::TOTAL, value_expression >= ConstantExpression(100));
+    subscriptions.add(
+      client2, Range::TOTAL, value_expression >= ConstantExpression(100));
+    auto publish = [&] (int value, int sequence,
+        const TestServiceProtocolClient& excluded_client) {
+      auto receiving_clients = std::vector<TestServiceProtocolClient*>();
+      subscriptions.publish(
+        SequencedValue(TestEntry(value, time_from_string(
+          "2024-01-15 10:30:00")), Beam::Sequence(sequence)),
+        [&] (const auto& client) {
+          return &client != &excluded_client;
+        },
+        [&] (const auto& clients) {
+          receiving_clients = clients;
+        });
+      return receiving_clients;
+    };
+    REQUIRE(publish(150, 1, client1) ==
+      std::vector<TestServiceProtocolClient*>{&client2});
+    REQUIRE(publish(150, 2, client2) ==
+      std::vector<TestServiceProtocolClient*>{&client1});
+    REQUIRE(publish(50, 3, client1).empty());
+    REQUIRE(publish(50, 4, client2).empty());
+  }
+
   TEST_CASE("range_filtering") {
     auto fixture = SingleClientFixture();
     auto [client, subscriptions] =
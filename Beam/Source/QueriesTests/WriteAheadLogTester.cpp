@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Queries/WriteAheadLog.hpp"
+#include "Beam/QueriesTests/TestEntry.hpp"
+
+using namespace Beam;
+using namespace Beam::Tests;
+using namespace boost;
+using namespace boost::posix_time;
+
+namespace {
+  using Log = WriteAheadLog<SequencedIndexedTestEntry>;
+
+  struct Fixture {
+    std::filesystem::path m_directory;
+
+    Fixture()
+      : m_directory(std::filesystem::temp_directory_path() /
+          ("beam_wal_" + std::to_string(std::random_device()()))) {}
+
+    ~Fixture() {
+      auto error = std::error_code();
+      std::filesystem::remove_all(m_directory, error);
+    }
+  };
+
+  auto make_entry(int value, Beam::Sequence sequence) {
+    return SequencedValue(IndexedValue(
+      TestEntry(value, time_from_string("2024-05-06 13:21:53:06")),
+      std::string("hello")), sequence);
+  }
+}
+
+TEST_SUITE("WriteAheadLog") {
+  TEST_CASE_FIXTURE(Fixture, "write_and_recover") {
+    auto entry_a = make_entry(100, Beam::Sequence(5));
+    auto entry_b = make_entry(200, Beam::Sequence(6));
+    auto entry_c = make_entry(300, Beam::Sequence(7));
+    {
+      auto log = Log(m_directory);
+      REQUIRE(log.recover().empty());
+      log.write(std::vector{entry_a});
+      log.sync(log.write(std::vector{entry_b, entry_c}));
+    }
+    auto log = Log(m_directory);
+    REQUIRE(log.recover() ==
+      std::vector<SequencedIndexedTestEntry>{entry_a, entry_b, entry_c});
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "truncate") {
+    auto entry_a = make_entry(100, Beam::Sequence(5));
+    auto entry_b = make_entry(200, Beam::Sequence(6));
+    {
+      auto log = Log(m_directory);
+      log.write(std::vector{entry_a});
+      auto segment = log.seal();
+      log.sync(log.write(std::vector{entry_b}));
+      REQUIRE(segment);
+      log.truncate(*segment);
+    }
+    auto log = Log(m_directory);
+    REQUIRE(log.recover() == std::vector<SequencedIndexedTestEntry>{entry_b});
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "torn_record") {
+    auto entry_a = make_entry(100, Beam::Sequence(5));
+    {
+      auto log = Log(m_directory);
+      log.sync(log.write(std::vector{entry_a}));
+    }
+    {
+      auto file = std::ofstream(
+        m_directory / "0.wal", std::ios::binary | std::ios::app);
+      file << "torn";
+    }
+    auto log = Log(m_directory);
+    REQUIRE(log.recover() == std::vector<SequencedIndexedTestEntry>{entry_a});
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "seal_empty_segment") {
+    auto log = Log(m_directory);
+    REQUIRE(!log.seal());
+    log.sync(log.write(std::vector{make_entry(100, Beam::Sequence(5))}));
+    REQUIRE(log.seal() == Log::Segment(0));
+    REQUIRE(log.seal() == Log::Segment(0));
+    auto count = std::distance(std::filesystem::directory_iterator(
+      m_directory), std::filesystem::directory_iterator());
+    REQUIRE(count == 2);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "seal_without_reserve") {
+    auto log = Log(m_directory);
+    log.sync(log.write(std::vector{make_entry(100, Beam::Sequence(5))}));
+    REQUIRE(log.seal() == Log::Segment(0));
+    log.sync(log.write(std::vector{make_entry(200, Beam::Sequence(6))}));
+    REQUIRE(log.seal() == Log::Segment(0));
+    log.reserve();
+    REQUIRE(log.seal() == Log::Segment(1));
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "oversized_record") {
+    auto entry_a = make_entry(100, Beam::Sequence(5));
+    {
+      auto log = Log(m_directory);
+      log.sync(log.write(std::vector{entry_a}));
+    }
+    {
+      auto file = std::ofstream(
+        m_directory / "0.wal", std::ios::binary | std::ios::app);
+      auto size = std::uint32_t(0xFFFFFFF0);
+      auto checksum = std::uint32_t(0);
+      file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+      file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+      file << "payload";
+    }
+    auto log = Log(m_directory);
+    REQUIRE(log.recover() == std::vector<SequencedIndexedTestEntry>{entry_a});
+  }
+}
@@ -1,3 +1,4 @@
+#include <memory>
 #include <doctest/doctest.h>
 #include "Beam/Queues/CallbackQueueWriter.hpp"
 
@@ -27,4 +28,14 @@ TEST_SUITE("CallbackQueueWriter") {
     callback.close(std::runtime_error("Broken"));
     REQUIRE_THROWS_AS(callback.push({}), std::runtime_error);
   }
+
+  TEST_CASE("move_only") {
+    auto received = 0;
+    auto callback = CallbackQueueWriter<std::unique_ptr<int>>(
+      [&] (const auto& value) {
+        received = *value;
+      });
+    callback.push(std::make_unique<int>(123));
+    REQUIRE(received == 123);
+  }
 }
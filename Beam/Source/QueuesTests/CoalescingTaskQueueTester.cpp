@@ -0,0 +1,100 @@
+#include <string>
+#include <doctest/doctest.h>
+#include "Beam/Queues/CoalescingTaskQueue.hpp"
+
+using namespace Beam;
+
+TEST_SUITE("CoalescingTaskQueue") {
+  TEST_CASE("flush") {
+    auto queue = CoalescingTaskQueue();
+    auto values = std::vector<int>();
+    auto slot = queue.get_slot<int>([&] (auto v) {
+      values.push_back(v);
+    });
+    slot.push(42);
+    flush(queue);
+    REQUIRE(values.size() == 1);
+    REQUIRE(values.front() == 42);
+  }
+
+  TEST_CASE("slot_tasks_are_inline") {
+    auto queue = CoalescingTaskQueue();
+    auto slot = queue.get_slot<std::string>([] (const auto&) {});
+    slot.push("hello");
+    auto task = queue.try_pop();
+    REQUIRE(task);
+    REQUIRE(task->is_inline());
+  }
+
+  TEST_CASE("pop_all") {
+    auto queue = CoalescingTaskQueue();
+    auto values = std::vector<int>();
+    auto slot1 = queue.get_slot<int>([&] (auto v) { values.push_back(v); });
+    auto slot2 = queue.get_slot<int>([&] (auto v) { values.push_back(-v); });
+    for(auto i = 1; i <= 3; ++i) {
+      slot1.push(i);
+      slot2.push(i);
+    }
+    auto tasks = queue.pop_all();
+    REQUIRE(tasks.size() == 6);
+    REQUIRE(!queue.try_pop());
+    for(auto& task : tasks) {
+      task();
+    }
+    REQUIRE(values == std::vector{1, -1, 2, -2, 3, -3});
+  }
+
+  TEST_CASE("push_task") {
+    auto queue = CoalescingTaskQueue();
+    auto executed = false;
+    queue.push(Task([&] {
+      executed = true;
+    }));
+    auto task = Task();
+    REQUIRE_THROWS_AS(queue.push(task), std::logic_error);
+    flush(queue);
+    REQUIRE(executed);
+  }
+
+  TEST_CASE("close") {
+    auto queue = CoalescingTaskQueue();
+    auto received_break = false;
+    auto slot = queue.get_slot<int>([] (auto) {}, [&] (const auto&) {
+      received_break = true;
+    });
+    queue.close(std::runtime_error("closed"));
+    auto tasks = queue.pop_all();
+    REQUIRE(tasks.size() == 2);
+    for(auto& task : tasks) {
+      task();
+    }
+    REQUIRE(received_break);
+    REQUIRE_THROWS_AS(queue.pop(), std::runtime_error);
+    REQUIRE_THROWS_AS(slot.push(1), std::runtime_error);
+  }
+
+  TEST_CASE("slot_after_break") {
+    auto queue = CoalescingTaskQueue();
+    queue.close(std::runtime_error("broken"));
+    auto received_break = false;
+    auto slot = queue.get_slot<int>([] (auto) {}, [&] (const auto&) {
+      received_break = true;
+    });
+    flush(queue);
+    REQUIRE(received_break);
+  }
+
+  TEST_CASE("batch_loop") {
+    auto queue = std::make_shared<CoalescingTaskQueue>();
+    auto sum = 0;
+    auto slot = queue->get_slot<int>([&] (auto v) {
+      sum += v;
+    });
+    for(auto i = 1; i <= 100; ++i) {
+      slot.push(i);
+    }
+    queue->close();
+    batch_loop(queue);
+    REQUIRE(sum == 5050);
+  }
+}
@@ -1,3 +1,4 @@
+#include <memory>
 #include <string>
 #include <doctest/doctest.h>
 #include "Beam/Queues/ConverterQueueWriter.hpp"
@@ -27,4 +28,14 @@ TEST_SUITE("ConverterQueueWriter") {
     }
     REQUIRE(destination->is_broken());
   }
+
+  TEST_CASE("move_only") {
+    auto destination = std::make_shared<Queue<int>>();
+    auto converter = convert<std::unique_ptr<int>>(destination,
+      [] (std::unique_ptr<int> value) {
+        return *value;
+      });
+    converter->push(std::make_unique<int>(54));
+    REQUIRE(destination->pop() == 54);
+  }
 }
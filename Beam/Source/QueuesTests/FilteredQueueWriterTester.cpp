@@ -1,3 +1,4 @@
+#include <memory>
 #include <string>
 #include <doctest/doctest.h>
 #include "Beam/Queues/FilteredQueueWriter.hpp"
@@ -34,4 +35,16 @@ TEST_SUITE("FilteredQueueWriter") {
     }
     REQUIRE(destination->is_broken());
   }
+
+  TEST_CASE("move_only") {
+    auto destination = std::make_shared<Queue<std::unique_ptr<int>>>();
+    auto filter = FilteredQueueWriter(destination, [] (const auto& value) {
+      return *value % 2 == 0;
+    });
+    filter.push(std::make_unique<int>(1));
+    filter.push(std::make_unique<int>(2));
+    filter.close();
+    REQUIRE(*destination->pop() == 2);
+    REQUIRE(destination->is_broken());
+  }
 }
@@ -0,0 +1,85 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Queues/MpscQueue.hpp"
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+
+using namespace Beam;
+
+TEST_SUITE("MpscQueue") {
+  TEST_CASE("push_and_pop") {
+    auto queue = MpscQueue<std::string>(4);
+    queue.push("a");
+    queue.push("b");
+    REQUIRE(queue.pop() == "a");
+    REQUIRE(queue.try_pop() == std::string("b"));
+    REQUIRE(!queue.try_pop());
+  }
+
+  TEST_CASE("try_push_full") {
+    auto queue = MpscQueue<int>(2);
+    REQUIRE(queue.try_push(1));
+    REQUIRE(queue.try_push(2));
+    REQUIRE(!queue.try_push(3));
+    REQUIRE(queue.pop() == 1);
+    REQUIRE(queue.try_push(3));
+    REQUIRE(queue.pop() == 2);
+    REQUIRE(queue.pop() == 3);
+  }
+
+  TEST_CASE("close") {
+    auto queue = MpscQueue<int>();
+    queue.push(1);
+    queue.close(std::runtime_error("broken"));
+    REQUIRE_THROWS_AS(queue.push(2), std::runtime_error);
+    REQUIRE(queue.pop() == 1);
+    REQUIRE_THROWS_AS(queue.pop(), std::runtime_error);
+  }
+
+  TEST_CASE("destroys_remaining_values") {
+    auto value = std::make_shared<int>(5);
+    {
+      auto queue = MpscQueue<std::shared_ptr<int>>(4);
+      queue.push(value);
+      REQUIRE(value.use_count() == 2);
+    }
+    REQUIRE(value.use_count() == 1);
+  }
+
+  TEST_CASE("multiple_producers") {
+    auto producer_count = 8;
+    auto count = 2000;
+    auto queue = MpscQueue<int>(16);
+    auto producers = RoutineHandlerGroup();
+    for(auto i = 0; i < producer_count; ++i) {
+      producers.spawn([&, i] {
+        for(auto j = 0; j < count; ++j) {
+          queue.push(i * count + j);
+        }
+      });
+    }
+    auto last = std::vector<int>(producer_count, -1);
+    auto is_ordered = true;
+    for(auto i = 0; i < producer_count * count; ++i) {
+      auto value = queue.pop();
+      auto producer = value / count;
+      if(value % count != last[producer] + 1) {
+        is_ordered = false;
+      }
+      last[producer] = value % count;
+    }
+    producers.wait();
+    REQUIRE(is_ordered);
+    REQUIRE(!queue.try_pop());
+  }
+
+  TEST_CASE("move_only") {
+    auto queue = MpscQueue<std::unique_ptr<int>>(2);
+    queue.push(std::make_unique<int>(1));
+    REQUIRE(queue.try_push(std::make_unique<int>(2)));
+    REQUIRE(*queue.pop() == 1);
+    REQUIRE(**queue.try_pop() == 2);
+  }
+}
@@ -1,7 +1,10 @@
+#include <chrono>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 #include <doctest/doctest.h>
 #include "Beam/Queues/Queue.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
 
 using namespace Beam;
 
@@ -74,4 +77,91 @@ TEST_SUITE("Queue") {
     REQUIRE(value == 1);
     REQUIRE(queue.is_broken());
   }
+
+  TEST_CASE("try_pop_batch") {
+    auto queue = Queue<int>();
+    for(auto i = 0; i < 5; ++i) {
+      queue.push(i);
+    }
+    auto values = std::vector<int>();
+    REQUIRE(queue.try_pop_batch(out(values), 3) == 3);
+    REQUIRE(values == std::vector{0, 1, 2});
+    REQUIRE(queue.try_pop_batch(out(values), 10) == 2);
+    REQUIRE(values == std::vector{0, 1, 2, 3, 4});
+    REQUIRE(queue.try_pop_batch(out(values), 10) == 0);
+  }
+
+  TEST_CASE("pop_all") {
+    auto queue = Queue<int>();
+    queue.push(1);
+    queue.push(2);
+    REQUIRE(queue.pop_all() == std::vector{1, 2});
+    REQUIRE(queue.get_size() == 0);
+    queue.push(3);
+    queue.close(std::runtime_error("broken"));
+    REQUIRE(queue.pop_all() == std::vector{3});
+    REQUIRE_THROWS_AS(queue.pop_all(), std::runtime_error);
+  }
+
+  TEST_CASE("bounded_fail") {
+    auto queue = Queue<int>(2, OverflowPolicy::FAIL);
+    REQUIRE(queue.get_capacity() == 2);
+    queue.push(1);
+    REQUIRE(queue.try_push(2));
+    REQUIRE(!queue.try_push(3));
+    REQUIRE_THROWS_AS(queue.push(3), QueueFullException);
+    REQUIRE(queue.pop() == 1);
+    queue.push(3);
+    REQUIRE(queue.pop_all() == std::vector{2, 3});
+  }
+
+  TEST_CASE("bounded_drop_oldest") {
+    auto queue = Queue<int>(2, OverflowPolicy::DROP_OLDEST);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    REQUIRE(!queue.try_push(4));
+    REQUIRE(queue.pop_all() == std::vector{2, 3});
+  }
+
+  TEST_CASE("bounded_block") {
+    auto queue = Queue<int>(2);
+    auto count = 100;
+    auto producer = RoutineHandler(spawn([&] {
+      for(auto i = 0; i < count; ++i) {
+        queue.push(i);
+        REQUIRE(queue.get_size() <= 2);
+      }
+    }));
+    auto values = std::vector<int>();
+    while(values.size() != count) {
+      if(values.size() % 2 == 0) {
+        values.push_back(queue.pop());
+      } else {
+        auto batch = queue.pop_all();
+        values.insert(values.end(), batch.begin(), batch.end());
+      }
+    }
+    producer.wait();
+    for(auto i = 0; i < count; ++i) {
+      REQUIRE(values[i] == i);
+    }
+  }
+
+  TEST_CASE("close_wakes_blocked_producer") {
+    auto queue = Queue<int>(1);
+    queue.push(1);
+    auto is_broken = false;
+    auto producer = RoutineHandler(spawn([&] {
+      try {
+        queue.push(2);
+      } catch(const PipeBrokenException&) {
+        is_broken = true;
+      }
+    }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.close();
+    producer.wait();
+    REQUIRE(is_broken);
+  }
 }
@@ -48,4 +48,16 @@ TEST_SUITE("ScopedQueueReader") {
     REQUIRE(reader.pop() == 42);
     REQUIRE_THROWS_AS(reader.pop(), std::runtime_error);
   }
+
+  TEST_CASE("batch_forwarded") {
+    auto queue = std::make_shared<Queue<int>>();
+    queue->push(1);
+    queue->push(2);
+    queue->push(3);
+    auto reader = ScopedQueueReader(queue);
+    auto values = std::vector<int>();
+    REQUIRE(reader.try_pop_batch(out(values), 2) == 2);
+    REQUIRE(values == std::vector{1, 2});
+    REQUIRE(reader.pop_all() == std::vector{3});
+  }
 }
@@ -1,3 +1,4 @@
+#include <memory>
 #include <doctest/doctest.h>
 #include "Beam/Queues/Queue.hpp"
 #include "Beam/Queues/ScopedQueueWriter.hpp"
@@ -48,4 +49,14 @@ TEST_SUITE("ScopedQueueWriter") {
     }
     REQUIRE(q1->is_broken());
   }
+
+  TEST_CASE("move_only") {
+    auto q = std::make_shared<Queue<std::unique_ptr<int>>>();
+    {
+      auto s = ScopedQueueWriter<std::unique_ptr<int>>(q);
+      s.push(std::make_unique<int>(5));
+    }
+    REQUIRE(*q->pop() == 5);
+    REQUIRE(q->is_broken());
+  }
 }
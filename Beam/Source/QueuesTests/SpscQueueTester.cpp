@@ -0,0 +1,96 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Queues/ScopedQueueReader.hpp"
+#include "Beam/Queues/ScopedQueueWriter.hpp"
+#include "Beam/Queues/SpscQueue.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+
+using namespace Beam;
+
+TEST_SUITE("SpscQueue") {
+  TEST_CASE("push_and_pop") {
+    auto queue = SpscQueue<std::string>(4);
+    REQUIRE(queue.get_capacity() == 4);
+    queue.push("a");
+    queue.push("b");
+    REQUIRE(queue.pop() == "a");
+    REQUIRE(queue.try_pop() == std::string("b"));
+    REQUIRE(!queue.try_pop());
+  }
+
+  TEST_CASE("try_push_full") {
+    auto queue = SpscQueue<int>(2);
+    REQUIRE(queue.try_push(1));
+    REQUIRE(queue.try_push(2));
+    REQUIRE(!queue.try_push(3));
+    REQUIRE(queue.pop() == 1);
+    REQUIRE(queue.try_push(3));
+  }
+
+  TEST_CASE("close") {
+    auto queue = SpscQueue<int>();
+    queue.push(1);
+    queue.close(std::runtime_error("broken"));
+    REQUIRE(!queue.is_broken());
+    REQUIRE_THROWS_AS(queue.push(2), std::runtime_error);
+    REQUIRE(queue.pop() == 1);
+    REQUIRE(queue.is_broken());
+    REQUIRE_THROWS_AS(queue.pop(), std::runtime_error);
+  }
+
+  TEST_CASE("destroys_remaining_values") {
+    auto value = std::make_shared<int>(5);
+    {
+      auto queue = SpscQueue<std::shared_ptr<int>>(4);
+      queue.push(value);
+      queue.push(value);
+      REQUIRE(value.use_count() == 3);
+    }
+    REQUIRE(value.use_count() == 1);
+  }
+
+  TEST_CASE("scoped") {
+    auto queue = std::make_shared<SpscQueue<int>>();
+    auto writer = ScopedQueueWriter<int>(queue);
+    auto reader = ScopedQueueReader<int>(queue);
+    writer.push(7);
+    REQUIRE(reader.pop() == 7);
+  }
+
+  TEST_CASE("blocking_producer_and_consumer") {
+    auto count = 10000;
+    auto queue = SpscQueue<int>(8);
+    auto producer = std::thread([&] {
+      for(auto i = 0; i < count; ++i) {
+        queue.push(i);
+      }
+      queue.close();
+    });
+    auto values = std::vector<int>();
+    auto consumer = RoutineHandler(spawn([&] {
+      try {
+        while(true) {
+          values.push_back(queue.pop());
+        }
+      } catch(const PipeBrokenException&) {}
+    }));
+    consumer.wait();
+    producer.join();
+    REQUIRE(values.size() == count);
+    for(auto i = 0; i < count; ++i) {
+      REQUIRE(values[i] == i);
+    }
+  }
+
+  TEST_CASE("move_only") {
+    auto queue = SpscQueue<std::unique_ptr<int>>(2);
+    queue.push(std::make_unique<int>(1));
+    REQUIRE(queue.try_push(std::make_unique<int>(2)));
+    REQUIRE(*queue.pop() == 1);
+    REQUIRE(**queue.try_pop() == 2);
+  }
+}
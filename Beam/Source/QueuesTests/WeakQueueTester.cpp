@@ -1,3 +1,4 @@
+#include <memory>
 #include <doctest/doctest.h>
 #include "Beam/Queues/Queue.hpp"
 #include "Beam/Queues/WeakQueueWriter.hpp"
@@ -25,4 +26,11 @@ TEST_SUITE("WeakQueueWriter") {
     queue.reset();
     REQUIRE_THROWS_AS(weak_writer->push(1), PipeBrokenException);
   }
+
+  TEST_CASE("move_only") {
+    auto queue = std::make_shared<Queue<std::unique_ptr<int>>>();
+    auto weak_writer = WeakQueueWriter<std::unique_ptr<int>>(queue);
+    weak_writer.push(std::make_unique<int>(42));
+    REQUIRE(*queue->pop() == 42);
+  }
 }
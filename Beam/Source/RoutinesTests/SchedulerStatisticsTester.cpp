@@ -0,0 +1,60 @@
+#include <chrono>
+#include <sstream>
+#include <doctest/doctest.h>
+#include "Beam/Routines/SchedulerStatistics.hpp"
+
+using namespace Beam;
+using namespace std::chrono;
+
+TEST_SUITE("SchedulerStatistics") {
+  TEST_CASE("buckets") {
+    REQUIRE(LatencyHistogram::get_bucket(nanoseconds(0)) == 0);
+    REQUIRE(LatencyHistogram::get_bucket(nanoseconds(1)) == 1);
+    REQUIRE(LatencyHistogram::get_bucket(nanoseconds(3)) == 2);
+    REQUIRE(LatencyHistogram::get_bucket(nanoseconds(4)) == 3);
+    REQUIRE(LatencyHistogram::get_bucket(hours(1000)) ==
+      LatencyHistogram::BUCKET_COUNT - 1);
+    REQUIRE(LatencyHistogram::get_upper_bound(3) == nanoseconds(8));
+  }
+
+  TEST_CASE("percentiles") {
+    auto histogram = LatencyHistogram();
+    REQUIRE(histogram.get_percentile(0.5) == nanoseconds(0));
+    for(auto i = 0; i != 99; ++i) {
+      histogram.add(nanoseconds(100));
+    }
+    histogram.add(milliseconds(1));
+    REQUIRE(histogram.get_count() == 100);
+    REQUIRE(histogram.get_percentile(0.5) == nanoseconds(128));
+    REQUIRE(histogram.get_percentile(0.99) == nanoseconds(128));
+    REQUIRE(histogram.get_percentile(1) == nanoseconds(1048576));
+  }
+
+  TEST_CASE("difference") {
+    auto live = LiveLatencyHistogram();
+    live.add(nanoseconds(10));
+    auto previous = live.load();
+    live.add(nanoseconds(10));
+    live.add(microseconds(10));
+    auto delta = live.load();
+    delta -= previous;
+    REQUIRE(delta.get_count() == 2);
+    REQUIRE(delta.get_count(LatencyHistogram::get_bucket(nanoseconds(10))) ==
+      1);
+    delta += previous;
+    REQUIRE(delta.get_count() == 3);
+  }
+
+  TEST_CASE("stream") {
+    auto statistics = ContextStatistics();
+    statistics.m_context_id = 2;
+    statistics.m_longest_slice = milliseconds(25);
+    statistics.m_longest_slice_routine = 7;
+    auto stream = std::stringstream();
+    stream << statistics;
+    REQUIRE(stream.str().starts_with("context: 2,"));
+    REQUIRE(stream.str().find("longest slice: 25ms (routine 7)") !=
+      std::string::npos);
+    REQUIRE(stream.str().find("running") == std::string::npos);
+  }
+}
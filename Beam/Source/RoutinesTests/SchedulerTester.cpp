@@ -0,0 +1,157 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+#include "Beam/Routines/ThreadingConfig.hpp"
+
+using namespace Beam;
+
+TEST_SUITE("Scheduler") {
+  TEST_CASE("spawn_and_wait") {
+    auto counter = std::atomic_int(0);
+    auto routines = RoutineHandlerGroup();
+    for(auto i = 0; i != 1000; ++i) {
+      routines.spawn([&] {
+        defer();
+        ++counter;
+        defer();
+      });
+    }
+    routines.wait();
+    REQUIRE(counter == 1000);
+  }
+
+  TEST_CASE("wait_after_complete") {
+    auto counter = std::atomic_int(0);
+    auto ids = std::vector<Routine::Id>();
+    for(auto i = 0; i != 200; ++i) {
+      ids.push_back(spawn([&] {
+        ++counter;
+      }));
+    }
+    for(auto id : ids) {
+      wait(id);
+    }
+    REQUIRE(counter == 200);
+    for(auto id : ids) {
+      wait(id);
+    }
+  }
+
+  TEST_CASE("pinned_routines_stay_in_context") {
+    auto& scheduler = Details::Scheduler::get();
+    auto is_pinned = std::atomic_bool(true);
+    auto routines = RoutineHandlerGroup();
+    for(auto i = std::size_t(0); i != scheduler.get_thread_count(); ++i) {
+      routines.add(spawn([&, i] {
+        for(auto j = 0; j != 100; ++j) {
+          auto& routine =
+            static_cast<ScheduledRoutine&>(get_current_routine());
+          if(routine.get_context_id() != i || !routine.is_pinned() ||
+              Details::CurrentContextGlobal::get() != i) {
+            is_pinned = false;
+          }
+          defer();
+        }
+      }, Details::Scheduler::DEFAULT_STACK_SIZE, i));
+    }
+    routines.wait();
+    REQUIRE(is_pinned);
+  }
+
+  TEST_CASE("suspend_and_resume") {
+    auto routine = static_cast<Routine*>(nullptr);
+    auto mutex = boost::mutex();
+    auto is_resumed = std::atomic_bool(false);
+    auto waiter = RoutineHandler(spawn([&] {
+      auto lock = boost::unique_lock(mutex);
+      suspend(out(routine), lock);
+      is_resumed = true;
+    }));
+    while(true) {
+      auto lock = boost::lock_guard(mutex);
+      if(routine) {
+        resume(routine);
+        break;
+      }
+    }
+    waiter.wait();
+    REQUIRE(is_resumed);
+  }
+
+  TEST_CASE("unpinned_routines_complete_behind_blocked_context") {
+    auto& scheduler = Details::Scheduler::get();
+    if(scheduler.get_thread_count() < 2) {
+      return;
+    }
+    auto is_blocked = std::atomic_bool(true);
+    auto blocker = RoutineHandler(spawn([&] {
+      while(is_blocked) {}
+    }, Details::Scheduler::DEFAULT_STACK_SIZE, 0));
+    auto counter = std::atomic_int(0);
+    auto routines = RoutineHandlerGroup();
+    for(auto i = 0; i != 100; ++i) {
+      routines.spawn([&] {
+        ++counter;
+      });
+    }
+    while(scheduler.get_mode() == Details::Scheduler::Mode::WORK_STEALING &&
+        counter != 100) {}
+    is_blocked = false;
+    routines.wait();
+    blocker.wait();
+    REQUIRE(counter == 100);
+  }
+
+  TEST_CASE("set_config_after_start") {
+    auto routine = RoutineHandler(spawn([] {}));
+    routine.wait();
+    REQUIRE_THROWS_AS(Details::Scheduler::set_config({}), std::logic_error);
+    auto config = YAML::Load("{scheduler: {threads: 2}}");
+    REQUIRE_THROWS_AS(configure_threads(config), std::logic_error);
+    REQUIRE_NOTHROW(configure_threads(YAML::Load("{}")));
+  }
+
+  TEST_CASE("statistics") {
+    auto& scheduler = Details::Scheduler::get();
+    auto previous = scheduler.get_statistics(0);
+    auto is_blocking = std::atomic_bool(true);
+    auto blocker = RoutineHandler(spawn([&] {
+      while(is_blocking) {}
+    }, Details::Scheduler::DEFAULT_STACK_SIZE, 0));
+    auto statistics = scheduler.get_statistics(0);
+    while(statistics.m_running_routine != blocker.get_id()) {
+      statistics = scheduler.get_statistics(0);
+    }
+    auto start = std::chrono::steady_clock::now();
+    while(std::chrono::steady_clock::now() - start <
+      std::chrono::milliseconds(20)) {}
+    REQUIRE(scheduler.get_statistics(0).m_running_time >=
+      std::chrono::milliseconds(20));
+    is_blocking = false;
+    blocker.wait();
+    statistics = scheduler.get_statistics(0);
+    REQUIRE(statistics.m_context_id == 0);
+    REQUIRE(statistics.m_context_switches > previous.m_context_switches);
+    REQUIRE(statistics.m_scheduling_latency.get_count() >
+      previous.m_scheduling_latency.get_count());
+    auto slices = statistics.m_slice_duration;
+    slices -= previous.m_slice_duration;
+    REQUIRE(slices.get_percentile(1) >= std::chrono::milliseconds(20));
+    REQUIRE(statistics.m_longest_slice >= std::chrono::milliseconds(20));
+  }
+
+  TEST_CASE("pinned_context_out_of_range") {
+    auto& scheduler = Details::Scheduler::get();
+    auto context_id = scheduler.get_thread_count() + 1;
+    auto is_run = false;
+    auto routine = RoutineHandler(spawn([&] {
+      is_run = true;
+    }, Details::Scheduler::DEFAULT_STACK_SIZE, context_id));
+    routine.wait();
+    REQUIRE(is_run);
+  }
+}
@@ -0,0 +1,51 @@
+#include <doctest/doctest.h>
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Routines/StackPool.hpp"
+
+using namespace Beam;
+
+TEST_SUITE("StackPool") {
+  TEST_CASE("recycle_stack") {
+    auto& pool = StackPool::get();
+    auto initial_statistics = pool.get_statistics();
+    auto stack = pool.allocate(65536);
+    REQUIRE(stack.size >= 65536);
+    auto top = stack.sp;
+    pool.deallocate(stack);
+    auto statistics = pool.get_statistics();
+    REQUIRE(statistics.m_retained_size ==
+      initial_statistics.m_retained_size + 65536);
+    auto recycled_stack = pool.allocate(40000);
+    REQUIRE(recycled_stack.sp == top);
+    statistics = pool.get_statistics();
+    REQUIRE(statistics.m_hits == initial_statistics.m_hits + 1);
+    REQUIRE(statistics.m_misses == initial_statistics.m_misses + 1);
+    pool.deallocate(recycled_stack);
+  }
+
+  TEST_CASE("retained_size_limit") {
+    auto& pool = StackPool::get();
+    auto max_retained_size = pool.get_max_retained_size();
+    pool.set_max_retained_size(0);
+    auto initial_statistics = pool.get_statistics();
+    auto stack = pool.allocate(1 << 20);
+    pool.deallocate(stack);
+    auto statistics = pool.get_statistics();
+    REQUIRE(statistics.m_releases == initial_statistics.m_releases + 1);
+    REQUIRE(statistics.m_retained_size == initial_statistics.m_retained_size);
+    pool.set_max_retained_size(max_retained_size);
+  }
+
+  TEST_CASE("routines_reuse_stacks") {
+    for(auto i = 0; i != 100; ++i) {
+      wait(spawn([] {}));
+    }
+    auto initial_statistics = StackPool::get().get_statistics();
+    for(auto i = 0; i != 100; ++i) {
+      wait(spawn([] {}));
+    }
+    auto statistics = StackPool::get().get_statistics();
+    REQUIRE(statistics.m_hits > initial_statistics.m_hits);
+    REQUIRE(statistics.m_misses - initial_statistics.m_misses < 100);
+  }
+}
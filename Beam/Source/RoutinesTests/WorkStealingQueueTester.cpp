@@ -0,0 +1,81 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Routines/WorkStealingQueue.hpp"
+
+using namespace Beam;
+
+TEST_SUITE("WorkStealingQueue") {
+  TEST_CASE("capacity_rounds_to_power_of_two") {
+    auto queue = WorkStealingQueue<int>(5);
+    REQUIRE(queue.get_capacity() == 8);
+  }
+
+  TEST_CASE("push_and_pop_in_fifo_order") {
+    auto queue = WorkStealingQueue<int>(4);
+    REQUIRE(queue.is_empty());
+    REQUIRE(queue.push(1));
+    REQUIRE(queue.push(2));
+    REQUIRE(queue.push(3));
+    REQUIRE(queue.get_size() == 3);
+    auto value = 0;
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value == 1);
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value == 2);
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value == 3);
+    REQUIRE(!queue.try_pop(value));
+  }
+
+  TEST_CASE("push_fails_when_full") {
+    auto queue = WorkStealingQueue<int>(2);
+    REQUIRE(queue.push(1));
+    REQUIRE(queue.push(2));
+    REQUIRE(!queue.push(3));
+    auto value = 0;
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(queue.push(3));
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value == 2);
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value == 3);
+  }
+
+  TEST_CASE("concurrent_steal") {
+    const auto COUNT = 100000;
+    const auto THIEVES = 4;
+    auto queue = WorkStealingQueue<int>(64);
+    auto is_done = std::atomic_bool(false);
+    auto total = std::atomic<long long>(0);
+    auto taken = std::atomic_int(0);
+    auto thieves = std::vector<std::thread>();
+    for(auto i = 0; i != THIEVES; ++i) {
+      thieves.emplace_back([&] {
+        auto value = 0;
+        while(!is_done || !queue.is_empty()) {
+          if(queue.try_pop(value)) {
+            total += value;
+            ++taken;
+          }
+        }
+      });
+    }
+    for(auto i = 1; i <= COUNT; ++i) {
+      while(!queue.push(i)) {
+        auto value = 0;
+        if(queue.try_pop(value)) {
+          total += value;
+          ++taken;
+        }
+      }
+    }
+    is_done = true;
+    for(auto& thief : thieves) {
+      thief.join();
+    }
+    REQUIRE(taken == COUNT);
+    REQUIRE(total == static_cast<long long>(COUNT) * (COUNT + 1) / 2);
+  }
+}
@@ -1,4 +1,8 @@
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
 #include <memory>
+#include <string_view>
 #include <doctest/doctest.h>
 #include "Beam/Serialization/ShuttleUniquePtr.hpp"
 #include "Beam/SerializationTests/ShuttleTestTypes.hpp"
@@ -33,4 +37,187 @@ TEST_SUITE("ShuttleUniquePtr") {
     REQUIRE(in_value);
     REQUIRE(in_value->to_string() == out_value->to_string());
   }
+
+  TEST_CASE("polymorphic_type_id") {
+    auto registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    registry.template add<PolymorphicDerivedClassA>("PolymorphicDerivedClassA");
+    auto& entry = registry.get_entry<PolymorphicDerivedClassA>();
+    REQUIRE(entry.get_id() == get_type_id("PolymorphicDerivedClassA"));
+    using Sender = BinarySender<SharedBuffer>;
+    using Receiver = inverse_t<Sender>;
+    auto sender = Sender(Ref(registry));
+    auto buffer = typename Sender::Sink();
+    sender.set(Ref(buffer));
+    auto out_value = std::make_unique<PolymorphicDerivedClassA>();
+    sender.send(out_value.get());
+    auto type_id = std::uint32_t();
+    std::memcpy(&type_id, buffer.get_data() + sizeof(std::uint32_t),
+      sizeof(type_id));
+    REQUIRE(type_id == NAMED_TYPE_ID);
+    auto size = buffer.get_size();
+    sender.send(out_value.get());
+    std::memcpy(&type_id, buffer.get_data() + size + sizeof(std::uint32_t),
+      sizeof(type_id));
+    REQUIRE(type_id == entry.get_id());
+    auto contents = std::string_view(buffer.get_data(), buffer.get_size());
+    auto position = contents.find("PolymorphicDerivedClassA");
+    REQUIRE(position != std::string_view::npos);
+    REQUIRE(contents.find("PolymorphicDerivedClassA", position + 1) ==
+      std::string_view::npos);
+    auto receiver = Receiver(Ref(registry));
+    receiver.set(Ref(buffer));
+    for(auto i = 0; i != 2; ++i) {
+      auto in_value = std::unique_ptr<PolymorphicBaseClass>();
+      receiver.shuttle(in_value);
+      REQUIRE(in_value);
+      REQUIRE(in_value->to_string() == out_value->to_string());
+    }
+    auto next_buffer = typename Sender::Sink();
+    sender.set(Ref(next_buffer));
+    sender.send(out_value.get());
+    std::memcpy(&type_id, next_buffer.get_data() + sizeof(std::uint32_t),
+      sizeof(type_id));
+    REQUIRE(type_id == NAMED_TYPE_ID);
+  }
+
+  TEST_CASE("stream_type_id") {
+    auto registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    registry.template add<PolymorphicDerivedClassA>("PolymorphicDerivedClassA");
+    using Sender = BinarySender<SharedBuffer>;
+    using Receiver = inverse_t<Sender>;
+    auto sender = Sender(Ref(registry));
+    sender.set_type_id_format(TypeIdFormat::STREAM);
+    auto out_value = std::make_unique<PolymorphicDerivedClassA>();
+    auto first_buffer = typename Sender::Sink();
+    sender.set(Ref(first_buffer));
+    sender.send(out_value.get());
+    auto second_buffer = typename Sender::Sink();
+    sender.set(Ref(second_buffer));
+    sender.send(out_value.get());
+    REQUIRE(std::string_view(
+      second_buffer.get_data(), second_buffer.get_size()).find(
+        "PolymorphicDerivedClassA") == std::string_view::npos);
+    auto receiver = Receiver(Ref(registry));
+    for(auto& buffer : {first_buffer, second_buffer}) {
+      receiver.set(Ref(buffer));
+      auto in_value = std::unique_ptr<PolymorphicBaseClass>();
+      receiver.shuttle(in_value);
+      REQUIRE(in_value);
+      REQUIRE(in_value->to_string() == out_value->to_string());
+    }
+    auto unnamed_receiver = Receiver(Ref(registry));
+    unnamed_receiver.set(Ref(second_buffer));
+    auto in_value = std::unique_ptr<PolymorphicBaseClass>();
+    REQUIRE_THROWS_AS(
+      unnamed_receiver.shuttle(in_value), TypeNotFoundException);
+  }
+
+  TEST_CASE("name_type_id_format") {
+    auto registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    registry.template add<PolymorphicDerivedClassA>("PolymorphicDerivedClassA");
+    using Sender = BinarySender<SharedBuffer>;
+    using Receiver = inverse_t<Sender>;
+    auto sender = Sender(Ref(registry));
+    sender.set_type_id_format(TypeIdFormat::NAME);
+    auto buffer = typename Sender::Sink();
+    sender.set(Ref(buffer));
+    auto out_value = std::make_unique<PolymorphicDerivedClassA>();
+    sender.send(out_value.get());
+    sender.send(static_cast<const PolymorphicBaseClass*>(nullptr));
+    auto size = std::uint32_t();
+    std::memcpy(&size, buffer.get_data(), sizeof(size));
+    REQUIRE(size == std::string_view("PolymorphicDerivedClassA").size());
+    auto receiver = Receiver(Ref(registry));
+    receiver.set(Ref(buffer));
+    auto in_value = std::unique_ptr<PolymorphicBaseClass>();
+    receiver.shuttle(in_value);
+    REQUIRE(in_value);
+    REQUIRE(in_value->to_string() == out_value->to_string());
+    receiver.shuttle(in_value);
+    REQUIRE(!in_value);
+  }
+
+  TEST_CASE("unnamed_type_id") {
+    auto registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    registry.template add<PolymorphicDerivedClassA>("PolymorphicDerivedClassA");
+    using Receiver = inverse_t<BinarySender<SharedBuffer>>;
+    auto buffer = SharedBuffer();
+    append(buffer, std::uint32_t(0));
+    append(buffer, get_type_id("PolymorphicDerivedClassA"));
+    append(buffer, unsigned(0));
+    auto receiver = Receiver(Ref(registry));
+    receiver.set(Ref(buffer));
+    auto in_value = std::unique_ptr<PolymorphicBaseClass>();
+    REQUIRE_THROWS_AS(receiver.shuttle(in_value), TypeNotFoundException);
+  }
+
+  TEST_CASE("ambiguous_type_id") {
+    REQUIRE(get_type_id("Type222314") == get_type_id("Type1090000"));
+    auto registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    registry.template add<PolymorphicDerivedClassA>("Type222314");
+    registry.template add<PolymorphicDerivedClassB>("Type1090000");
+    using Sender = BinarySender<SharedBuffer>;
+    using Receiver = inverse_t<Sender>;
+    auto sender = Sender(Ref(registry));
+    auto buffer = typename Sender::Sink();
+    sender.set(Ref(buffer));
+    auto value_a = std::make_unique<PolymorphicDerivedClassA>();
+    auto value_b = std::make_unique<PolymorphicDerivedClassB>();
+    sender.send(value_a.get());
+    sender.send(value_b.get());
+    auto size = buffer.get_size();
+    sender.send(value_a.get());
+    auto type_id = std::uint32_t();
+    std::memcpy(&type_id, buffer.get_data() + size + sizeof(std::uint32_t),
+      sizeof(type_id));
+    REQUIRE(type_id == NAMED_TYPE_ID);
+    auto receiver = Receiver(Ref(registry));
+    receiver.set(Ref(buffer));
+    for(auto& out_value : std::initializer_list<const PolymorphicBaseClass*>{
+        value_a.get(), value_b.get(), value_a.get()}) {
+      auto in_value = std::unique_ptr<PolymorphicBaseClass>();
+      receiver.shuttle(in_value);
+      REQUIRE(in_value);
+      REQUIRE(in_value->to_string() == out_value->to_string());
+    }
+  }
+
+  TEST_CASE("mismatched_type_id") {
+    REQUIRE(get_type_id("Type222314") == get_type_id("Type1090000"));
+    auto sender_registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    sender_registry.template add<PolymorphicDerivedClassA>("Type222314");
+    auto receiver_registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    receiver_registry.template add<PolymorphicDerivedClassA>(
+      "PolymorphicDerivedClassA");
+    receiver_registry.template add<PolymorphicDerivedClassB>("Type1090000");
+    using Sender = BinarySender<SharedBuffer>;
+    using Receiver = inverse_t<Sender>;
+    auto sender = Sender(Ref(sender_registry));
+    auto buffer = typename Sender::Sink();
+    sender.set(Ref(buffer));
+    auto out_value = std::make_unique<PolymorphicDerivedClassA>();
+    sender.send(out_value.get());
+    auto receiver = Receiver(Ref(receiver_registry));
+    receiver.set(Ref(buffer));
+    auto in_value = std::unique_ptr<PolymorphicBaseClass>();
+    REQUIRE_THROWS_AS(receiver.shuttle(in_value), TypeNotFoundException);
+  }
+
+  TEST_CASE("null_polymorphic_unique_ptr") {
+    auto registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    registry.template add<PolymorphicDerivedClassA>("PolymorphicDerivedClassA");
+    using Sender = BinarySender<SharedBuffer>;
+    using Receiver = inverse_t<Sender>;
+    auto sender = Sender(Ref(registry));
+    auto buffer = typename Sender::Sink();
+    sender.set(Ref(buffer));
+    sender.send(static_cast<const PolymorphicBaseClass*>(nullptr));
+    REQUIRE(buffer.get_size() == 2 * sizeof(std::uint32_t));
+    auto receiver = Receiver(Ref(registry));
+    receiver.set(Ref(buffer));
+    auto in_value = std::unique_ptr<PolymorphicBaseClass>(
+      std::make_unique<PolymorphicDerivedClassA>());
+    receiver.shuttle(in_value);
+    REQUIRE(!in_value);
+  }
 }
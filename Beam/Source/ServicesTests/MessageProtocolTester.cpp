@@ -1,4 +1,10 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <doctest/doctest.h>
 #include "Beam/CodecsTests/ReverseDecoder.hpp"
 #include "Beam/CodecsTests/ReverseEncoder.hpp"
@@ -8,8 +14,10 @@
 #include "Beam/IO/PipedReader.hpp"
 #include "Beam/IO/PipedWriter.hpp"
 #include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
 #include "Beam/Serialization/BinaryReceiver.hpp"
 #include "Beam/Serialization/BinarySender.hpp"
+#include "Beam/Serialization/ShuttleUniquePtr.hpp"
 #include "Beam/Services/MessageProtocol.hpp"
 
 using namespace Beam;
@@ -17,6 +25,21 @@ using namespace Beam::Tests;
 using namespace boost;
 using namespace boost::endian;
 
+namespace {
+  struct Shape {
+    virtual ~Shape() = default;
+  };
+
+  struct Circle : Shape {
+    int m_radius = 0;
+
+    template<typename S>
+    void shuttle(S& shuttle, unsigned int version) {
+      shuttle.shuttle("radius", m_radius);
+    }
+  };
+}
+
 TEST_SUITE("MessageProtocol") {
   TEST_CASE("message") {
     using ProtocolChannel = BasicChannel<
@@ -61,4 +84,126 @@ TEST_SUITE("MessageProtocol") {
     auto received_message = receiver.receive<std::string>();
     REQUIRE(received_message == sent_message);
   }
+
+  TEST_CASE("buffered_messages") {
+    using ProtocolChannel = BasicChannel<
+      NamedChannelIdentifier, NullConnection, PipedReader*, PipedWriter*>;
+    auto receive_reader = PipedReader();
+    auto send_writer = PipedWriter(Ref(receive_reader));
+    auto send_reader = PipedReader();
+    auto receive_writer = PipedWriter(Ref(send_reader));
+    auto send_channel =
+      ProtocolChannel("sender", init(), &send_reader, &send_writer);
+    auto sender = MessageProtocol(&send_channel, BinarySender<SharedBuffer>(),
+      BinaryReceiver<SharedBuffer>(), NullEncoder(), NullDecoder());
+    auto receive_channel =
+      ProtocolChannel("receiver", init(), &receive_reader, &receive_writer);
+    auto receiver = MessageProtocol(&receive_channel,
+      BinarySender<SharedBuffer>(), BinaryReceiver<SharedBuffer>(),
+      NullEncoder(), NullDecoder());
+    auto large_message = std::string(3 * RECEIVE_CHUNK_SIZE, 'x');
+    sender.send(std::string("a"));
+    sender.send(large_message);
+    sender.send(std::string("bc"));
+    sender.send(std::string("def"));
+    REQUIRE(receiver.receive<std::string>() == "a");
+    REQUIRE(receiver.receive<std::string>() == large_message);
+    REQUIRE(receiver.receive<std::string>() == "bc");
+    REQUIRE(receiver.receive<std::string>() == "def");
+  }
+
+  TEST_CASE("concurrent_send") {
+    using ProtocolChannel = BasicChannel<
+      NamedChannelIdentifier, NullConnection, PipedReader*, PipedWriter*>;
+    auto receive_reader = PipedReader();
+    auto send_writer = PipedWriter(Ref(receive_reader));
+    auto send_reader = PipedReader();
+    auto receive_writer = PipedWriter(Ref(send_reader));
+    auto send_channel =
+      ProtocolChannel("sender", init(), &send_reader, &send_writer);
+    auto sender = MessageProtocol(&send_channel, BinarySender<SharedBuffer>(),
+      BinaryReceiver<SharedBuffer>(), ReverseEncoder(), ReverseDecoder());
+    auto receive_channel =
+      ProtocolChannel("receiver", init(), &receive_reader, &receive_writer);
+    auto receiver = MessageProtocol(&receive_channel,
+      BinarySender<SharedBuffer>(), BinaryReceiver<SharedBuffer>(),
+      ReverseEncoder(), ReverseDecoder());
+    auto sent_messages = std::vector<std::string>();
+    for(auto i = 0; i != 100; ++i) {
+      sent_messages.push_back("message " + std::to_string(i));
+    }
+    {
+      auto routines = RoutineHandlerGroup();
+      for(auto& message : sent_messages) {
+        routines.spawn([&] {
+          sender.send(message);
+        });
+      }
+    }
+    auto received_messages = std::vector<std::string>();
+    for(auto i = 0; i != 100; ++i) {
+      received_messages.push_back(receiver.receive<std::string>());
+    }
+    std::ranges::sort(sent_messages);
+    std::ranges::sort(received_messages);
+    REQUIRE(received_messages == sent_messages);
+  }
+
+  TEST_CASE("stream_type_ids") {
+    using ProtocolChannel = BasicChannel<
+      NamedChannelIdentifier, NullConnection, PipedReader*, PipedWriter*>;
+    auto registry = TypeRegistry<BinarySender<SharedBuffer>>();
+    registry.template add<Circle>("Circle");
+    auto receive_reader = PipedReader();
+    auto send_writer = PipedWriter(Ref(receive_reader));
+    auto send_reader = PipedReader();
+    auto send_channel =
+      ProtocolChannel("sender", init(), &send_reader, &send_writer);
+    auto sender = MessageProtocol(&send_channel,
+      BinarySender<SharedBuffer>(Ref(registry)),
+      BinaryReceiver<SharedBuffer>(Ref(registry)), NullEncoder(),
+      NullDecoder());
+    for(auto i = 0; i != 2; ++i) {
+      auto circle = std::make_unique<Circle>();
+      circle->m_radius = i + 1;
+      sender.send(std::unique_ptr<Shape>(std::move(circle)));
+    }
+    auto frames = SharedBuffer();
+    auto frame_count = 0;
+    auto position = std::size_t(0);
+    while(frame_count != 2) {
+      receive_reader.read(out(frames));
+      while(frame_count != 2 &&
+          frames.get_size() - position >= sizeof(std::uint32_t)) {
+        auto size = std::uint32_t();
+        std::memcpy(&size, frames.get_data() + position, sizeof(size));
+        size = little_to_native(size);
+        if(frames.get_size() - position - sizeof(size) < size) {
+          break;
+        }
+        position += sizeof(size) + size;
+        ++frame_count;
+      }
+    }
+    auto contents = std::string_view(frames.get_data(), frames.get_size());
+    auto name = contents.find("Circle");
+    REQUIRE(name != std::string_view::npos);
+    REQUIRE(contents.find("Circle", name + 1) == std::string_view::npos);
+    auto receiver = BinaryReceiver<SharedBuffer>(Ref(registry));
+    position = 0;
+    for(auto i = 0; i != 2; ++i) {
+      auto size = std::uint32_t();
+      std::memcpy(&size, frames.get_data() + position, sizeof(size));
+      size = little_to_native(size);
+      auto frame =
+        SharedBuffer(frames.get_data() + position + sizeof(size), size);
+      position += sizeof(size) + size;
+      receiver.set(Ref(frame));
+      auto shape = std::unique_ptr<Shape>();
+      receiver.receive(shape);
+      auto circle = dynamic_cast<Circle*>(shape.get());
+      REQUIRE(circle);
+      REQUIRE(circle->m_radius == i + 1);
+    }
+  }
 }
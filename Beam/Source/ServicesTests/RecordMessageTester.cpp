@@ -212,6 +212,58 @@ TEST_SUITE("RecordMessage") {
     REQUIRE(received_count2 == 1);
   }
 
+  TEST_CASE("broadcast_record_message_individual_encoding") {
+    const auto CLIENT_COUNT = 3;
+    auto servers = std::vector<std::unique_ptr<LocalServerConnection>>();
+    auto received_counts = std::vector<int>(CLIENT_COUNT, 0);
+    auto receive_tokens = std::vector<Async<void>>(CLIENT_COUNT);
+    auto server_tasks = std::vector<RoutineHandler>();
+    for(auto i = 0; i != CLIENT_COUNT; ++i) {
+      servers.push_back(std::make_unique<LocalServerConnection>());
+      server_tasks.emplace_back(spawn([&, i] {
+        auto client = ServerServiceProtocolClient(servers[i]->accept(), init());
+        register_test_messages(out(client.get_slots()));
+        add_message_slot<SimpleMessage>(out(client.get_slots()),
+          [&, i] (auto& protocol, auto value) {
+            ++received_counts[i];
+            REQUIRE(value == 999);
+            receive_tokens[i].get_eval().set();
+          });
+        try {
+          while(true) {
+            auto message = client.read_message();
+            if(auto slot = client.get_slots().find(*message)) {
+              message->emit(slot, Ref(client));
+            }
+          }
+        } catch(const EndOfFileException&) {
+        }
+      }));
+    }
+    auto clients = std::vector<std::unique_ptr<ClientServiceProtocolClient>>();
+    auto client_pointers = std::vector<ClientServiceProtocolClient*>();
+    for(auto i = 0; i != CLIENT_COUNT; ++i) {
+      clients.push_back(std::make_unique<ClientServiceProtocolClient>(
+        init("client" + std::to_string(i), *servers[i]), init()));
+      register_test_messages(out(clients.back()->get_slots()));
+      client_pointers.push_back(clients.back().get());
+    }
+    auto checked = std::vector<const ClientServiceProtocolClient*>();
+    broadcast_record_message<SimpleMessage>(client_pointers,
+      [&] (const ClientServiceProtocolClient& client) {
+        checked.push_back(&client);
+        return &client != client_pointers[1];
+      }, 999);
+    REQUIRE(checked == std::vector<const ClientServiceProtocolClient*>(
+      client_pointers.begin(), client_pointers.end()));
+    for(auto i = 0; i != CLIENT_COUNT; ++i) {
+      receive_tokens[i].get();
+      clients[i]->close();
+      server_tasks[i].wait();
+      REQUIRE(received_counts[i] == 1);
+    }
+  }
+
   TEST_CASE("stream") {
     test_round_trip_shuttle(
       RecordMessage<MultiFieldMessage, ClientServiceProtocolClient>(
@@ -0,0 +1,83 @@
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Threading/Task.hpp"
+
+using namespace Beam;
+
+TEST_SUITE("Task") {
+  TEST_CASE("empty") {
+    auto task = Task();
+    REQUIRE(!task);
+    REQUIRE(!task.is_inline());
+    REQUIRE_THROWS_AS(task(), std::bad_function_call);
+  }
+
+  TEST_CASE("small_callable_is_inline") {
+    auto value = 0;
+    auto task = Task([&value] {
+      ++value;
+    });
+    REQUIRE(task);
+    REQUIRE(task.is_inline());
+    task();
+    task();
+    REQUIRE(value == 2);
+  }
+
+  TEST_CASE("large_callable_is_allocated") {
+    auto values = std::array<int, 32>();
+    values.fill(1);
+    auto sum = 0;
+    auto task = Task([&sum, values] {
+      for(auto value : values) {
+        sum += value;
+      }
+    });
+    REQUIRE(!task.is_inline());
+    task();
+    REQUIRE(sum == 32);
+  }
+
+  TEST_CASE("move_only_callable") {
+    auto value = std::make_unique<int>(5);
+    auto result = 0;
+    auto task = Task([&result, value = std::move(value)] {
+      result = *value;
+    });
+    REQUIRE(task.is_inline());
+    auto moved_task = std::move(task);
+    REQUIRE(!task);
+    moved_task();
+    REQUIRE(result == 5);
+  }
+
+  TEST_CASE("move_assignment_destroys_callable") {
+    auto counter = std::make_shared<int>(0);
+    auto task = Task([counter] {});
+    auto large_task = Task([counter, padding = std::array<char, 128>()] {});
+    REQUIRE(counter.use_count() == 3);
+    task = std::move(large_task);
+    REQUIRE(counter.use_count() == 2);
+    REQUIRE(!task.is_inline());
+    task = Task();
+    REQUIRE(counter.use_count() == 1);
+  }
+
+  TEST_CASE("vector_of_tasks") {
+    auto values = std::vector<int>();
+    auto tasks = std::vector<Task>();
+    for(auto i = 0; i != 100; ++i) {
+      tasks.emplace_back([&values, i] {
+        values.push_back(i);
+      });
+    }
+    for(auto& task : tasks) {
+      task();
+    }
+    REQUIRE(values.size() == 100);
+    REQUIRE(values.back() == 99);
+  }
+}
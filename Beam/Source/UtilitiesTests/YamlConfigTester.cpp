@@ -238,4 +238,29 @@ TEST_SUITE("YamlConfig") {
       REQUIRE(value.get_port() == 443);
     }
   }
+
+  TEST_CASE("extract_worker_config") {
+    SUBCASE("defaults") {
+      auto node = YAML::Load("{}");
+      auto value = extract<WorkerConfig>(node);
+      REQUIRE(value.m_thread_count == 0);
+      REQUIRE(value.m_cpu_sets.empty());
+    }
+
+    SUBCASE("cpu_sets") {
+      auto node = YAML::Load("{threads: 4, cpus: [0, \"2-4\", [6, \"8-9\"]]}");
+      auto value = extract<WorkerConfig>(node);
+      REQUIRE(value.m_thread_count == 4);
+      REQUIRE(value.m_cpu_sets.size() == 3);
+      REQUIRE(value.m_cpu_sets[0] == CpuSet{0});
+      REQUIRE(value.m_cpu_sets[1] == CpuSet{2, 3, 4});
+      REQUIRE(value.m_cpu_sets[2] == CpuSet{6, 8, 9});
+      REQUIRE(get_cpu_set(value, 4) == CpuSet{2, 3, 4});
+    }
+
+    SUBCASE("invalid_cpu_set") {
+      auto node = YAML::Load("{cpus: [\"a-b\"]}");
+      REQUIRE_THROWS_AS(extract<WorkerConfig>(node), AssertionException);
+    }
+  }
 }
@@ -32,13 +32,16 @@ IF !PARALLEL! EQU 1 (
 CALL :BuildApp Applications\AdminClient %*
 CALL :BuildApp Applications\ClientTemplate %*
 CALL :BuildApp Applications\DataStoreProfiler %*
+CALL :BuildApp Applications\EvaluatorProfiler %*
 CALL :BuildApp Applications\HttpFileServer %*
 CALL :BuildApp Applications\QueryStressTest %*
+CALL :BuildApp Applications\QueueProfiler %*
 CALL :BuildApp Applications\QueueStressTest %*
 CALL :BuildApp Applications\Scratch %*
 CALL :BuildApp Applications\ServiceLocator %*
 CALL :BuildApp Applications\ServiceProtocolProfiler %*
 CALL :BuildApp Applications\ServletTemplate %*
+CALL :BuildApp Applications\SpawnStressTest %*
 CALL :BuildApp Applications\UidServer %*
 CALL :BuildApp Applications\WebSocketEchoServer %*
 IF !PARALLEL! EQU 0 (
@@ -13,13 +13,16 @@ main() {
     "Applications/AdminClient"
     "Applications/ClientTemplate"
     "Applications/DataStoreProfiler"
+    "Applications/EvaluatorProfiler"
     "Applications/HttpFileServer"
     "Applications/QueryStressTest"
+    "Applications/QueueProfiler"
     "Applications/QueueStressTest"
     "Applications/Scratch"
     "Applications/ServiceLocator"
     "Applications/ServiceProtocolProfiler"
     "Applications/ServletTemplate"
+    "Applications/SpawnStressTest"
     "Applications/UidServer"
     "Applications/WebSocketEchoServer"
   )
@@ -15,13 +15,16 @@ CALL :Configure WebApi %*
 CALL :Configure Applications\AdminClient %*
 CALL :Configure Applications\ClientTemplate %*
 CALL :Configure Applications\DataStoreProfiler %*
+CALL :Configure Applications\EvaluatorProfiler %*
 CALL :Configure Applications\HttpFileServer %*
 CALL :Configure Applications\QueryStressTest %*
+CALL :Configure Applications\QueueProfiler %*
 CALL :Configure Applications\QueueStressTest %*
 CALL :Configure Applications\Scratch %*
 CALL :Configure Applications\ServiceLocator %*
 CALL :Configure Applications\ServiceProtocolProfiler %*
 CALL :Configure Applications\ServletTemplate %*
+CALL :Configure Applications\SpawnStressTest %*
 CALL :Configure Applications\UidServer %*
 CALL :Configure Applications\WebSocketEchoServer %*
 EXIT /B !EXIT_STATUS!